@@ -31,6 +31,17 @@
 **    4. Supported JSON types as defined by core_json
 **       - JSONNumber
 **       - JSONString
+**       - JSONTrue and JSONFalse, loaded by boolean objects that are 
+**         constructed with type JSONTrue
+**       - JSONArray of numbers, see CJSON_ArrayObjConstructor()
+**    5. Numbers are decoded in place by JSON_NumberDecode() into the C type 
+**       selected by the object's or field's JSONNumberType_t. A number may
+**       also be given as a JSON string, which allows hex integers such as
+**       message IDs to be written as "0x1880". 
+**    6. Strings are copied as they appear in the JSON buffer unless the
+**       object or field selects another CJSON_StrMode_t. CJSON_STR_UNESCAPE
+**       decodes escape sequences while copying and CJSON_STR_VIEW loads a
+**       CJSON_StrView_t that points into the JSON buffer without copying.
 **
 **  References:
 **    1. OpenSatKit Object-based Application Developer's Guide.
@@ -45,6 +56,7 @@
 ** Includes
 */
 
+#include <stddef.h>
 #include "osk_c_fw_cfg.h"
 #include "core_json.h"
 
@@ -54,6 +66,13 @@
 
 #define CJSON_MAX_KEY_LEN  64  /* Number of characters in key, does not include a string terminator */ 
 
+#define CJSON_MAX_QUERY_PARTS  6  /* Max parts in a compiled query key, longer keys are searched as strings */
+
+#define CJSON_MAX_STRUCT_FIELDS  32  /* Max fields in a CJSON_LoadStructArray() field descriptor list */
+
+#define CJSON_WRITER_MAX_DEPTH   32  /* Max object/array nesting written by a CJSON_Writer_t */
+#define CJSON_WRITER_INDENT       3  /* Spaces per nesting level in written files */
+
 /*
 ** Event Message IDs
 */
@@ -63,21 +82,77 @@
 #define CJSON_LOAD_OBJ_EID           (CJSON_BASE_EID + 2)
 #define CJSON_LOAD_OBJ_ERR_EID       (CJSON_BASE_EID + 3)
 #define CJSON_INTERNAL_ERR_EID       (CJSON_BASE_EID + 4)
+#define CJSON_WRITE_FILE_ERR_EID     (CJSON_BASE_EID + 5)
 
 /**********************/
 /** Type Definitions **/
 /**********************/
 
+/*
+** How a JSONString value is loaded into table data
+*/
+
+typedef enum
+{
+
+   CJSON_STR_COPY = 0,   /* Copy the characters as they appear in the JSON buffer */
+   CJSON_STR_UNESCAPE,   /* Decode escape sequences while copying, "\u" escapes become UTF-8 */
+   CJSON_STR_VIEW        /* Load a CJSON_StrView_t, the table data isn't a char array */
+
+} CJSON_StrMode_t;
+
+/*
+** A string value in the JSON buffer. Str is not terminated and is only valid
+** while the JSON buffer is unchanged. Escaped is true when Str contains
+** escape sequences, which can be decoded with JSON_StringUnescape().
+*/
+
+typedef struct
+{
+
+   const char*  Str;
+   size_t       Len;
+   bool         Escaped;
+
+} CJSON_StrView_t;
+
+
+/*
+** One part of a compiled query key. A key has at most CJSON_MAX_KEY_LEN
+** characters so a part's offset and length fit in a byte. Value is a key 
+** part's hash or an array index part's index. This is about half the size
+** of a core_json JSONQueryPart_t, which is expanded from it when needed.
+*/
+
+typedef struct
+{
+
+   uint32  Value;      /* Key hash or array index */
+   uint8   KeyOffset;
+   uint8   KeyLen;     /* 0 for an array index part */
+
+} CJSON_QueryPart_t;
+
+
 /* TODO - Consider refactor into 2 structures so one can be passed as a const */
 
 typedef struct
 {
 
-   char     Key[CJSON_MAX_KEY_LEN];
-   size_t   KeyLen;
+   char         Key[CJSON_MAX_KEY_LEN];
+   size_t       KeyLen;
+   uint8        PartCnt;   /* Filled by the constructors, 0 when not compiled */
+   CJSON_QueryPart_t Part[CJSON_MAX_QUERY_PARTS];
 
 } CJSON_Query_t;
 
+/*
+** Objects may be statically initialized with positional initializers so
+** members are only ever appended. The appended members default to an
+** int32 number, a copied string and no array elements when an
+** initializer omits them.
+*/
+
 typedef struct
 {
 
@@ -85,8 +160,11 @@ typedef struct
    size_t         TblDataLen;
    bool           Updated;
    JSONTypes_t    Type;
-   bool           TypeFlt;   /* Distinguish between integer and float number types */
+   bool           TypeFlt;   /* Deprecated, use NumType. True loads a number object with NumType JSONNumInt32 as a float */
    CJSON_Query_t  Query;
+   JSONNumberType_t NumType; /* C type numbers are decoded into, see CJSON_NumObjConstructor() */
+   CJSON_StrMode_t  StrMode; /* How strings are loaded, see CJSON_StrObjConstructor() */
+   size_t         ArrayCnt;  /* Elements loaded by an array object, see CJSON_ArrayObjConstructor() */
 
 } CJSON_Obj_t;
 
@@ -111,6 +189,136 @@ typedef struct
 } CJSON_StrObj_t;
 
 
+/*
+** Describes one field of a C structure that is loaded from a member of each
+** element of a JSON array. See CJSON_LoadStructArray(). Key is the member's
+** key, or NULL when the array's elements are scalars that are loaded
+** directly into the field. Size is the field's size, which is the maximum
+** length including the terminator for a string. StrMode may be omitted from
+** an initializer to copy strings.
+*/
+
+typedef struct
+{
+   const char*  Key;
+   JSONTypes_t  Type;
+   JSONNumberType_t NumType;  /* C type of a number field */
+   size_t       Offset;    /* offsetof() the field within the structure */
+   size_t       Size;
+   CJSON_StrMode_t  StrMode;  /* How a string field is loaded */
+} CJSON_Field_t;
+
+
+/*
+** Schema field descriptor used to build a CJSON_Schema_t decode plan. Path
+** is a query relative to the document's root that may contain one "[*]"
+** to match every element of an array. For a "[*]" path Offset and Size 
+** describe element 0's field, Stride is the size of the table's array 
+** elements and MaxCnt is the number of elements in the table's array.
+** Use the CJSON_SCHEMA_*() macros to define descriptors.
+*/
+
+typedef struct
+{
+   const char*  Path;
+   JSONTypes_t  Type;
+   JSONNumberType_t NumType;  /* C type of a number field */
+   bool         Required;
+   size_t       Offset;
+   size_t       Size;
+   size_t       Stride;
+   size_t       MaxCnt;
+} CJSON_SchemaField_t;
+
+#define CJSON_SCHEMA_FIELD(Path, JsonType, NumType, Required, TblType, Field) \
+   { (Path), (JsonType), (NumType), (Required), offsetof(TblType, Field),     \
+     sizeof(((TblType*)0)->Field), 0, 0 }
+
+/* Field is the element's member including the leading '.', or empty for scalar elements */
+#define CJSON_SCHEMA_ARRAY_FIELD(Path, JsonType, NumType, Required, TblType, Array, Field) \
+   { (Path), (JsonType), (NumType), (Required), offsetof(TblType, Array[0]Field),         \
+     sizeof(((TblType*)0)->Array[0]Field), sizeof(((TblType*)0)->Array[0]),               \
+     (sizeof(((TblType*)0)->Array)/sizeof(((TblType*)0)->Array[0])) }
+
+typedef struct
+{
+   JSONQuery_t  Query;       /* Compiled Path, "[*]" is a JSON_QUERY_ANY_INDEX part */
+   uint16       EachDepth;   /* Number of parts up to and including "[*]", 0 if none */
+   size_t       LoadCnt;     /* Values loaded by the last CJSON_SchemaLoad() */
+   size_t       ElementCnt;  /* Array elements seen by the last CJSON_SchemaLoad() */
+} CJSON_SchemaEntry_t;
+
+typedef struct
+{
+   const CJSON_SchemaField_t  *Field;
+   uint16                     FieldCnt;
+   CJSON_SchemaEntry_t        Entry[CJSON_MAX_SCHEMA_FIELDS];
+} CJSON_Schema_t;
+
+
+/*
+** Buffered JSON file writer. Output is collected in a caller supplied 
+** buffer and only written to the file when the buffer is full or the
+** writer is closed. MemberMask bit N is set once nesting level N has a 
+** member so the next member is preceded by a comma. 
+*/
+
+typedef struct
+{
+
+   osal_id_t  FileHandle;
+   char       *Buf;
+   size_t     BufLen;
+   size_t     Len;        /* Characters in Buf waiting to be written */
+   size_t     FileLen;    /* Characters written to the file */
+   uint32     WriteCnt;   /* Number of OS_write() calls */
+   uint32     MemberMask;
+   uint16     Depth;
+   bool       FileOpen;
+   bool       Valid;      /* Cleared by a file or nesting error */
+
+} CJSON_Writer_t;
+
+
+/*
+** Location of an object's value in a validated JSON buffer. A string's
+** location excludes its quotes. Values are located by 
+** CJSON_ProcessFileLocate() and decoded by CJSON_LoadObjLoc().
+*/
+
+typedef struct
+{
+
+   uint32       Value;      /* Buffer index of the value */
+   uint32       ValueLen;
+   JSONTypes_t  Type;
+   bool         Located;
+
+} CJSON_ObjLoc_t;
+
+
+/*
+** Load throughput counters accumulated since CJSON_LibInit() or the last
+** CJSON_ResetStats(). Combined with the CJSON_PARSE_PERF_ID and 
+** CJSON_LOAD_PERF_ID performance log intervals they give parse rates and 
+** the cost per query. The counters are approximate: they're incremented 
+** without a lock so a search isn't slowed by a semaphore, and counts can
+** be lost when several tasks load tables at the same time.
+*/
+
+typedef struct
+{
+
+   uint32  FileCnt;       /* Files processed by CJSON_ProcessFile*() */
+   uint32  FileErrCnt;    /* Files that couldn't be read, validated or loaded */
+   uint64  FileCharCnt;   /* JSON characters read from the files */
+   uint32  MaxFileLen;    /* Largest file processed */
+   uint32  QueryCnt;      /* CJSON_LoadObj*() searches */
+   uint32  QueryErrCnt;   /* Searches whose query wasn't found */
+
+} CJSON_Stats_t;
+
+
 /* User callback function to load table data */
 typedef bool (*CJSON_LoadJsonData_t)(size_t JsonFileLen);
 typedef bool (*CJSON_LoadJsonDataAlt_t)(size_t JsonFileLen, void* UserDataPtr);
@@ -121,6 +329,60 @@ typedef bool (*CJSON_LoadJsonDataAlt_t)(size_t JsonFileLen, void* UserDataPtr);
 /************************/
 
 
+/******************************************************************************
+** Function: CJSON_AcquireBuf
+**
+** Notes:
+**    1. Borrows a BufLen character buffer from the shared JSON buffer pool.
+**       Timeout is OS_CHECK to try once, OS_PEND to wait until space is 
+**       released or a number of milliseconds to wait. 
+**    2. Returns NULL if BufLen exceeds CJSON_BUF_POOL_MAX_BUF_CHAR, which is
+**       reported with an event message, or if no buffer became available.
+**    3. The buffer must be returned with CJSON_ReleaseBuf().
+*/
+char* CJSON_AcquireBuf(size_t BufLen, int32 Timeout);
+
+
+/******************************************************************************
+** Function: CJSON_AcquireFileBuf
+**
+** Notes:
+**    1. Same as CJSON_AcquireBuf() except the buffer is sized from Filename's
+**       length, as reported by OS_stat(), up to MaxJsonFileChar. The 
+**       buffer's length is returned in BufLen.
+**    2. A file longer than MaxJsonFileChar gets a MaxJsonFileChar buffer so
+**       CJSON_ProcessFile*() reports it as too large.
+*/
+char* CJSON_AcquireFileBuf(const char *Filename, size_t MaxJsonFileChar, size_t *BufLen, int32 Timeout);
+
+
+/******************************************************************************
+** Function: CJSON_ArrayObjConstructor
+**
+** Notes:
+**    1. Constructs a JSONArray object whose elements are numbers decoded 
+**       into consecutive NumType elements of TblData. TblDataLen is the 
+**       storage's length in bytes so it sets the maximum element count.
+**    2. The array is decoded in one iteration over its elements. An array 
+**       with more elements than TblData holds or a non-numeric element isn't
+**       loaded. ArrayCnt is set to the number of elements when it is loaded.
+**    3. Arrays can't be loaded by CJSON_ProcessFileStream().
+*/
+void CJSON_ArrayObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey, 
+                               JSONNumberType_t NumType, void *TblData, size_t TblDataLen);
+
+
+/******************************************************************************
+** Function: CJSON_BoolObjConstructor
+**
+** Notes:
+**    1. Constructs an object with type JSONTrue that loads a JSON true or 
+**       false value into a bool. Other JSON types are load errors.
+*/
+void CJSON_BoolObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey, 
+                              void *TblData, size_t TblDataLen);
+
+
 /******************************************************************************
 ** Function: CJSON_FltObjConstructor
 **
@@ -146,17 +408,106 @@ void CJSON_ObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey,
                           JSONTypes_t JsonType, void *TblData, size_t TblDataLen);
 
 
+/******************************************************************************
+** Function: CJSON_NumObjConstructor
+**
+** Notes:
+**    1. Constructs a JSONNumber object that is decoded into NumType. The
+**       other constructors decode numbers into an int32 or a float.
+**    2. Integer objects with a TblDataLen of 1 or 2 are loaded with values
+**       that fit in TblDataLen bytes.
+*/
+void CJSON_NumObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey, 
+                             JSONNumberType_t NumType, void *TblData, size_t TblDataLen);
+
+
+/******************************************************************************
+** Function: CJSON_StrObjConstructor
+**
+** Notes:
+**    1. Constructs a JSONString object that is loaded using StrMode. The
+**       other constructors copy strings.
+**    2. For CJSON_STR_COPY and CJSON_STR_UNESCAPE TblData is a char array of
+**       TblDataLen characters including the terminator. For CJSON_STR_VIEW
+**       TblData is a CJSON_StrView_t, the view is only valid until the JSON
+**       buffer is reused and it can't be loaded by CJSON_ProcessFileStream().
+*/
+void CJSON_StrObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey, 
+                             CJSON_StrMode_t StrMode, void *TblData, size_t TblDataLen);
+
+
+/******************************************************************************
+** Function: CJSON_GetFileBuf
+**
+** Notes:
+**   1. Returns the buffer a CJSON_ProcessFile*() function borrowed because 
+**      it was passed a NULL JsonBuf. Only the task whose callback is 
+**      running gets it, every other call returns NULL.
+**   2. The callback loads from it with its JsonFileLen, e.g. 
+**      CJSON_LoadObjArray(Obj, ObjCnt, CJSON_GetFileBuf(), JsonFileLen). It 
+**      is returned to the pool when the callback returns.
+**
+*/
+const char* CJSON_GetFileBuf(void);
+
+
+/******************************************************************************
+** Function: CJSON_GetStats
+**
+** Notes:
+**   1. Counters are updated without a lock so loads running concurrently in
+**      several tasks may lose counts. Treat them as approximate, see 
+**      CJSON_Stats_t.
+**
+*/
+void CJSON_GetStats(CJSON_Stats_t *Stats);
+
+
+/******************************************************************************
+** Function: CJSON_LibInit
+**
+** Notes:
+**   1. Called once by OSK_C_FW_LibInit(). It creates the mutex that guards
+**      the search cursor CJSON_LoadObj() uses during CJSON_ProcessFile*()
+**      callbacks. If it isn't called or fails, loads search without the
+**      cursor.
+**   2. It also creates the shared JSON buffer pool's mutex and semaphore. 
+**      If they aren't created buffers can't be borrowed.
+**   3. Returns false if any semaphore couldn't be created, which fails
+**      OSK_C_FW_LibInit().
+**
+*/
+bool CJSON_LibInit(void);
+
+
 /******************************************************************************
 ** Function: CJSON_LoadObj
 **
 ** Notes:
 **   1. It is considered an error if the object is not found 
 **   2. See file prologue for supported JSON types.
+**   3. Calls made from a CJSON_ProcessFile*() callback with the callback's
+**      JSON buffer search with a cursor, so loading indexed keys such as
+**      "tbl[0].x" through "tbl[N].x" in ascending order walks the array
+**      once.
 **
 */
 bool CJSON_LoadObj(CJSON_Obj_t *Obj, const char *Buf, size_t BufLen);
 
 
+/******************************************************************************
+** Function: CJSON_LoadObjIndexed
+**
+** Notes:
+**   1. Same as CJSON_LoadObj() except the value is located using a structural
+**      index created by JSON_IndexBuild(). Tables that issue many queries
+**      against the same buffer can build the index once and avoid rescanning
+**      the buffer for each query.
+**
+*/
+bool CJSON_LoadObjIndexed(CJSON_Obj_t *Obj, const JSONIndex_t *Index);
+
+
 /******************************************************************************
 ** Function: CJSON_LoadObjArray
 **
@@ -167,6 +518,19 @@ bool CJSON_LoadObj(CJSON_Obj_t *Obj, const char *Buf, size_t BufLen);
 size_t CJSON_LoadObjArray(CJSON_Obj_t *Obj, size_t ObjCnt, const char* Buf, size_t BufLen);
 
 
+/******************************************************************************
+** Function: CJSON_LoadObjLoc
+**
+** Notes:
+**   1. Decodes a value located by CJSON_ProcessFileLocate() in Buf, which
+**      must still hold the located values. Returns false and clears the
+**      object's Updated flag if the value wasn't located or can't be
+**      decoded.
+**
+*/
+bool CJSON_LoadObjLoc(CJSON_Obj_t *Obj, const char *Buf, const CJSON_ObjLoc_t *ObjLoc);
+
+
 /******************************************************************************
 ** Function: CJSON_LoadObjOptional
 **
@@ -180,6 +544,25 @@ size_t CJSON_LoadObjArray(CJSON_Obj_t *Obj, size_t ObjCnt, const char* Buf, size
 bool CJSON_LoadObjOptional(CJSON_Obj_t *Obj, const char *Buf, size_t BufLen);
 
 
+/******************************************************************************
+** Function: CJSON_LoadStructArray
+**
+** Notes:
+**   1. Locates the JSON array identified by ArrayQuery and decodes each of 
+**      its elements into the next structure of StructArray. The array is
+**      traversed once so the cost is linear in the number of elements rather
+**      than quadratic as it is with one CJSON_LoadObj() query per element.
+**   2. Field[] describes the structure's fields, see CJSON_Field_t. Members
+**      that aren't described are ignored.
+**   3. Returns the number of elements that had every field loaded. Elements
+**      beyond StructCnt are not loaded and an event message is sent. 
+**
+*/
+size_t CJSON_LoadStructArray(const char *Buf, size_t BufLen, const char *ArrayQuery,
+                             void *StructArray, size_t StructSize, size_t StructCnt,
+                             const CJSON_Field_t *Field, size_t FieldCnt);
+
+
 /******************************************************************************
 ** Function: CJSON_ObjTypeStr
 **
@@ -195,6 +578,12 @@ const char* CJSON_ObjTypeStr(JSONTypes_t  ObjType);
 ** Notes:
 **  1. Takes care of all generic table processing and validation. User's 
 **     callback function performs table-specific data processing.
+**  2. If JsonBuf is NULL a buffer sized to the file is borrowed from the
+**     shared JSON buffer pool for the duration of the load, waiting up to
+**     CJSON_BUF_POOL_TIMEOUT milliseconds, and the callback gets it from 
+**     CJSON_GetFileBuf(). MaxJsonFileChar still limits the file's length.
+**     This applies to every CJSON_ProcessFile*() function with a JsonBuf.
+**     A callback that processes another file must pass it its own JsonBuf.
 */
 bool CJSON_ProcessFile(const char *Filename, char *JsonBuf, 
                        size_t MaxJsonFileChar, CJSON_LoadJsonData_t LoadJsonData);
@@ -213,4 +602,263 @@ bool CJSON_ProcessFileAlt(const char *Filename, char *JsonBuf,
                           size_t MaxJsonFileChar, CJSON_LoadJsonDataAlt_t LoadJsonDataAlt,
                           void* UserDataPtr);
 
+
+/******************************************************************************
+** Function: CJSON_ProcessFileObjArray
+**
+** Notes:
+**  1. Same functionality as CJSON_ProcessFileAlt except the file is validated
+**     and Obj[]'s values are loaded in the same traversal of the file. The 
+**     callback is called after the objects are loaded and it can use each
+**     object's Updated flag.
+**  2. Values are staged during the traversal and only loaded into the 
+**     objects' TblData if the entire file is valid.
+**  3. If ObjCnt exceeds CJSON_MAX_STAGED_OBJ the file is validated and then
+**     loaded using CJSON_LoadObjArray().
+**  4. JsonBuf can be NULL, see CJSON_ProcessFile().
+*/
+bool CJSON_ProcessFileObjArray(const char *Filename, char *JsonBuf, 
+                               size_t MaxJsonFileChar, CJSON_Obj_t *Obj, size_t ObjCnt,
+                               CJSON_LoadJsonDataAlt_t LoadJsonDataAlt, void* UserDataPtr);
+
+
+/******************************************************************************
+** Function: CJSON_ProcessFileLocate
+**
+** Notes:
+**  1. Same functionality as CJSON_ProcessFileObjArray except Obj[]'s values
+**     are only located. ObjLoc[i] receives the location of Obj[i]'s value
+**     and the callback decides which values to decode with 
+**     CJSON_LoadObjLoc(), so values that are never used are never decoded.
+**  2. ObjCnt must not exceed CJSON_MAX_STAGED_OBJ.
+**  3. Values that aren't found aren't reported, the callback decides 
+**     whether a value is required.
+**  4. JsonBuf can be NULL, see CJSON_ProcessFile(). The locations are only
+**     valid for the buffer the file was processed in.
+*/
+bool CJSON_ProcessFileLocate(const char *Filename, char *JsonBuf, 
+                             size_t MaxJsonFileChar, CJSON_Obj_t *Obj, CJSON_ObjLoc_t *ObjLoc,
+                             size_t ObjCnt, CJSON_LoadJsonDataAlt_t LoadJsonDataAlt, void* UserDataPtr);
+
+
+/******************************************************************************
+** Function: CJSON_ProcessFileStream
+**
+** Notes:
+**  1. Same functionality as CJSON_ProcessFileObjArray except the file is 
+**     parsed as it is read in small chunks so there's no JSON buffer and no
+**     limit on the file's size. Use this for files that exceed a practical
+**     JSON buffer size.
+**  2. Objects are loaded as their values are parsed so objects loaded before
+**     an invalid portion of the file keep their new values and the function
+**     returns false. Callers that need an all-or-nothing update should load
+**     into a working copy of their table. 
+**  3. A string value and its key must fit in JSON_STREAM_WINDOW_LEN. Object
+**     and array values and CJSON_STR_VIEW strings can't be loaded.
+**  4. ObjCnt must not exceed CJSON_MAX_STAGED_OBJ.
+**  5. Query keys must have no more than CJSON_MAX_QUERY_PARTS parts. An
+**     event message is sent for a longer key and its object isn't loaded.
+*/
+bool CJSON_ProcessFileStream(const char *Filename, CJSON_Obj_t *Obj, size_t ObjCnt,
+                             CJSON_LoadJsonDataAlt_t LoadJsonDataAlt, void* UserDataPtr);
+
+
+/******************************************************************************
+** Function: CJSON_ReleaseBuf
+**
+** Notes:
+**  1. Returns a buffer borrowed with CJSON_AcquireBuf() or 
+**     CJSON_AcquireFileBuf() to the pool and wakes the tasks waiting for
+**     a buffer.
+*/
+void CJSON_ReleaseBuf(const char *Buf);
+
+
+/******************************************************************************
+** Function: CJSON_ResetStats
+**
+*/
+void CJSON_ResetStats(void);
+
+
+/******************************************************************************
+** Function: CJSON_SchemaConstructor
+**
+** Notes:
+**  1. Compiles Field[]'s paths into Schema's decode plan. This is done once,
+**     typically during app initialization, and the plan is reused for each 
+**     CJSON_SchemaLoad().
+**  2. Field[] must remain valid for the life of the schema because the plan
+**     references its paths.
+**  3. Returns false and sends an event message if a field can't be compiled.
+*/
+bool CJSON_SchemaConstructor(CJSON_Schema_t *Schema, const CJSON_SchemaField_t *Field,
+                             uint16 FieldCnt);
+
+
+
+/******************************************************************************
+** Function: CJSON_SchemaLoad
+**
+** Notes:
+**  1. Validates Buf and decodes every schema field into Tbl in one traversal
+**     of Buf. Values are decoded as they are validated so Tbl should be a
+**     working copy of the table that is only used if this returns true.
+**  2. Returns true if Buf is valid JSON and every required field was 
+**     loaded. A required "[*]" field must be loaded from every element.
+**  3. If a non-array path appears more than once the first occurrence is
+**     loaded. 
+*/
+bool CJSON_SchemaLoad(CJSON_Schema_t *Schema, const char *Buf, size_t BufLen, void *Tbl);
+
+
+/******************************************************************************
+** Function: CJSON_SchemaLoadCnt
+**
+** Notes:
+**  1. Returns the number of values the last CJSON_SchemaLoad() loaded for
+**     Field[FieldIdx]. For a "[*]" field this is the number of elements
+**     loaded.
+*/
+size_t CJSON_SchemaLoadCnt(const CJSON_Schema_t *Schema, uint16 FieldIdx);
+
+
+/******************************************************************************
+** Function: CJSON_ShrinkBuf
+**
+** Notes:
+**  1. Reduces a borrowed buffer to its first BufLen characters and returns
+**     the rest to the pool. This lets a caller that keeps a buffer, for 
+**     example after compacting the values it needs, hold only what it uses.
+**  2. Returns false if Buf isn't borrowed or BufLen exceeds its length.
+*/
+bool CJSON_ShrinkBuf(const char *Buf, size_t BufLen);
+
+
+/******************************************************************************
+** Function: CJSON_WriterOpen
+**
+** Notes:
+**  1. Creates Filename and prepares Writer to write a JSON document to it
+**     using Buf. A larger buffer means fewer OS_write() calls. A table dump
+**     function typically uses:
+**
+**        CJSON_WriterOpen(&Writer, Filename, Buf, sizeof(Buf));
+**        CJSON_WriterBeginObj(&Writer, NULL);
+**        CJSON_WriterStr(&Writer, "name", Tbl->Name);
+**        CJSON_WriterBeginArray(&Writer, "entry");
+**        ... One CJSON_WriterBeginObj()/EndObj() per element
+**        CJSON_WriterEndArray(&Writer);
+**        CJSON_WriterEndObj(&Writer);
+**        RetStatus = CJSON_WriterClose(&Writer);
+**
+**  2. Key is the member's key when writing an object member and NULL 
+**     when writing an array element or the document's root.
+**  3. Errors are sticky so the writing functions don't return a status. 
+**     CJSON_WriterClose() returns false if any error occurred.
+*/
+bool CJSON_WriterOpen(CJSON_Writer_t *Writer, const char *Filename, char *Buf, size_t BufLen);
+
+
+/******************************************************************************
+** Function: CJSON_WriterClose
+**
+** Notes:
+**  1. Writes the buffered characters and closes the file. Returns true if
+**     the complete document was written without errors.
+*/
+bool CJSON_WriterClose(CJSON_Writer_t *Writer);
+
+
+/******************************************************************************
+** Function: CJSON_WriterBeginArray
+**
+*/
+void CJSON_WriterBeginArray(CJSON_Writer_t *Writer, const char *Key);
+
+
+/******************************************************************************
+** Function: CJSON_WriterBeginObj
+**
+*/
+void CJSON_WriterBeginObj(CJSON_Writer_t *Writer, const char *Key);
+
+
+/******************************************************************************
+** Function: CJSON_WriterDbl
+**
+** Notes:
+**  1. Writes enough digits for the value to be loaded without change.
+**     Infinite and NaN values are written as null.
+*/
+void CJSON_WriterDbl(CJSON_Writer_t *Writer, const char *Key, double Value);
+
+
+/******************************************************************************
+** Function: CJSON_WriterEndArray
+**
+*/
+void CJSON_WriterEndArray(CJSON_Writer_t *Writer);
+
+
+/******************************************************************************
+** Function: CJSON_WriterEndObj
+**
+*/
+void CJSON_WriterEndObj(CJSON_Writer_t *Writer);
+
+
+/******************************************************************************
+** Function: CJSON_WriterFlt
+**
+** Notes:
+**  1. See CJSON_WriterDbl().
+*/
+void CJSON_WriterFlt(CJSON_Writer_t *Writer, const char *Key, float Value);
+
+
+/******************************************************************************
+** Function: CJSON_WriterHex
+**
+** Notes:
+**  1. Writes Value as a "0x" hex string, the usual message ID format, 
+**     which is loaded by a JSONNumber object.
+*/
+void CJSON_WriterHex(CJSON_Writer_t *Writer, const char *Key, uint32 Value);
+
+
+/******************************************************************************
+** Function: CJSON_WriterInt
+**
+*/
+void CJSON_WriterInt(CJSON_Writer_t *Writer, const char *Key, int64 Value);
+
+
+/******************************************************************************
+** Function: CJSON_WriterStr
+**
+** Notes:
+**  1. Str must be terminated. Quotes, backslashes and control characters
+**     are escaped.
+*/
+void CJSON_WriterStr(CJSON_Writer_t *Writer, const char *Key, const char *Str);
+
+
+/******************************************************************************
+** Function: CJSON_WriterStats
+**
+** Notes:
+**  1. Writes CJSON_GetStats()'s counters as an object member named Key so
+**     load performance can be recorded in a machine readable file. The
+**     counters are approximate, see CJSON_Stats_t.
+*/
+void CJSON_WriterStats(CJSON_Writer_t *Writer, const char *Key);
+
+
+/******************************************************************************
+** Function: CJSON_WriterUint
+**
+*/
+void CJSON_WriterUint(CJSON_Writer_t *Writer, const char *Key, uint64 Value);
+
 #endif /* _cjson_ */
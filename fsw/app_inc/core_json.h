@@ -30,6 +30,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /**
  * @ingroup json_enum_types
@@ -43,7 +44,10 @@ typedef enum
     JSONMaxDepthExceeded, /**< @brief JSON document has nesting that exceeds JSON_MAX_DEPTH. */
     JSONNotFound,         /**< @brief Query key could not be found in the JSON document. */
     JSONNullParameter,    /**< @brief Pointer parameter passed to a function is NULL. */
-    JSONBadParameter      /**< @brief Query key is empty, or any subpart is empty, or max is 0. */
+    JSONBadParameter,     /**< @brief Query key is empty, or any subpart is empty, or max is 0. */
+    JSONIndexFull,        /**< @brief JSON document has more values than the index arena holds. */
+    JSONTokenTooLong,     /**< @brief A key and value don't fit in a stream's window. */
+    JSONOutOfRange        /**< @brief A number can't be represented by the requested type. */
 } JSONStatus_t;
 
 /**
@@ -53,12 +57,18 @@ typedef enum
  * @param[in] max  The size of the buffer.
  *
  * @note The maximum nesting depth may be specified by defining the macro
- * JSON_MAX_DEPTH.  The default is 32 of sizeof(char).
+ * JSON_MAX_DEPTH.  The default is 32, held one bit per level on the stack.
+ * Use JSON_ValidateNested() to choose the depth at run time.
  *
  * @note By default, a valid JSON document may contain a single element
  * (e.g., string, boolean, number).  To require that a valid document
  * contain an object or array, define JSON_VALIDATE_COLLECTIONS_ONLY.
  *
+ * @note Whitespace and string characters are classified 16 bytes at a time
+ * with SSE2 on x86 and NEON on AArch64.  The results are identical to the
+ * byte-at-a-time parser, which is used on other targets or when
+ * JSON_DISABLE_SIMD is defined.
+ *
  * @return #JSONSuccess if the buffer contents are valid JSON;
  * #JSONNullParameter if buf is NULL;
  * #JSONBadParameter if max is 0;
@@ -84,6 +94,41 @@ JSONStatus_t JSON_Validate( const char * buf,
                             size_t max );
 /* @[declare_json_validate] */
 
+/**
+ * @brief Bytes of nesting state needed to validate @p depth levels.
+ *
+ * Each open object or array takes one bit.
+ */
+#define JSON_NESTING_LEN( depth )    ( ( ( size_t ) ( depth ) + 7U ) / 8U )
+
+/**
+ * @brief Parse a buffer to determine if it contains a valid JSON document,
+ * holding the nesting state in a caller-owned buffer.
+ *
+ * This is JSON_Validate() with a run-time depth limit.  A task with a small
+ * stack can keep the nesting state in static or pool memory, and a deeply
+ * nested document can be validated without raising JSON_MAX_DEPTH for every
+ * caller.  The maximum depth is 8 * @p nestingLength.
+ *
+ * @param[in] buf  The buffer to parse.
+ * @param[in] max  The size of the buffer.
+ * @param[in] nesting  Scratch for the nesting state, see JSON_NESTING_LEN().
+ * @param[in] nestingLength  The size of @p nesting in bytes.
+ *
+ * @return #JSONSuccess if the buffer contents are valid JSON;
+ * #JSONNullParameter if buf or nesting is NULL;
+ * #JSONBadParameter if max or nestingLength is 0;
+ * #JSONIllegalDocument if the buffer contents are NOT valid JSON;
+ * #JSONMaxDepthExceeded if object and array nesting exceeds 8 * @p nestingLength;
+ * #JSONPartial if the buffer contents are potentially valid but incomplete.
+ */
+/* @[declare_json_validatenested] */
+JSONStatus_t JSON_ValidateNested( const char * buf,
+                                  size_t max,
+                                  uint8_t * nesting,
+                                  size_t nestingLength );
+/* @[declare_json_validatenested] */
+
 /**
  * @brief Find a key or array index in a JSON document and output the
  * pointer @p outValue to its value.
@@ -114,7 +159,7 @@ JSONStatus_t JSON_Validate( const char * buf,
  * @param[out] outValueLength  A pointer to receive the length of the value found.
  *
  * @note The maximum nesting depth may be specified by defining the macro
- * JSON_MAX_DEPTH.  The default is 32 of sizeof(char).
+ * JSON_MAX_DEPTH.  The default is 32, held one bit per level on the stack.
  *
  * @note JSON_Search() performs validation, but stops upon finding a matching
  * key and its value. To validate the entire JSON document, use JSON_Validate().
@@ -321,4 +366,712 @@ JSONStatus_t JSON_Iterate( const char * buf,
                            size_t * next,
                            JSONPair_t * outPair );
 /* @[declare_json_iterate] */
+
+/**
+ * @ingroup json_struct_types
+ * @brief A value reported by JSON_ValidateVisit().
+ *
+ * A scalar is reported once.  A collection is reported when it opens, with
+ * a @p valueLength of 0, and again when it closes with its full length.
+ * Keys are only reported when a value opens.
+ */
+typedef struct
+{
+    size_t value;         /**< @brief Buffer index of the value's first character. */
+    size_t valueLength;   /**< @brief Length of the value including quotes or brackets. */
+    size_t key;           /**< @brief Buffer index of the key, 0 if the value is not an object member. */
+    size_t keyLength;     /**< @brief Length of the key without quotes. */
+    uint32_t arrayIndex;  /**< @brief Position of the value within its enclosing collection. */
+    uint16_t depth;       /**< @brief Nesting depth, 0 for the document's outermost value. */
+    JSONTypes_t jsonType; /**< @brief JSON-specific type of the value. */
+} JSONVisit_t;
+
+/**
+ * @brief Function called by JSON_ValidateVisit() for each value.
+ *
+ * @param[in] context  The context passed to JSON_ValidateVisit().
+ * @param[in] buf  The buffer being validated.
+ * @param[in] visit  The value being reported.
+ */
+typedef void ( * JSONVisitor_t )( void * context,
+                                  const char * buf,
+                                  const JSONVisit_t * visit );
+
+/**
+ * @brief Validate a JSON document and report each of its values.
+ *
+ * Values are reported in document order while the document is validated so
+ * a caller can locate the values it needs without a second traversal.  The
+ * document may still prove invalid after values are reported, so anything
+ * derived from them should be staged until this returns #JSONSuccess.
+ *
+ * @param[in] buf  The buffer to validate.
+ * @param[in] max  The size of the buffer.
+ * @param[in] visitor  The function called for each value.
+ * @param[in] context  Passed to @p visitor.
+ *
+ * @return #JSONSuccess if the buffer contents are valid JSON;
+ * #JSONNullParameter if buf or visitor is NULL;
+ * #JSONBadParameter if max is 0;
+ * #JSONIllegalDocument if the buffer contents are NOT valid JSON;
+ * #JSONMaxDepthExceeded if object and array nesting exceeds a threshold;
+ * #JSONPartial if the buffer contents are potentially valid but incomplete.
+ */
+/* @[declare_json_validatevisit] */
+JSONStatus_t JSON_ValidateVisit( const char * buf,
+                                 size_t max,
+                                 JSONVisitor_t visitor,
+                                 void * context );
+/* @[declare_json_validatevisit] */
+
+/**
+ * @ingroup json_struct_types
+ * @brief Caller-owned nesting state for JSON_ValidateVisitNested().
+ *
+ * Each level of nesting takes one element of @p start and of @p count,
+ * 12 to 16 bytes depending on sizeof(size_t).
+ */
+typedef struct
+{
+    size_t * start;    /**< @brief Position of each open collection, maxDepth entries. */
+    uint32_t * count;  /**< @brief Number of values in each open collection, maxDepth entries. */
+    size_t maxDepth;   /**< @brief Number of entries in start and count. */
+} JSONNesting_t;
+
+/**
+ * @brief Validate a JSON document and report each of its values, holding
+ * the nesting state in caller-owned arrays.
+ *
+ * This is JSON_ValidateVisit() with a run-time depth limit.  The reported
+ * depth never reaches @p nesting->maxDepth.
+ *
+ * @param[in] buf  The buffer to validate.
+ * @param[in] max  The size of the buffer.
+ * @param[in] visitor  The function called for each value.
+ * @param[in] context  Passed to @p visitor.
+ * @param[in] nesting  The nesting state arrays.
+ *
+ * @return #JSONSuccess if the buffer contents are valid JSON;
+ * #JSONNullParameter if buf, visitor, nesting or its arrays are NULL;
+ * #JSONBadParameter if max or nesting->maxDepth is 0;
+ * #JSONIllegalDocument if the buffer contents are NOT valid JSON;
+ * #JSONMaxDepthExceeded if object and array nesting exceeds nesting->maxDepth;
+ * #JSONPartial if the buffer contents are potentially valid but incomplete.
+ */
+/* @[declare_json_validatevisitnested] */
+JSONStatus_t JSON_ValidateVisitNested( const char * buf,
+                                       size_t max,
+                                       JSONVisitor_t visitor,
+                                       void * context,
+                                       const JSONNesting_t * nesting );
+/* @[declare_json_validatevisitnested] */
+
+/**
+ * @brief Maximum nesting depth of objects and arrays.
+ *
+ * Also sizes the nesting state of a #JSONStream_t.
+ */
+#ifndef JSON_MAX_DEPTH
+    #define JSON_MAX_DEPTH    32
+#endif
+
+/**
+ * @brief Size of a #JSONStream_t's window.
+ *
+ * The window holds the key and the value currently being parsed so it
+ * limits the length of a key plus its scalar value, including quotes.
+ */
+#ifndef JSON_STREAM_WINDOW_LEN
+    #define JSON_STREAM_WINDOW_LEN    256
+#endif
+
+/**
+ * @ingroup json_struct_types
+ * @brief State of a document parsed with JSON_StreamParse().
+ *
+ * The members are private to the parser.
+ */
+typedef struct
+{
+    JSONVisitor_t visitor;                  /**< @brief Function called for each value. */
+    void * context;                         /**< @brief Passed to the visitor. */
+    JSONStatus_t status;                    /**< @brief #JSONPartial until the document is complete or invalid. */
+    size_t position;                        /**< @brief Number of characters consumed. */
+    size_t start[ JSON_MAX_DEPTH ];         /**< @brief Position of each open collection. */
+    uint32_t count[ JSON_MAX_DEPTH ];       /**< @brief Number of values in each open collection. */
+    char open[ JSON_MAX_DEPTH ];            /**< @brief Bracket of each open collection. */
+    int16_t depth;                          /**< @brief Innermost open collection, -1 at the top level. */
+    uint8_t state;                          /**< @brief What the parser expects next. */
+    uint8_t token;                          /**< @brief Kind of token being accumulated. */
+    bool escape;                            /**< @brief The last string character was a backslash. */
+    bool member;                            /**< @brief The window holds the current value's key. */
+    size_t valueStart;                      /**< @brief Window index of the current value. */
+    size_t windowLength;                    /**< @brief Number of characters in the window. */
+    char window[ JSON_STREAM_WINDOW_LEN ];  /**< @brief The current key and value. */
+} JSONStream_t;
+
+/**
+ * @brief Initialize a stream to parse a new document.
+ *
+ * @param[out] stream  The stream to initialize.
+ * @param[in] visitor  The function called for each value.
+ * @param[in] context  Passed to @p visitor.
+ *
+ * @return #JSONSuccess if the stream is initialized;
+ * #JSONNullParameter if stream or visitor is NULL.
+ */
+/* @[declare_json_streaminit] */
+JSONStatus_t JSON_StreamInit( JSONStream_t * stream,
+                              JSONVisitor_t visitor,
+                              void * context );
+/* @[declare_json_streaminit] */
+
+/**
+ * @brief Validate the next chunk of a document and report its values.
+ *
+ * A document may be split into chunks at any character so a file can be
+ * parsed through a small read buffer.  Values are validated and reported
+ * the same way as JSON_ValidateVisit() except the visitor's buffer is the
+ * stream's window.  A scalar's key and value are in the window.  Only a
+ * collection's opening bracket is in the window and the length reported
+ * when it closes is its length within the document.
+ *
+ * @param[in,out] stream  The stream initialized by JSON_StreamInit().
+ * @param[in] chunk  The next characters of the document.
+ * @param[in] length  The number of characters in @p chunk.
+ *
+ * @return #JSONPartial if the document is incomplete;
+ * #JSONSuccess if the document is complete, in which case any further
+ * characters must be whitespace;
+ * #JSONNullParameter if stream or chunk is NULL;
+ * #JSONIllegalDocument if the document is NOT valid JSON;
+ * #JSONMaxDepthExceeded if object and array nesting exceeds a threshold;
+ * #JSONTokenTooLong if a key and value don't fit in the window.
+ */
+/* @[declare_json_streamparse] */
+JSONStatus_t JSON_StreamParse( JSONStream_t * stream,
+                               const char * chunk,
+                               size_t length );
+/* @[declare_json_streamparse] */
+
+/**
+ * @brief Complete a document parsed with JSON_StreamParse().
+ *
+ * A number at the end of a document has no terminating character so it
+ * is only reported here.
+ *
+ * @param[in,out] stream  The stream initialized by JSON_StreamInit().
+ *
+ * @return #JSONSuccess if the document is valid JSON;
+ * #JSONNullParameter if stream is NULL;
+ * #JSONPartial if the document is incomplete;
+ * otherwise the error returned by JSON_StreamParse().
+ */
+/* @[declare_json_streamfinish] */
+JSONStatus_t JSON_StreamFinish( JSONStream_t * stream );
+/* @[declare_json_streamfinish] */
+
+/**
+ * @brief Entry index used to mark the absence of a parent collection.
+ */
+#define JSON_INDEX_NONE    ( 0xFFFFFFFFU )
+
+/**
+ * @ingroup json_struct_types
+ * @brief Structural index entry for one value of a JSON document.
+ *
+ * Entries are stored in document order so the first member of a collection
+ * immediately follows the collection's entry and @p next skips a value's
+ * nested members.
+ */
+typedef struct
+{
+    uint32_t value;       /**< @brief Buffer index of the value's first character. */
+    uint32_t valueLength; /**< @brief Length of the value including quotes or brackets. */
+    uint32_t key;         /**< @brief Buffer index of the key, 0 if the value is not an object member. */
+    uint32_t keyLength;   /**< @brief Length of the key without quotes. */
+    uint32_t keyHash;     /**< @brief Hash of the key, see JSON_QueryCompile(). */
+    uint32_t parent;      /**< @brief Entry of the enclosing collection or #JSON_INDEX_NONE for the root. */
+    uint32_t next;        /**< @brief Entry that follows this value and all of its members. */
+    JSONTypes_t jsonType; /**< @brief JSON-specific type of the value. */
+} JSONIndexEntry_t;
+
+/**
+ * @ingroup json_struct_types
+ * @brief Structural index of a JSON document.
+ *
+ * The entry storage is supplied by the caller so an index can be statically
+ * allocated. The index references the buffer it was built from so the buffer
+ * must not be modified while the index is in use.
+ */
+typedef struct
+{
+    const char * buf;           /**< @brief The indexed buffer. */
+    size_t max;                 /**< @brief Size of the indexed buffer. */
+    JSONIndexEntry_t * entries; /**< @brief Caller supplied entry arena. */
+    size_t capacity;            /**< @brief Number of entries in the arena. */
+    size_t count;               /**< @brief Number of entries used by the document. */
+} JSONIndex_t;
+
+/**
+ * @brief Validate a JSON document and build a structural index of its values.
+ *
+ * The document is parsed once.  Each value is recorded with its location,
+ * its key when it is an object member, and links to its parent and to the
+ * next value that is not nested within it.  Searches performed with
+ * JSON_IndexSearch() use the links rather than rescanning the buffer.
+ *
+ * @param[in] buf  The buffer to parse.
+ * @param[in] max  The size of the buffer.
+ * @param[out] index  The index to build.
+ * @param[in] arena  Storage for the index entries.
+ * @param[in] arenaCount  The number of entries in @p arena.
+ *
+ * @return #JSONSuccess if the buffer contents are valid JSON and indexed;
+ * #JSONNullParameter if any pointer is NULL;
+ * #JSONBadParameter if max or arenaCount is 0 or max exceeds 32 bits;
+ * #JSONIllegalDocument if the buffer contents are NOT valid JSON;
+ * #JSONMaxDepthExceeded if object and array nesting exceeds a threshold;
+ * #JSONPartial if the buffer contents are potentially valid but incomplete;
+ * #JSONIndexFull if the document has more values than @p arenaCount.
+ */
+/* @[declare_json_indexbuild] */
+JSONStatus_t JSON_IndexBuild( const char * buf,
+                              size_t max,
+                              JSONIndex_t * index,
+                              JSONIndexEntry_t * arena,
+                              size_t arenaCount );
+/* @[declare_json_indexbuild] */
+
+/**
+ * @brief Same as JSON_SearchConst(), but searches an index built by
+ * JSON_IndexBuild().
+ *
+ * See @ref JSON_Search for the query syntax.
+ *
+ * @param[in] index  The index to search.
+ * @param[in] query  The object keys and array indexes to search for.
+ * @param[in] queryLength  Length of the key.
+ * @param[out] outValue  A pointer to receive the address of the value found.
+ * @param[out] outValueLength  A pointer to receive the length of the value found.
+ * @param[out] outType  An enum indicating the JSON-specific type of the value.
+ *
+ * @return #JSONSuccess if the query is matched and the value output;
+ * #JSONNullParameter if any pointer parameters are NULL;
+ * #JSONBadParameter if the query is empty, the index is empty, or the
+ * query is malformed;
+ * #JSONNotFound if the query has no match.
+ */
+/* @[declare_json_indexsearch] */
+JSONStatus_t JSON_IndexSearch( const JSONIndex_t * index,
+                               const char * query,
+                               size_t queryLength,
+                               const char ** outValue,
+                               size_t * outValueLength,
+                               JSONTypes_t * outType );
+/* @[declare_json_indexsearch] */
+
+/**
+ * @brief Maximum number of keys and array indexes in a compiled query.
+ *
+ * A query with more parts can still be searched with JSON_SearchConst().
+ */
+#ifndef JSON_QUERY_MAX_PARTS
+    #define JSON_QUERY_MAX_PARTS    8
+#endif
+
+/**
+ * @brief Compiled query part value used to mark an object key.
+ */
+#define JSON_QUERY_KEY    ( 0xFFFFFFFFU )
+
+/**
+ * @brief Compiled query part value that matches every element of an array.
+ *
+ * JSON_QueryCompile() emits it for a "[*]" part.  JSON_SearchCompiled() and
+ * JSON_IndexSearchCompiled() don't accept it, see JSON_SearchEachCompiled().
+ */
+#define JSON_QUERY_ANY_INDEX    ( 0xFFFFFFFEU )
+
+/**
+ * @brief Compiled query part value that matches every member of an object.
+ *
+ * JSON_QueryCompile() emits it for a "*" key part.
+ */
+#define JSON_QUERY_ANY_KEY    ( 0xFFFFFFFDU )
+
+/**
+ * @ingroup json_struct_types
+ * @brief One key or array index of a compiled query.
+ */
+typedef struct
+{
+    uint32_t keyHash;    /**< @brief Hash of the key, unused for an array index. */
+    uint32_t arrayIndex; /**< @brief Array index, #JSON_QUERY_KEY for a key, or a wildcard. */
+    uint16_t keyOffset;  /**< @brief Offset of the key within the query string. */
+    uint16_t keyLength;  /**< @brief Length of the key. */
+} JSONQueryPart_t;
+
+/**
+ * @ingroup json_struct_types
+ * @brief A query split into its keys and array indexes.
+ *
+ * Keys are referenced by their offset within the query string so the
+ * compiled form stays valid when the structure holding both is copied.
+ */
+typedef struct
+{
+    size_t partCount;                             /**< @brief Number of parts, 0 if not compiled. */
+    size_t wildcardCount;                         /**< @brief Number of "[*]" and "*" parts. */
+    JSONQueryPart_t parts[ JSON_QUERY_MAX_PARTS ]; /**< @brief Parts in query order. */
+} JSONQuery_t;
+
+/**
+ * @brief Split a query into keys and array indexes so it can be searched
+ * repeatedly without being parsed again.
+ *
+ * See @ref JSON_Search for the query syntax.  A compiled query may also
+ * contain wildcards for JSON_SearchEachCompiled(): "[*]" matches every
+ * element of an array and a "*" key matches every member of an object,
+ * e.g. "entries[*].mid" or "apps.*.priority".  A key can't be "*".
+ *
+ * @param[in] query  The object keys and array indexes to search for.
+ * @param[in] queryLength  Length of the query.
+ * @param[out] outQuery  The compiled query.
+ *
+ * @return #JSONSuccess if the query was compiled;
+ * #JSONNullParameter if any pointer is NULL;
+ * #JSONBadParameter if the query is empty, malformed, longer than 65535
+ * characters, or has more than #JSON_QUERY_MAX_PARTS parts.
+ */
+/* @[declare_json_querycompile] */
+JSONStatus_t JSON_QueryCompile( const char * query,
+                                size_t queryLength,
+                                JSONQuery_t * outQuery );
+/* @[declare_json_querycompile] */
+
+/**
+ * @brief Same as JSON_SearchConst(), but uses a query compiled by
+ * JSON_QueryCompile().
+ *
+ * @param[in] buf  The buffer to search.
+ * @param[in] max  size of the buffer.
+ * @param[in] query  The query string that was compiled.
+ * @param[in] compiled  The compiled query.
+ * @param[out] outValue  A pointer to receive the address of the value found.
+ * @param[out] outValueLength  A pointer to receive the length of the value found.
+ * @param[out] outType  An enum indicating the JSON-specific type of the value.
+ *
+ * @return #JSONSuccess if the query is matched and the value output;
+ * #JSONNullParameter if any pointer parameters are NULL;
+ * #JSONBadParameter if max is 0, the query has not been compiled or it
+ * contains wildcards;
+ * #JSONNotFound if the query has no match.
+ */
+/* @[declare_json_searchcompiled] */
+JSONStatus_t JSON_SearchCompiled( const char * buf,
+                                  size_t max,
+                                  const char * query,
+                                  const JSONQuery_t * compiled,
+                                  const char ** outValue,
+                                  size_t * outValueLength,
+                                  JSONTypes_t * outType );
+/* @[declare_json_searchcompiled] */
+
+/**
+ * @brief Cursor collection value used to mark a query part with no value.
+ */
+#define JSON_CURSOR_NONE    ( ( size_t ) -1 )
+
+/**
+ * @ingroup json_struct_types
+ * @brief The value a JSON_SearchCursor() query part found.
+ */
+typedef struct
+{
+    size_t collection;   /**< @brief Buffer index of the collection searched, or #JSON_CURSOR_NONE. */
+    size_t value;        /**< @brief Buffer index of the value found. */
+    size_t valueLength;  /**< @brief Length of the value found. */
+    size_t key;          /**< @brief Buffer index of the value's key, for a key part. */
+    size_t keyLength;    /**< @brief Length of the key. */
+    uint32_t arrayIndex; /**< @brief The part's array index or #JSON_QUERY_KEY. */
+} JSONCursorPart_t;
+
+/**
+ * @ingroup json_struct_types
+ * @brief The values found by the previous JSON_SearchCursor().
+ *
+ * One value is kept per query part so nested loops such as "tbl[i].item[j]"
+ * resume at every level.  The cursor references the buffer it was used with
+ * so it must be reset by JSON_CursorInit() whenever the buffer's contents
+ * change.
+ */
+typedef struct
+{
+    const char * buf;                               /**< @brief Buffer the values were found in. */
+    size_t max;                                     /**< @brief Size of the buffer. */
+    JSONCursorPart_t parts[ JSON_QUERY_MAX_PARTS ]; /**< @brief Value found by each query part. */
+} JSONCursor_t;
+
+/**
+ * @brief Reset a cursor so its next search starts from the beginning of
+ * the document.
+ *
+ * @param[out] cursor  The cursor to reset.
+ */
+/* @[declare_json_cursorinit] */
+void JSON_CursorInit( JSONCursor_t * cursor );
+/* @[declare_json_cursorinit] */
+
+/**
+ * @brief Same as JSON_SearchCompiled(), but each part of the query starts
+ * from the value the previous search found for that part.
+ *
+ * JSON_SearchCompiled() walks an array from its first element and measures
+ * every enclosing collection, so loading "tbl[0].x" through "tbl[N].x"
+ * walks O(N^2) elements.  With a cursor, a part that matches the previous
+ * search's part in the same collection reuses its value, and an array index
+ * beyond the previous one resumes from the previous element.  Ascending
+ * loops therefore walk each element once; other queries walk from the
+ * start of the collection.
+ *
+ * @param[in] buf  The buffer to search.
+ * @param[in] max  size of the buffer.
+ * @param[in] query  The query string that was compiled.
+ * @param[in] compiled  The compiled query.
+ * @param[in,out] cursor  The values found by the previous search.
+ * @param[out] outValue  A pointer to receive the address of the value found.
+ * @param[out] outValueLength  A pointer to receive the length of the value found.
+ * @param[out] outType  An enum indicating the JSON-specific type of the value.
+ *
+ * @return See JSON_SearchCompiled().
+ */
+/* @[declare_json_searchcursor] */
+JSONStatus_t JSON_SearchCursor( const char * buf,
+                                size_t max,
+                                const char * query,
+                                const JSONQuery_t * compiled,
+                                JSONCursor_t * cursor,
+                                const char ** outValue,
+                                size_t * outValueLength,
+                                JSONTypes_t * outType );
+/* @[declare_json_searchcursor] */
+
+/**
+ * @brief Same as JSON_IndexSearch(), but uses a query compiled by
+ * JSON_QueryCompile().
+ *
+ * Keys are compared by length and hash before their characters are compared.
+ *
+ * @param[in] index  The index to search.
+ * @param[in] query  The query string that was compiled.
+ * @param[in] compiled  The compiled query.
+ * @param[out] outValue  A pointer to receive the address of the value found.
+ * @param[out] outValueLength  A pointer to receive the length of the value found.
+ * @param[out] outType  An enum indicating the JSON-specific type of the value.
+ *
+ * @return #JSONSuccess if the query is matched and the value output;
+ * #JSONNullParameter if any pointer parameters are NULL;
+ * #JSONBadParameter if the index is empty, the query has not been compiled
+ * or it contains wildcards;
+ * #JSONNotFound if the query has no match.
+ */
+/* @[declare_json_indexsearchcompiled] */
+JSONStatus_t JSON_IndexSearchCompiled( const JSONIndex_t * index,
+                                       const char * query,
+                                       const JSONQuery_t * compiled,
+                                       const char ** outValue,
+                                       size_t * outValueLength,
+                                       JSONTypes_t * outType );
+/* @[declare_json_indexsearchcompiled] */
+
+/**
+ * @ingroup json_struct_types
+ * @brief What a wildcard query part matched.
+ */
+typedef struct
+{
+    const char * key;    /**< @brief Key matched by a "*" part, NULL for a "[*]" part. */
+    size_t keyLength;    /**< @brief Length of the key. */
+    uint32_t arrayIndex; /**< @brief Element matched by a "[*]" part. */
+} JSONWildcard_t;
+
+/**
+ * @ingroup json_struct_types
+ * @brief A value reported by JSON_SearchEach().
+ */
+typedef struct
+{
+    const char * value;                 /**< @brief The value, without quotes for a string. */
+    size_t valueLength;                 /**< @brief Length of the value. */
+    JSONTypes_t jsonType;               /**< @brief JSON-specific type of the value. */
+    const JSONWildcard_t * wildcards;   /**< @brief What each wildcard matched, in query order. */
+    size_t wildcardCount;               /**< @brief Number of wildcards. */
+} JSONMatch_t;
+
+/**
+ * @brief Function called by JSON_SearchEach() for each match.
+ *
+ * @param[in] context  The context passed to JSON_SearchEach().
+ * @param[in] match  The matched value.  It is only valid during the call.
+ */
+typedef void ( * JSONMatchCallback_t )( void * context,
+                                        const JSONMatch_t * match );
+
+/**
+ * @brief Find every value that matches a query with wildcards.
+ *
+ * The document is validated and searched in a single traversal and
+ * @p callback is called for each match in document order, so a table
+ * such as "entries[*].mid" can be collected without knowing the number
+ * of entries or searching once per entry.  See JSON_QueryCompile() for
+ * the wildcard syntax.  Matches may be reported before a later part of
+ * the document proves invalid, so anything derived from them should be
+ * staged until this returns #JSONSuccess.
+ *
+ * @param[in] buf  The buffer to search.
+ * @param[in] max  size of the buffer.
+ * @param[in] query  The object keys, array indexes and wildcards to search for.
+ * @param[in] queryLength  Length of the query.
+ * @param[in] callback  The function called for each match.
+ * @param[in] context  Passed to @p callback.
+ *
+ * @return #JSONSuccess if the buffer contents are valid JSON and at least
+ * one value matched;
+ * #JSONNullParameter if any pointer parameters are NULL;
+ * #JSONBadParameter if max is 0 or the query can't be compiled;
+ * #JSONNotFound if the query has no match;
+ * #JSONIllegalDocument, #JSONMaxDepthExceeded or #JSONPartial as for
+ * JSON_Validate().
+ */
+/* @[declare_json_searcheach] */
+JSONStatus_t JSON_SearchEach( const char * buf,
+                              size_t max,
+                              const char * query,
+                              size_t queryLength,
+                              JSONMatchCallback_t callback,
+                              void * context );
+/* @[declare_json_searcheach] */
+
+/**
+ * @brief Same as JSON_SearchEach(), but uses a query compiled by
+ * JSON_QueryCompile().
+ *
+ * @param[in] buf  The buffer to search.
+ * @param[in] max  size of the buffer.
+ * @param[in] query  The query string that was compiled.
+ * @param[in] compiled  The compiled query.
+ * @param[in] callback  The function called for each match.
+ * @param[in] context  Passed to @p callback.
+ *
+ * @return See JSON_SearchEach().  #JSONBadParameter is also returned if
+ * the query has not been compiled.
+ */
+/* @[declare_json_searcheachcompiled] */
+JSONStatus_t JSON_SearchEachCompiled( const char * buf,
+                                      size_t max,
+                                      const char * query,
+                                      const JSONQuery_t * compiled,
+                                      JSONMatchCallback_t callback,
+                                      void * context );
+/* @[declare_json_searcheachcompiled] */
+
+/**
+ * @brief Significant digits JSON_NumberDecode() keeps when a float or
+ * double needs more than one rounding step.
+ *
+ * Sizes a stack buffer of about this many bytes.  800 digits hold the
+ * exact intermediate values of any number that can round to a double, so
+ * results are correctly rounded.  With fewer digits numbers near halfway
+ * between two floats or doubles can be misrounded.
+ */
+#ifndef JSON_NUMBER_MAX_DIGITS
+    #define JSON_NUMBER_MAX_DIGITS    800U
+#endif
+
+/**
+ * @ingroup json_enum_types
+ * @brief C types produced by JSON_NumberDecode().
+ */
+typedef enum
+{
+    JSONNumInt32,  /**< @brief int32_t */
+    JSONNumUint32, /**< @brief uint32_t */
+    JSONNumInt64,  /**< @brief int64_t */
+    JSONNumUint64, /**< @brief uint64_t */
+    JSONNumFloat,  /**< @brief float */
+    JSONNumDouble  /**< @brief double */
+} JSONNumberType_t;
+
+/**
+ * @brief Decode a number in place, without copying it or using locale
+ * dependent conversions.
+ *
+ * The whole of buf[0..length) must be a number using the JSON grammar, as
+ * returned by JSON_SearchConst() for a #JSONNumber value.  Integer types
+ * also accept an unsigned hexadecimal number with a "0x" or "0X" prefix,
+ * which is the usual way message IDs are written in JSON strings.  A
+ * number with a fraction or an exponent is accepted by integer types when
+ * its value is an integer, such as 1.0 or 3e9, and has at most 19
+ * significant digits.
+ *
+ * Floating point values are correctly rounded.  A double with up to 15
+ * significant digits and a decimal exponent within +/-22, or a float with
+ * up to 7 significant digits and a decimal exponent within +/-10, is
+ * converted with one rounding step.  Other numbers are converted exactly
+ * in decimal with JSON_NUMBER_MAX_DIGITS digits, not by strtod(), so the
+ * result never depends on the C library or its locale.  Floats and doubles
+ * must use the IEEE 754 binary32 and binary64 formats.
+ *
+ * @param[in] buf  The number's characters.
+ * @param[in] length  Number of characters in the number.
+ * @param[in] type  The C type to produce.
+ * @param[out] outValue  Receives the value.  It need not be aligned.
+ *
+ * @return #JSONSuccess if the value was output;
+ * #JSONNullParameter if any pointer parameters are NULL;
+ * #JSONBadParameter if length is 0 or type is invalid;
+ * #JSONIllegalDocument if buf isn't a number of the requested kind;
+ * #JSONOutOfRange if the value is outside the range of the type.
+ */
+/* @[declare_json_numberdecode] */
+JSONStatus_t JSON_NumberDecode( const char * buf,
+                                size_t length,
+                                JSONNumberType_t type,
+                                void * outValue );
+/* @[declare_json_numberdecode] */
+
+/**
+ * @brief Decode a string value's escape sequences.
+ *
+ * buf[0..length) is a string value without its quotes, as returned by
+ * JSON_SearchConst() for a #JSONString.  Escapes are decoded while copying
+ * to @p out, \u escapes and surrogate pairs become UTF-8, and @p out is
+ * terminated with a null character.  Decoding never lengthens a string so
+ * @p out may be @p buf to decode in place, although a document decoded in
+ * place is no longer valid JSON.
+ *
+ * @param[in] buf  The string's characters.
+ * @param[in] length  Number of characters in the string.
+ * @param[out] out  Receives the decoded string and its terminator.
+ * @param[in] outLength  The size of @p out including the terminator.
+ * @param[out] outUsed  Optional, receives the decoded length without the
+ * terminator.
+ *
+ * @return #JSONSuccess if the decoded string was output;
+ * #JSONNullParameter if buf or out is NULL;
+ * #JSONBadParameter if outLength is 0;
+ * #JSONIllegalDocument if an escape is invalid;
+ * #JSONTokenTooLong if the decoded string and its terminator don't fit in
+ * outLength characters.  In both error cases @p out holds the terminated
+ * characters decoded before the error.
+ */
+/* @[declare_json_stringunescape] */
+JSONStatus_t JSON_StringUnescape( const char * buf,
+                                  size_t length,
+                                  char * out,
+                                  size_t outLength,
+                                  size_t * outUsed );
+/* @[declare_json_stringunescape] */
+
 #endif /* ifndef CORE_JSON_H_ */
@@ -27,12 +27,21 @@
 #ifndef _ini_lib_
 #define _ini_lib_
 
+#include <stddef.h>
 
 
 #define INILIB_TYPE_INT  "uint32"
 #define INILIB_TYPE_FLT  "float"
 #define INILIB_TYPE_STR  "char*"
 
+#define INILIB_TYPE_BOOL   "bool"
+#define INILIB_TYPE_INT64  "int64"
+#define INILIB_TYPE_DBL    "double"
+
+/* Array types are pointers so a DECLARE_ENUM() struct member points to INITBL's storage */
+#define INILIB_TYPE_INT_ARRAY  "INITBL_IntArray_t*"
+#define INILIB_TYPE_FLT_ARRAY  "INITBL_FltArray_t*"
+
 
 /******************************************************************************
 ** Initialization Library 
@@ -40,6 +49,7 @@
 */
 
 typedef const char * (*INILIB_GetConfigFuncPtr_t) (int ConfigParam);
+typedef size_t (*INILIB_GetOffsetFuncPtr_t) (int ConfigParam);
 
 typedef struct
 {
@@ -50,6 +60,9 @@ typedef struct
    INILIB_GetConfigFuncPtr_t  GetStr;
    INILIB_GetConfigFuncPtr_t  GetType;
 
+   INILIB_GetOffsetFuncPtr_t  GetOffset;  /* Parameter's INITBL_<TypeName>Struct member offset, NULL if none */
+   size_t                     StructSize;
+
 } INILIB_CfgEnum_t;
 
 
@@ -73,6 +86,9 @@ typedef struct
 /* expansion macro for enum to type string conversion */
 #define ENUM_TYPE_CASE(name,type) case name: return #type;
 
+/* expansion macro for enum to struct member offset conversion, see DEFINE_ENUM() */
+#define ENUM_OFFSET_CASE(name,type) case name: return offsetof(INILIB_CfgStruct_t, name);
+
 /* expansion macro for string to enum conversion */
 #define ENUM_STRCMP(name,type) if (!strcmp(str,#name)) return name;
 
@@ -91,10 +107,15 @@ typedef struct
 ** Define the access function names */
 /* - Get##TypeName##Str() & Get##TypeName##Type use int parameters instead of
 **   INITBL_##TypeName##Enum to prevent compiler warnings with callback functions 
+** - Get##TypeName##Offset() returns a parameter's offset in INITBL_##TypeName##Struct
+**   so INITBL can populate the struct without knowing its definition. The struct
+**   typedef ENUM_OFFSET_CASE() uses is local to the function so each TypeName
+**   gets its own.
 */
 #define DEFINE_ENUM(TypeName,ENUM_DEF) \
   static const char *Get##TypeName##Str(int value); \
   static const char *Get##TypeName##Type(int value); \
+  static size_t Get##TypeName##Offset(int value); \
   static const char *Get##TypeName##Str(int value) \
   { \
     switch(value) \
@@ -111,7 +132,17 @@ typedef struct
       default: return ""; /* handle input error */ \
     } \
   } \
-  static INILIB_CfgEnum_t IniCfgEnum = { CFG_ENUM_START, CFG_ENUM_END, Get##TypeName##Str, Get##TypeName##Type }; \
+  static size_t Get##TypeName##Offset(int value) \
+  { \
+    typedef INITBL_##TypeName##Struct INILIB_CfgStruct_t; \
+    switch(value) \
+    { \
+      ENUM_DEF(ENUM_OFFSET_CASE) \
+      default: return 0; /* handle input error */ \
+    } \
+  } \
+  static INILIB_CfgEnum_t IniCfgEnum = { CFG_ENUM_START, CFG_ENUM_END, Get##TypeName##Str, Get##TypeName##Type, \
+                                         Get##TypeName##Offset, sizeof(INITBL_##TypeName##Struct) }; \
   
 /*
 ** Remove this unused function to avoid compiler warnings
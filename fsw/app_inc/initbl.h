@@ -16,7 +16,10 @@
 **    Define JSON Initialization table API
 **
 **  Notes:
-**    None
+**    1. Parameters are declared with the INILIB_TYPE_* types. Array
+**       parameters are loaded from a JSON array of numbers into fixed 
+**       capacity INITBL_IntArray_t or INITBL_FltArray_t storage and boolean
+**       parameters are loaded from a JSON true or false.
 **
 **  References:
 **    1. OpenSatKit Object-based Application Developer's Guide.
@@ -44,37 +47,234 @@
 
 #define INITBL_JSON_CONFIG_OBJ_PREFIX  "config."
 
+#define INITBL_PARAM_HASH_LEN       (2*INITBL_MAX_CFG_ITEMS)  /* Parameter name perfect hash slots */
+#define INITBL_PARAM_HASH_MAX_DISP  4096                      /* Displacements tried per hash bucket */
+
+#define INITBL_LAZY_MUTEX_NAMES     16   /* Mutex names tried per task, one per lazy table construction */
+
 #define INITBL_CONFIG_DEF_ERR_EID  (INITBL_BASE_EID + 0)
 #define INITBL_CFG_PARAM_EID       (INITBL_BASE_EID + 1)
 #define INITBL_CFG_PARAM_ERR_EID   (INITBL_BASE_EID + 2)
 #define INITBL_LOAD_JSON_EID       (INITBL_BASE_EID + 3)
 #define INITBL_LOAD_JSON_ERR_EID   (INITBL_BASE_EID + 4)
+#define INITBL_PARAM_HASH_ERR_EID  (INITBL_BASE_EID + 5)
+#define INITBL_RELOAD_EID          (INITBL_BASE_EID + 6)
+#define INITBL_RELOAD_ERR_EID      (INITBL_BASE_EID + 7)
+
+/*
+** Configuration bank readers
+**
+** - Tasks other than the one that reloads a table register a reader with
+**   INITBL_RegisterReader() during app initialization. INITBL_AcquireCfg()
+**   holds the published bank so the values, strings, arrays and snapshot
+**   it retrieves aren't overwritten until the reader calls 
+**   INITBL_ReleaseCfg(). A reload is rejected while a reader holds the
+**   bank it would overwrite so readers should release the configuration
+**   at the end of each processing cycle.
+** - Acquire and release don't take a mutex, like TBLMGR's double buffered
+**   tables they rely on aligned byte stores being atomic.
+*/
+
+#define INITBL_CFG_BANKS     2
+#define INITBL_CFG_NO_BANK   INITBL_CFG_BANKS  /* Reader doesn't hold a bank */
+
+/*
+** Typed access to a table's INITBL_<TypeName>Struct snapshot, for example
+** INITBL_SNAPSHOT(&IniTbl, Config)->APP_MAIN_PERF_ID. See 
+** INITBL_GetSnapshot().
+*/
+
+#define INITBL_SNAPSHOT(IniTbl, TypeName) ((const INITBL_##TypeName##Struct*)INITBL_GetSnapshot(IniTbl))
 
 /**********************/
 /** Type Definitions **/
 /**********************/
 
-typedef struct 
+/*
+** When configuration parameters are decoded. LAZY and COMPACT only record
+** each value's location during construction and decode a parameter the 
+** first time it is retrieved. LAZY keeps the file's buffer borrowed from
+** the CJSON buffer pool. COMPACT copies the located values to the table's
+** INITBL_LazyStore_t so the buffer is returned like an EAGER table's.
+*/
+
+typedef enum
+{
+
+   INITBL_DECODE_EAGER = 0,
+   INITBL_DECODE_LAZY,
+   INITBL_DECODE_COMPACT
+
+} INITBL_Decode_t;
+
+
+/*
+** A parameter's INILIB_TYPE_* type. The constructor resolves each 
+** parameter's type string once so retrieval only compares the enumeration.
+*/
+
+typedef enum
+{
+
+   INITBL_PARAM_INT = 0,
+   INITBL_PARAM_FLT,
+   INITBL_PARAM_STR,
+   INITBL_PARAM_BOOL,
+   INITBL_PARAM_INT64,
+   INITBL_PARAM_DBL,
+   INITBL_PARAM_INT_ARRAY,
+   INITBL_PARAM_FLT_ARRAY,
+   INITBL_PARAM_TYPE_CNT
+
+} INITBL_ParamType_t;
+
+
+/*
+** Array parameter storage. The first Cnt elements of Value[] were loaded
+** from the JSON array.
+*/
+
+typedef struct
+{
+
+   uint16   Cnt;
+   uint32   Value[INITBL_MAX_CFG_ARRAY_LEN];
+
+} INITBL_IntArray_t;
+
+typedef struct
+{
+
+   uint16   Cnt;
+   float    Value[INITBL_MAX_CFG_ARRAY_LEN];
+
+} INITBL_FltArray_t;
+
+
+/*
+** A parameter's value. Only the member for the parameter's declared type
+** is used, the getters verify the type before reading it.
+*/
+
+typedef union 
 {
    
    uint32   Int;
    float    Flt;
    char     Str[INITBL_MAX_CFG_STR_LEN];
+   bool     Bool;
+   int64    Int64;
+   double   Dbl;
+   INITBL_IntArray_t  IntArray;
+   INITBL_FltArray_t  FltArray;
 
 } INITBL_CfgData_t;
 
 
+/*
+** Storage only used by lazily decoded tables, it is supplied to 
+** INITBL_LazyConstructor() so eager tables don't carry it. JsonLoc[] is
+** indexed like INITBL_Class_t's JsonParams[] and JsonValues[] is only used
+** by a compacted table.
+*/
+
+typedef struct
+{
+
+   CJSON_ObjLoc_t   JsonLoc[INITBL_MAX_CFG_ITEMS+1];
+   char             JsonValues[INITBL_MAX_LAZY_JSON_CHAR];
+
+} INITBL_LazyStore_t;
+
+
+/*
+** One copy of the decoded configuration. A table has two banks so 
+** INITBL_Reload() can load a new configuration into the unpublished bank
+** and publish it by changing the table's Cfg pointer.
+*/
+
+typedef struct 
+{
+
+   INITBL_CfgData_t  CfgData[INITBL_MAX_CFG_ITEMS+1];  /* '+1' accounts for [0] being unused */
+   volatile bool     ParamValid[INITBL_MAX_CFG_ITEMS];  /* Indexed like JsonParams[], CfgData[] entry was loaded */
+
+   volatile bool     SnapshotValid;
+   uint64      Snapshot[INITBL_MAX_CFG_ITEMS];          /* INITBL_<TypeName>Struct, 8 bytes holds any member */
+
+} INITBL_CfgBank_t;
+
+
+/*
+** Called by INITBL_Reload() for each parameter whose value changed after
+** the new configuration has been published
+*/
+typedef void (*INITBL_ParamChanged_t)(void* UserDataPtr, uint16 Param);
+
+typedef struct
+{
+
+   INITBL_ParamChanged_t  ParamChanged;
+   void                   *UserDataPtr;
+
+} INITBL_ReloadCallback_t;
+
+
+/*
+** Reload command
+*/
+
+typedef struct
+{
+
+   char    Filename[OS_MAX_PATH_LEN];  /* ASCII text string of full path and filename */
+
+} INITBL_ReloadCmdMsg_Payload_t;
+
+typedef struct
+{
+   CFE_MSG_CommandHeader_t        CmdHeader;
+   INITBL_ReloadCmdMsg_Payload_t  Payload;
+
+} INITBL_ReloadCmdMsg_t;
+#define INITBL_RELOAD_CMD_DATA_LEN  (sizeof(INITBL_ReloadCmdMsg_t) - sizeof(CFE_MSG_CommandHeader_t))
+
+
 typedef struct 
 {
  
    INILIB_CfgEnum_t  CfgEnum;
-   INITBL_CfgData_t  CfgData[INITBL_MAX_CFG_ITEMS+1];  /* '+1' accounts for [0] being unused */
+   
+   INITBL_CfgBank_t           CfgBank[INITBL_CFG_BANKS];
+   INITBL_CfgBank_t *volatile Cfg;        /* Published bank, read once per retrieval */
+   INITBL_CfgBank_t           *LoadBank;  /* Bank JsonParams[] decode into */
+   uint32                     ReloadCnt;
+   
+   uint8           ReaderCnt;
+   volatile uint8  ReaderBank[INITBL_MAX_CFG_READERS];  /* CfgBank[] index held by each reader */
+   
+   uint16                   ReloadCallbackCnt;
+   INITBL_ReloadCallback_t  ReloadCallback[INITBL_MAX_RELOAD_CALLBACKS];
    
    size_t      JsonParamCnt;
    CJSON_Obj_t JsonParams[INITBL_MAX_CFG_ITEMS+1];       /* Indexed via cfg param; '+1' accounts for [0] being ununsed */
+   uint8       ParamType[INITBL_MAX_CFG_ITEMS+1];        /* Indexed like JsonParams[], INITBL_ParamType_t */
+
+   INITBL_Decode_t  Decode;
+   osal_id_t        LazyMutex;                          /* Serializes a lazy table's decoding */
+   INITBL_LazyStore_t *Lazy;                            /* Lazy table's storage, NULL for an eager table */
+   const char       *LazyJson;                          /* Lazy->JsonValues[] or the kept JsonBuf, JsonLoc indexes this */
+   CJSON_ObjLoc_t   *JsonLoc;                           /* Lazy->JsonLoc[] or INITBL_LayeredConstructor()'s while it loads */
+
+   uint32      ParamHashDisp[INITBL_MAX_CFG_ITEMS];     /* Name hash seed for each first level bucket */
+   uint16      ParamHash[INITBL_PARAM_HASH_LEN];        /* Param in each second level slot, 0 if empty */
+
+   uint8       JsonLayer[INITBL_MAX_CFG_ITEMS+1];       /* Indexed like JsonParams[], INITBL_LayeredConstructor() file index+1 that defined the parameter */
+   uint8       LoadLayer;                               /* JsonLayer[] value of the file being loaded */
 
    size_t      JsonFileLen;
-   char        JsonBuf[INITBL_MAX_JSON_FILE_CHAR];   
+   size_t      JsonRetainedLen;                         /* LazyJson characters used by a lazy table */
+   char        *JsonBuf;                                /* Borrowed from the CJSON buffer pool and kept by an uncompacted lazy table */
 
 } INITBL_Class_t;
  
@@ -87,12 +287,111 @@ typedef struct
 **    2. Reads, validates, and processes the JSON file. If construction is
 **       successful then the query functions below can be used using the
 **       "CFG_" parameters defined in app_cfg.h.
+**    3. The file is read into a buffer borrowed from the CJSON buffer pool
+**       that is returned when construction completes.
 **
 */
 bool INITBL_Constructor(INITBL_Class_t *IniTbl, const char *IniFile,
                         INILIB_CfgEnum_t *CfgEnum);
 
 
+/******************************************************************************
+** Function: INITBL_LazyConstructor
+**
+** Notes:
+**    1. Same as INITBL_Constructor() except parameters are decoded the first
+**       time they are retrieved. Construction validates the file and 
+**       verifies every parameter is defined in one pass but a parameter 
+**       whose value can't be decoded is only reported when it is retrieved.
+**    2. LazyStore holds the values' locations and must exist for the 
+**       table's life. If Compact is true the parameters' JSON values are 
+**       copied to LazyStore so they must fit in INITBL_MAX_LAZY_JSON_CHAR 
+**       characters, and the file's buffer is returned to the CJSON buffer
+**       pool when construction completes. Otherwise the table keeps the
+**       buffer, and one of the pool's CJSON_BUF_POOL_MAX_BUFS buffers, for
+**       its life.
+**    3. Any task can retrieve parameters. The first retrieval of a 
+**       parameter or snapshot decodes it while holding the table's mutex,
+**       later retrievals don't take the mutex.
+**
+*/
+bool INITBL_LazyConstructor(INITBL_Class_t *IniTbl, const char *IniFile,
+                            INILIB_CfgEnum_t *CfgEnum, INITBL_LazyStore_t *LazyStore,
+                            bool Compact);
+
+
+/******************************************************************************
+** Function: INITBL_LayeredConstructor
+**
+** Notes:
+**    1. Same as INITBL_Constructor() except the configuration is merged 
+**       from FileCnt files. IniTblFile[0] has the lowest priority, for 
+**       example mission defaults, and each following file overrides the 
+**       parameters it defines, for example platform and then instance 
+**       values.
+**    2. Every file must be valid JSON but a file only needs to define the
+**       parameters it overrides. Each parameter must be defined by at least
+**       one file.
+**    3. Parameters are decoded into CfgData[] so retrieval is the same as 
+**       an INITBL_Constructor() table.
+**
+*/
+bool INITBL_LayeredConstructor(INITBL_Class_t *IniTbl, const char *IniFile[], uint16 FileCnt,
+                               INILIB_CfgEnum_t *CfgEnum);
+
+
+/******************************************************************************
+** Function: INITBL_AcquireCfg
+**
+** Notes:
+**    1. Holds the published configuration bank for ReaderId until it calls
+**       INITBL_ReleaseCfg(). Acquiring a configuration that the reader 
+**       already holds keeps the bank that is held.
+**    2. Parameters are always retrieved from the published bank so a 
+**       reload while the bank is held changes the retrieved values, the 
+**       hold keeps previously retrieved pointers valid. Use the held 
+**       INITBL_GetSnapshot() to read several parameters from one bank.
+**    3. Returns false if ReaderId wasn't registered.
+**    4. Lock free so it can be called from any task each processing cycle.
+**
+*/
+bool INITBL_AcquireCfg(INITBL_Class_t *IniTbl, uint8 ReaderId);
+
+
+/******************************************************************************
+** Function: INITBL_GetBoolConfig
+**
+** Notes:
+**    1. Same as INITBL_GetIntConfig() for an INILIB_TYPE_BOOL parameter 
+**       that is defined with a JSON true or false. False is returned if
+**       the parameter is out of range or of the wrong type.
+**
+*/
+bool INITBL_GetBoolConfig(const INITBL_Class_t *IniTbl, uint16 Param);
+
+
+/******************************************************************************
+** Function: INITBL_GetDblConfig
+**
+** Notes:
+**    1. Same as INITBL_GetFltConfig() for an INILIB_TYPE_DBL parameter.
+**
+*/
+double INITBL_GetDblConfig(const INITBL_Class_t *IniTbl, uint16 Param);
+
+
+/******************************************************************************
+** Function: INITBL_GetFltArrayConfig
+**
+** Notes:
+**    1. Returns an INILIB_TYPE_FLT_ARRAY parameter's elements or NULL, with
+**       an event message, if the parameter is out of range or of the wrong
+**       type. The array points to the table's storage, see INITBL_Reload().
+**
+*/
+const INITBL_FltArray_t* INITBL_GetFltArrayConfig(const INITBL_Class_t *IniTbl, uint16 Param);
+
+
 /******************************************************************************
 ** Function: INITBL_GetFltConfig
 **
@@ -110,6 +409,27 @@ bool INITBL_Constructor(INITBL_Class_t *IniTbl, const char *IniFile,
 float INITBL_GetFltConfig(const INITBL_Class_t *IniTbl, uint16 Param);
 
 
+/******************************************************************************
+** Function: INITBL_GetInt64Config
+**
+** Notes:
+**    1. Same as INITBL_GetIntConfig() for an INILIB_TYPE_INT64 parameter.
+**
+*/
+int64 INITBL_GetInt64Config(const INITBL_Class_t *IniTbl, uint16 Param);
+
+
+/******************************************************************************
+** Function: INITBL_GetIntArrayConfig
+**
+** Notes:
+**    1. Same as INITBL_GetFltArrayConfig() for an INILIB_TYPE_INT_ARRAY 
+**       parameter.
+**
+*/
+const INITBL_IntArray_t* INITBL_GetIntArrayConfig(const INITBL_Class_t *IniTbl, uint16 Param);
+
+
 /******************************************************************************
 ** Function: INITBL_GetIntConfig
 **
@@ -127,6 +447,40 @@ float INITBL_GetFltConfig(const INITBL_Class_t *IniTbl, uint16 Param);
 uint32 INITBL_GetIntConfig(const INITBL_Class_t *IniTbl, uint16 Param);
 
 
+/******************************************************************************
+** Function: INITBL_GetParam
+**
+** Notes:
+**    1. Returns the "CFG_" parameter named Name (without the "config." 
+**       prefix) or 0 if the table doesn't define the parameter. 
+**    2. Names are resolved with a perfect hash built by the constructor so
+**       a lookup costs two name hashes and one string compare.
+**
+*/
+uint16 INITBL_GetParam(const INITBL_Class_t *IniTbl, const char *Name);
+
+
+/******************************************************************************
+** Function: INITBL_GetSnapshot
+**
+** Notes:
+**    1. Returns the INITBL_<TypeName>Struct generated by DECLARE_ENUM() with
+**       every configuration parameter's value. Every parameter is validated
+**       once when the snapshot is populated so reading a field is a plain 
+**       load without the checks and events of the INITBL_Get*Config() 
+**       functions. Use INITBL_SNAPSHOT() for a typed pointer.
+**    2. String and array members point to the table's storage so the snapshot is
+**       valid for the life of the table unless the table is reloaded, see
+**       INITBL_Reload().
+**    3. Eager tables populate the snapshot during construction and lazy 
+**       tables populate it on the first call. NULL is returned and an event
+**       message is sent if construction failed, the CfgEnum wasn't defined
+**       with DEFINE_ENUM() or a parameter can't be decoded.
+**
+*/
+const void* INITBL_GetSnapshot(const INITBL_Class_t *IniTbl);
+
+
 /******************************************************************************
 ** Function: INITBL_GetStrConfig
 **
@@ -144,4 +498,84 @@ uint32 INITBL_GetIntConfig(const INITBL_Class_t *IniTbl, uint16 Param);
 const char* INITBL_GetStrConfig(const INITBL_Class_t *IniTbl, uint16 Param);
 
 
+/******************************************************************************
+** Function: INITBL_RegisterReader
+**
+** Notes:
+**    1. Registers a reader of the table's configuration. Must be called 
+**       during app initialization after the table is constructed.
+**    2. Returns the reader ID used with INITBL_AcquireCfg() and 
+**       INITBL_ReleaseCfg() or INITBL_MAX_CFG_READERS if no reader IDs
+**       are left.
+**
+*/
+uint8 INITBL_RegisterReader(INITBL_Class_t *IniTbl);
+
+
+/******************************************************************************
+** Function: INITBL_RegisterReloadCallback
+**
+** Notes:
+**    1. ParamChanged is called with UserDataPtr for each parameter that 
+**       INITBL_Reload() changes, after the new configuration is published,
+**       so callers can re-derive values computed from parameters.
+**    2. Returns false if INITBL_MAX_RELOAD_CALLBACKS are registered.
+**
+*/
+bool INITBL_RegisterReloadCallback(INITBL_Class_t *IniTbl, INITBL_ParamChanged_t ParamChanged,
+                                   void *UserDataPtr);
+
+
+/******************************************************************************
+** Function: INITBL_ReleaseCfg
+**
+** Notes:
+**    1. Releases the bank held by INITBL_AcquireCfg(). Pointers retrieved
+**       while it was held must not be used after it is released.
+**
+*/
+void INITBL_ReleaseCfg(INITBL_Class_t *IniTbl, uint8 ReaderId);
+
+
+/******************************************************************************
+** Function: INITBL_Reload
+**
+** Notes:
+**    1. Loads IniFile into the unpublished configuration bank and, only if
+**       the file is valid and defines every parameter, publishes it with a 
+**       single pointer store. Retrieval functions and snapshots read the 
+**       published bank without a lock so readers never see a partially 
+**       loaded configuration. A failed reload leaves the current 
+**       configuration unchanged.
+**    2. String pointers and snapshots retrieved before a reload stay valid 
+**       until the following reload overwrites their bank. The reload is 
+**       rejected while a reader holds that bank, see INITBL_AcquireCfg(),
+**       so readers in other tasks should hold the configuration while 
+**       they use it and retrieve pointers again after a reload.
+**    3. Each INITBL_Get*Config() call returns a value from one bank, but 
+**       consecutive calls can return values from both banks when a reload
+**       publishes between them. Readers that need a consistent set of 
+**       parameters use the snapshot returned by one INITBL_GetSnapshot() 
+**       call, which is entirely in one bank.
+**    4. Only tables with eagerly decoded parameters can be reloaded because
+**       a lazy table's values are decoded from the values it kept.
+**    5. Must be called by one task at a time, typically the app's command
+**       task via INITBL_ReloadCmd().
+**
+*/
+bool INITBL_Reload(INITBL_Class_t *IniTbl, const char *IniFile);
+
+
+/******************************************************************************
+** Function: INITBL_ReloadCmd
+**
+** Notes:
+**    1. This function must comply with the CMDMGR_CmdFuncPtr_t definition
+**       and ObjDataPtr must be an INITBL_Class_t. Apps register it with 
+**       their own function code.
+**
+*/
+bool INITBL_ReloadCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
 #endif /* _ini_tbl_ */
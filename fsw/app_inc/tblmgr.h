@@ -51,6 +51,9 @@
 #define TBLMGR_DUMP_STUB_ERR_EID     (TBLMGR_BASE_EID + 4)
 #define TBLMGR_LOAD_SUCCESS_EID      (TBLMGR_BASE_EID + 5)
 #define TBLMGR_DUMP_SUCCESS_EID      (TBLMGR_BASE_EID + 6)
+#define TBLMGR_BIN_TBL_ERR_EID       (TBLMGR_BASE_EID + 7)
+#define TBLMGR_BIN_CACHE_EID         (TBLMGR_BASE_EID + 8)
+#define TBLMGR_DBL_BUF_ERR_EID       (TBLMGR_BASE_EID + 9)
 
 /*
 ** Table status
@@ -81,6 +84,56 @@
 
 #define TBLMGR_LOAD_TBL_REPLACE    0   /* Replace the entire table. */
 #define TBLMGR_LOAD_TBL_UPDATE     1   /* Update individual entries */
+#define TBLMGR_LOAD_TBL_BINARY     2   /* Replace the entire table from a binary table file, see TBLMGR_LoadBinTbl() */
+
+/*
+** Binary table container
+**
+** - A binary table file is a TBLMGR_BIN_HDR_LEN byte header followed by
+**   DataLen bytes of table data.
+** - The header is stored big endian on every processor. The table data is
+**   a memory image of the app's table structure so it can only be loaded
+**   by a processor with the byte order recorded in Flags, and the app 
+**   identifies the structure's layout with SchemaId and SchemaVer.
+** - Crc is the CRC_32c() of the table data.
+** - A binary table that caches a decoded source file has the 
+**   TBLMGR_BIN_FLAG_SOURCE_CRC flag set and SourceCrc is the CRC_32c() 
+**   of the source file. See TBLMGR_LoadCachedTbl().
+** - Version 1 files have a TBLMGR_BIN_V1_HDR_LEN byte header without 
+**   SourceCrc. They're still loaded but never match a source file so a
+**   version 1 cache is rewritten.
+*/
+
+#define TBLMGR_BIN_MAGIC               0x4F534B42  /* "OSKB" */
+#define TBLMGR_BIN_FORMAT_VER          2
+#define TBLMGR_BIN_HDR_LEN             28          /* Bytes in a stored TBLMGR_BinHdr_t */
+#define TBLMGR_BIN_V1_FORMAT_VER       1
+#define TBLMGR_BIN_V1_HDR_LEN          24          /* Version 1 header, ends before SourceCrc */
+#define TBLMGR_BIN_FLAG_LITTLE_ENDIAN  0x0001      /* Table data byte order */
+#define TBLMGR_BIN_FLAG_SOURCE_CRC     0x0002      /* SourceCrc is defined */
+#define TBLMGR_BIN_CACHE_EXT           ".bin"      /* Appended to a source filename to name its cache */
+
+/*
+** Double buffered tables
+**
+** - TBLMGR_RegisterDblBufTbl() registers a table with two app supplied 
+**   copies. The active copy is read by the app and a load is decoded into
+**   the other copy, see TBLMGR_GetLoadTbl(). A successful load makes the
+**   loaded copy active with a single byte store so readers never see a
+**   partially loaded table and a failed load leaves the active copy
+**   unchanged.
+** - Readers are registered with TBLMGR_RegisterTblReader() during app
+**   initialization. TBLMGR_AcquireTbl() returns a pointer to the active
+**   copy that remains valid until the reader calls TBLMGR_ReleaseTbl(). 
+**   A load is rejected while a reader holds the copy it would overwrite
+**   so readers should release a table at the end of each processing cycle.
+** - Acquire and release don't take a mutex. They rely on aligned byte 
+**   stores being atomic and seen in program order by the loading task, 
+**   which holds for the single core processors the apps run on.
+*/
+
+#define TBLMGR_DBL_BUF_COPIES    2
+#define TBLMGR_DBL_BUF_NO_COPY   TBLMGR_DBL_BUF_COPIES  /* Reader doesn't hold a copy */
 
 /**********************/
 /** Type Definitions **/
@@ -123,10 +176,31 @@ typedef struct
 #define TBLMGR_DUMP_TBL_CMD_DATA_LEN  (sizeof(TBLMGR_DumpTblCmdMsg_t) - sizeof(CFE_MSG_CommandHeader_t))
 
 
+/*
+** Binary table header, see TBLMGR_BIN_* definitions 
+*/
+
+typedef struct
+{
+
+   uint32  Magic;
+   uint16  FormatVer;
+   uint16  Flags;
+   uint32  SchemaId;    /* Identifies the app's table structure */
+   uint32  SchemaVer;   /* Changed by the app whenever the table structure changes */
+   uint32  DataLen;
+   uint32  Crc;
+   uint32  SourceCrc;
+
+} TBLMGR_BinHdr_t;
+
+
 /* 
 ** Table Class
 ** - ID is assigned by TBLMGR
 ** - Application's table processing object supply the load/dump functions
+** - JSON dump functions should use a CJSON_Writer_t so a dump takes a few
+**   buffered file writes rather than a write per line
 */
 
 typedef struct TBLMGR_Tbl TBLMGR_Tbl_t;
@@ -134,6 +208,9 @@ typedef struct TBLMGR_Tbl TBLMGR_Tbl_t;
 typedef bool (*TBLMGR_LoadTblFuncPtr_t) (TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename);
 typedef bool (*TBLMGR_DumpTblFuncPtr_t) (TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename);
 
+/* Decodes a source table file, see TBLMGR_LoadCachedTbl() */
+typedef bool (*TBLMGR_ParseTblFuncPtr_t) (const char* Filename, void* UserDataPtr);
+
 struct TBLMGR_Tbl
 {
   
@@ -146,6 +223,17 @@ struct TBLMGR_Tbl
    TBLMGR_LoadTblFuncPtr_t  LoadFuncPtr;
    TBLMGR_DumpTblFuncPtr_t  DumpFuncPtr;
 
+   /* Double buffered tables, see TBLMGR_RegisterDblBufTbl() */
+   
+   bool            DblBuf;
+   uint8           ReaderCnt;
+   uint8           LoadCopy;
+   volatile uint8  ActiveCopy;
+   volatile uint8  ReaderCopy[TBLMGR_MAX_TBL_READERS];
+   uint32          CommitCnt;
+   size_t          DataLen;
+   void*           Copy[TBLMGR_DBL_BUF_COPIES];
+
 };
 
 /* 
@@ -166,6 +254,21 @@ typedef struct
 /** Exported Functions **/
 /************************/
 
+/******************************************************************************
+** Function: TBLMGR_AcquireTbl
+**
+** Notes:
+**    1. Returns a pointer to the active copy of a double buffered table
+**       that isn't modified until ReaderId calls TBLMGR_ReleaseTbl(). 
+**       Acquiring a table that the reader already holds returns the copy
+**       that is held.
+**    2. Returns NULL if TblId isn't a double buffered table or ReaderId
+**       wasn't registered for it.
+**    3. Lock free so it can be called from any task each processing cycle.
+*/
+const void* TBLMGR_AcquireTbl(TBLMGR_Class_t* TblMgr, uint8 TblId, uint8 ReaderId);
+
+
 /******************************************************************************
 ** Function: TBLMGR_Constructor
 **
@@ -176,6 +279,19 @@ typedef struct
 void TBLMGR_Constructor(TBLMGR_Class_t* TblMgr);
 
 
+/******************************************************************************
+** Function: TBLMGR_DumpBinTbl
+**
+** Notes:
+**  1. Writes TblData to Filename as a binary table that can be loaded by 
+**     TBLMGR_LoadBinTbl(). A JSON table can be converted to a binary table
+**     by loading it and then dumping the table with this function.
+**  2. Returns true if the file was written.
+*/
+bool TBLMGR_DumpBinTbl(const char* Filename, uint32 SchemaId, uint32 SchemaVer,
+                       const void* TblData, size_t TblDataLen);
+
+
 /******************************************************************************
 ** Function: TBLMGR_GetLastTblStatus
 **
@@ -186,6 +302,19 @@ void TBLMGR_Constructor(TBLMGR_Class_t* TblMgr);
 const TBLMGR_Tbl_t* TBLMGR_GetLastTblStatus(TBLMGR_Class_t* TblMgr);
 
 
+/******************************************************************************
+** Function: TBLMGR_GetLoadTbl
+**
+** Notes:
+**    1. Returns the copy of a double buffered table that the table's 
+**       LoadFuncPtr function must load. It holds the contents of the
+**       active copy when the load function is called so update loads
+**       only need to modify the loaded entries.
+**    2. Returns NULL if Tbl isn't double buffered.
+*/
+void* TBLMGR_GetLoadTbl(const TBLMGR_Tbl_t* Tbl);
+
+
 /******************************************************************************
 ** Function: TBLMGR_GetTblStatus
 **
@@ -215,6 +344,44 @@ uint8 TBLMGR_RegisterTblWithDef(TBLMGR_Class_t* TblMgr, TBLMGR_LoadTblFuncPtr_t
                                 TBLMGR_DumpTblFuncPtr_t DumpFuncPtr, const char* TblFilename); 
 
 
+/******************************************************************************
+** Function: TBLMGR_RegisterDblBufTbl
+**
+** Notes:
+**    1. Registers a double buffered table. TblCopyA and TblCopyB are two
+**       TblLen byte copies of the app's table and TblCopyA is the initial
+**       active copy.
+**    2. If TblFilename is not NULL the default table is loaded.
+**    3. Returns the table ID or TBLMGR_MAX_TBL_PER_APP if no IDs left.
+*/
+uint8 TBLMGR_RegisterDblBufTbl(TBLMGR_Class_t* TblMgr, TBLMGR_LoadTblFuncPtr_t LoadFuncPtr, 
+                               TBLMGR_DumpTblFuncPtr_t DumpFuncPtr, void* TblCopyA, 
+                               void* TblCopyB, size_t TblLen, const char* TblFilename);
+
+
+/******************************************************************************
+** Function: TBLMGR_RegisterTblReader
+**
+** Notes:
+**    1. Registers a reader of a double buffered table. Must be called 
+**       during app initialization before any reader acquires the table.
+**    2. Returns the reader ID used with TBLMGR_AcquireTbl() and 
+**       TBLMGR_ReleaseTbl() or TBLMGR_MAX_TBL_READERS if TblId isn't a
+**       double buffered table or no reader IDs are left.
+*/
+uint8 TBLMGR_RegisterTblReader(TBLMGR_Class_t* TblMgr, uint8 TblId);
+
+
+/******************************************************************************
+** Function: TBLMGR_ReleaseTbl
+**
+** Notes:
+**    1. Releases the copy returned by TBLMGR_AcquireTbl(). The pointer
+**       must not be used after the table is released.
+*/
+void TBLMGR_ReleaseTbl(TBLMGR_Class_t* TblMgr, uint8 TblId, uint8 ReaderId);
+
+
 /******************************************************************************
 ** Function: TBLMGR_ResetStatus
 **
@@ -229,11 +396,52 @@ void TBLMGR_ResetStatus(TBLMGR_Class_t* TblMgr);
 **  1. This function must comply with the CMDMGR_CmdFuncPtr_t definition
 **  2. It calls the TBLMGR_LoadTblFuncPtr function that the user provided
 **     during registration 
+**  3. A double buffered table's loaded copy becomes the active copy when
+**     the load function returns true.
 ** 
 */
 bool TBLMGR_LoadTblCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
 
 
+/******************************************************************************
+** Function: TBLMGR_LoadBinTbl
+**
+** Note:
+**  1. Intended to be called by an app's load table function for a
+**     TBLMGR_LOAD_TBL_BINARY load. The header is validated against the
+**     caller's SchemaId, SchemaVer, TblDataLen and the processor's byte
+**     order, the table data is read directly into TblData, and then the
+**     CRC is verified. No parsing is performed.
+**  2. TblData is modified even when the load fails so it should be a
+**     working copy of the table.
+**  3. Returns true if TblData was loaded with a valid binary table.
+** 
+*/
+bool TBLMGR_LoadBinTbl(const char* Filename, uint32 SchemaId, uint32 SchemaVer,
+                       void* TblData, size_t TblDataLen);
+
+
+/******************************************************************************
+** Function: TBLMGR_LoadCachedTbl
+**
+** Note:
+**  1. Loads TblData from Filename's binary cache, Filename plus 
+**     TBLMGR_BIN_CACHE_EXT, when the cache was created from a file with the
+**     same CRC_32c() as Filename and the same SchemaId and SchemaVer. 
+**     Otherwise ParseTblFunc decodes Filename into TblData and, if it 
+**     succeeds, the cache is rewritten from TblData.
+**  2. Intended for replace loads of tables that don't contain pointers.
+**     ParseTblFunc must define all of TblData because a rejected cache
+**     may have been partially read into TblData.
+**  3. Returns true if TblData was loaded from the cache or ParseTblFunc
+**     returned true.
+** 
+*/
+bool TBLMGR_LoadCachedTbl(const char* Filename, uint32 SchemaId, uint32 SchemaVer,
+                          void* TblData, size_t TblDataLen,
+                          TBLMGR_ParseTblFuncPtr_t ParseTblFunc, void* UserDataPtr);
+
+
 /******************************************************************************
 ** Function: TBLMGR_LoadTypeStr
 **
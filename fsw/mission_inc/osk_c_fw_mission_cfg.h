@@ -29,6 +29,24 @@
 #ifndef _osk_c_fw_mission_cfg_h_
 #define _osk_c_fw_mission_cfg_h_
 
+/******************************************************************************
+** JSON (CJSON)
+*/
+
+/*
+** Performance log IDs bracketing JSON file parsing and the apps' load
+** callbacks. Performance IDs are allocated mission wide so these defaults
+** must be changed if they're assigned to another app. A mission that keeps
+** its IDs in one header can define them there instead. cjson.c checks 
+** they're distinct and below CFE_MISSION_ES_PERF_MAX_IDS.
+*/
+#ifndef CJSON_PARSE_PERF_ID
+#define CJSON_PARSE_PERF_ID    120
+#endif
+#ifndef CJSON_LOAD_PERF_ID
+#define CJSON_LOAD_PERF_ID     121
+#endif
+
 
 #endif /* _osk_c_fw_mission_cfg_h_ */
 
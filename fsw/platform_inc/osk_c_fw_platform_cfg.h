@@ -59,13 +59,42 @@
 
 #define  INITBL_MAX_CFG_ITEMS         32   /* Max number of JSON ini file config items */
 #define  INITBL_MAX_CFG_STR_LEN       64   /* This is INITTBL's storage max. A config parameter such as a filename may have more restrictive length constraints */ 
+#define  INITBL_MAX_CFG_ARRAY_LEN     16   /* Max elements in an array config item */
 #define  INITBL_MAX_JSON_FILE_CHAR  8192   /* Max number of JSON file characters       */
+#define  INITBL_MAX_LAYERS             4   /* Max files merged by INITBL_LayeredConstructor() */
+#define  INITBL_MAX_LAZY_JSON_CHAR  1024   /* Max JSON value characters kept by a compacted INITBL_LazyConstructor() table */
+#define  INITBL_MAX_RELOAD_CALLBACKS   4   /* Max INITBL_RegisterReloadCallback() callbacks per table */
+#define  INITBL_MAX_CFG_READERS        4   /* Max INITBL_RegisterReader() readers per table */
+
+/******************************************************************************
+** coreJSON Wrapper (CJSON)
+*/
+
+#define CJSON_MAX_STAGED_OBJ    64   /* Max objects loaded by CJSON_ProcessFileObjArray()'s single traversal */
+#define CJSON_STREAM_CHUNK_LEN 512   /* Number of file characters read per CJSON_ProcessFileStream() read */
+#define CJSON_MAX_SCHEMA_FIELDS 32   /* Max fields in a CJSON_Schema_t decode plan */
+
+/*
+** Shared JSON file buffer pool. CJSON_ProcessFile*() borrows a buffer sized
+** to the file when the caller doesn't supply one so apps don't need their
+** own file sized buffers. 
+*/
+#define CJSON_BUF_POOL_CHAR          32768   /* Characters shared by all borrowed buffers */
+#define CJSON_BUF_POOL_MAX_BUF_CHAR  16384   /* Ceiling for one borrowed buffer */
+#define CJSON_BUF_POOL_MAX_BUFS          8   /* Max buffers borrowed at once */
+#define CJSON_BUF_POOL_TIMEOUT        2000   /* Milliseconds CJSON_ProcessFile*() waits for a buffer */
+#define CJSON_BUF_POOL_POLL_MS         100   /* Max milliseconds between a waiting task's attempts */
+
+/*
+** CJSON's performance log IDs are mission configuration, see osk_c_fw_mission_cfg.h
+*/
 
 /******************************************************************************
 ** Table Manager (TBLMGR)
 */
 
 #define TBLMGR_MAX_TBL_PER_APP  5
+#define TBLMGR_MAX_TBL_READERS  4   /* Max TBLMGR_RegisterTblReader() readers per double buffered table */
 
 
 /******************************************************************************
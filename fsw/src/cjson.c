@@ -28,6 +28,8 @@
 ** Include Files:
 */
 
+#include <float.h>
+#include <stdio.h>
 #include <string.h>
 #include "cjson.h"
 
@@ -38,6 +40,25 @@
 
 #define PRINT_BUF_SEGMENT_BYTES 100   /* Number of bytes in each OS_printf() call */ 
 
+#define QUERY_INDEX_STR_LEN      12   /* "[4294967295]" without a string terminator */
+
+#define OBJ_ARRAY_HASH_LEN      (2*CJSON_MAX_STAGED_OBJ)   /* CJSON_LoadObjArray() query key buckets */
+#define OBJ_ARRAY_PREFIX_BITS   (8*CJSON_MAX_STAGED_OBJ)   /* CJSON_LoadObjArray() query prefix filter bits */
+#define PATH_HASH_SEED           0x811C9DC5U   /* FNV-1a offset basis */
+#define PATH_HASH_PRIME          0x01000193U
+
+#define WRITER_NUM_STR_LEN       32   /* Holds any "%.17g" double or a signed 64-bit integer */
+#define WRITER_MAX_EXACT_INT     9007199254740992.0   /* 2^53, doubles are integers above it */
+
+#if (CJSON_PARSE_PERF_ID == CJSON_LOAD_PERF_ID)
+   #error CJSON_PARSE_PERF_ID and CJSON_LOAD_PERF_ID must be different performance IDs
+#endif
+#ifdef CFE_MISSION_ES_PERF_MAX_IDS
+   #if (CJSON_PARSE_PERF_ID >= CFE_MISSION_ES_PERF_MAX_IDS) || (CJSON_LOAD_PERF_ID >= CFE_MISSION_ES_PERF_MAX_IDS)
+      #error CJSON performance IDs must be less than CFE_MISSION_ES_PERF_MAX_IDS
+   #endif
+#endif
+
 
 /**********************/
 /** Type Definitions **/
@@ -52,21 +73,199 @@ typedef enum
 } OBJ_Necessity_t;
 
 
+/*
+** Single pass object array load state. Path holds the query form (e.g.
+** "config.APP_NAME" or "entry[3].mid") of the JSON value currently being 
+** visited so it can be compared directly against a query key. Obj[] holds
+** at most CJSON_MAX_STAGED_OBJ objects whose query keys are hashed into 
+** Bucket[] and chained through Next[], so a value is only compared with 
+** the keys that have its path's hash. Prefix[] has a bit set for the hash
+** of each key's path to a nested value so only collections that can 
+** contain a key are traversed. Found[] records the objects whose value was
+** found, whether or not it could be decoded.
+*/
+typedef struct
+{
+
+   CJSON_Obj_t  *Obj;
+   size_t       ObjCnt;
+   size_t       ObjPendingCnt;
+   size_t       ObjLoadCnt;
+   
+   const char   *Buf;
+   size_t       BufLen;
+
+   char         Path[CJSON_MAX_KEY_LEN+1];
+
+   uint16       Bucket[OBJ_ARRAY_HASH_LEN];   /* Obj[] index+1 of the bucket's first object, 0 if empty */
+   uint16       Next[CJSON_MAX_STAGED_OBJ];   /* Obj[] index+1 of the bucket's next object, 0 if last */
+   uint32       Prefix[(OBJ_ARRAY_PREFIX_BITS+31)/32];
+   bool         Found[CJSON_MAX_STAGED_OBJ];
+
+} ObjArrayLoad_t;
+
+
+/*
+** Fused validate and load state. Each object's compiled query is matched
+** against the values reported by JSON_ValidateVisit(). MatchDepth is the
+** number of query parts matched by the ancestors of the value currently
+** being visited and Value/ValueLen stage the matched value until the
+** document is known to be valid. Element is the array index matched by a
+** JSON_QUERY_ANY_INDEX query part.
+*/
+typedef struct
+{
+
+   uint32       Value;
+   uint32       ValueLen;
+   uint32       Element;
+   JSONTypes_t  Type;
+   uint16       MatchDepth;
+   bool         Staged;
+
+} ObjStage_t;
+
+typedef struct
+{
+
+   CJSON_Obj_t  *Obj;
+   size_t       ObjCnt;
+   ObjStage_t   Stage[CJSON_MAX_STAGED_OBJ];
+
+} ObjArrayFused_t;
+
+
+/*
+** Schema load state. Stage[i] is CJSON_Schema_t Entry[i]'s match state and
+** Staged records that a non-array field was loaded or that a "[*]" field's
+** array overflow was reported.
+*/
+typedef struct
+{
+
+   CJSON_Schema_t  *Schema;
+   uint8           *Tbl;
+   ObjStage_t      Stage[CJSON_MAX_SCHEMA_FIELDS];
+
+} SchemaLoad_t;
+
+/*
+** Search cursor used by the CJSON_LoadObj() calls a task makes from its 
+** CJSON_ProcessFile*() callback so loops over indexed query keys don't 
+** rewalk the document for every element. A task claims the cursor for the 
+** duration of its callback and only the claiming task uses it, the mutex
+** only guards the claim.
+*/
+
+typedef struct
+{
+
+   bool               Created;
+   bool               Claimed;
+   osal_id_t          Mutex;
+   uint32             OwnerTaskIndex;   /* CFE_ES_TaskID_ToIndex() of the claiming task */
+   const char         *JsonBuf;         /* Buffer loaded by the claiming task's callback */
+   JSONCursor_t       JsonCursor;
+
+} Cursor_t;
+
+/*
+** Shared JSON file buffer pool. Buffers are carved first fit from Arena and
+** Block[] records the borrowed buffers. The mutex guards Block[] and the
+** Released semaphore is flushed to wake tasks waiting for space. FileLoad
+** marks a buffer ProcessFile() borrowed for TaskIndex's callback, see 
+** CJSON_GetFileBuf().
+*/
+
+typedef struct
+{
+
+   bool    InUse;
+   bool    FileLoad;
+   uint32  Offset;      /* Arena index of the buffer */
+   uint32  Len;
+   uint32  TaskIndex;   /* CFE_ES_TaskID_ToIndex() of the FileLoad task */
+
+} BufBlock_t;
+
+typedef struct
+{
+
+   bool        Created;
+   osal_id_t   Mutex;
+   osal_id_t   Released;
+   BufBlock_t  Block[CJSON_BUF_POOL_MAX_BUFS];
+   uint64      Arena[(CJSON_BUF_POOL_CHAR+sizeof(uint64)-1)/sizeof(uint64)];   /* uint64 aligns each buffer */
+
+} BufPool_t;
+
+
 /************************************/
 /** Local File Function Prototypes **/
 /************************************/
 
-static bool LoadObj(CJSON_Obj_t* Obj, const char* Buf, size_t BufLen, OBJ_Necessity_t Necessity);
+static char* AllocBuf(size_t BufLen);
+static bool CallerTaskIndex(uint32* TaskIndex);
+static bool ClaimCursor(const char* JsonBuf);
+static bool CompileQuery(CJSON_Query_t* Query);
+static void CountFile(size_t FileLen, bool Loaded);
+static bool DecodeArray(CJSON_Obj_t* Obj, const char* Value, size_t ValueLen, JSONTypes_t ValueType);
+static bool DecodeNumber(void* TblData, size_t TblDataLen, JSONNumberType_t NumType, const char* Name,
+                         const char* Value, size_t ValueLen);
+static bool DecodeString(void* TblData, size_t TblDataLen, CJSON_StrMode_t StrMode, const char* Name,
+                         const char* Value, size_t ValueLen);
+static bool DecodeValue(void* TblData, size_t TblDataLen, JSONTypes_t TblType, JSONNumberType_t NumType,
+                        CJSON_StrMode_t StrMode, const char* Name, const char* Value, size_t ValueLen,
+                        JSONTypes_t ValueType);
+static void ExpandQuery(const CJSON_Query_t* Query, JSONQuery_t* Compiled);
+static void ExpandQueryPart(const CJSON_QueryPart_t* QueryPart, JSONQueryPart_t* Part);
+static uint32 HashPath(uint32 Hash, const char* Str, size_t StrLen);
+static void IndexObjArray(ObjArrayLoad_t* ObjArrayLoad);
+
+static bool LoadObj(CJSON_Obj_t* Obj, const char* Buf, size_t BufLen, const JSONIndex_t* Index,
+                    OBJ_Necessity_t Necessity);
+static bool LoadObjValue(CJSON_Obj_t* Obj, const char* Value, size_t ValueLen, JSONTypes_t ValueType);
+static JSONStatus_t LocateObjArray(CJSON_Obj_t* Obj, size_t ObjCnt, const char* Buf, size_t BufLen,
+                                   CJSON_ObjLoc_t* ObjLoc);
+
+static void LoadObjArrayCollection(ObjArrayLoad_t* ObjArrayLoad, size_t CollectionStart, size_t PathLen,
+                                   uint32 PathHash);
+static JSONStatus_t LoadObjArrayFused(CJSON_Obj_t* Obj, size_t ObjCnt, const char* Buf, size_t BufLen);
+static void LoadObjArrayStreamVisit(void* Context, const char* Buf, const JSONVisit_t* Visit);
+static void LoadObjArrayValue(ObjArrayLoad_t* ObjArrayLoad, const JSONPair_t* Pair, size_t PathLen,
+                              uint32 PathHash);
+static void LoadObjArrayVisit(void* Context, const char* Buf, const JSONVisit_t* Visit);
+static bool PathIsQueryPrefix(const ObjArrayLoad_t* ObjArrayLoad, uint32 PathHash);
+
+static bool MatchQuery(const JSONQuery_t* Compiled, const CJSON_Query_t* ObjQuery, const char* Query,
+                       ObjStage_t* Stage, const char* Buf, const JSONVisit_t* Visit);
+static JSONNumberType_t ObjNumType(const CJSON_Obj_t* Obj);
+static JSONCursor_t* OwnedCursor(const char* Buf);
 
 static void PrintJsonBuf(const char* JsonBuf, size_t BufLen);
 static bool ProcessFile(const char* Filename, char* JsonBuf, size_t MaxJsonFileChar,
                         CJSON_LoadJsonData_t LoadJsonData,
                         CJSON_LoadJsonDataAlt_t LoadJsonDataAlt, void* UserDataPtr,
-                        bool CallbackWithUserData);
+                        bool CallbackWithUserData, CJSON_Obj_t* Obj, size_t ObjCnt,
+                        CJSON_ObjLoc_t* ObjLoc);
+static BufBlock_t* PoolBlock(const char* Buf);
+static void ReleaseCursor(void);
+
+static void SchemaVisit(void* Context, const char* Buf, const JSONVisit_t* Visit);
 
 static bool StubLoadJsonData(size_t JsonFileLen);
 static bool StubLoadJsonDataAlt(size_t JsonFileLen, void* UserDataPtr);
 
+static size_t FormatUint(uint64 Value, char* Str);
+static void WriterAppend(CJSON_Writer_t* Writer, const char* Str, size_t StrLen);
+static void WriterBegin(CJSON_Writer_t* Writer, const char* Key, const char* Bracket);
+static void WriterEnd(CJSON_Writer_t* Writer, const char* Bracket);
+static void WriterFlush(CJSON_Writer_t* Writer);
+static void WriterIndent(CJSON_Writer_t* Writer);
+static void WriterMember(CJSON_Writer_t* Writer, const char* Key);
+static void WriterReal(CJSON_Writer_t* Writer, double Value, int Digits);
+static void WriterStr(CJSON_Writer_t* Writer, const char* Str);
+
 
 /**********************/
 /** Global File Data **/
@@ -83,6 +282,9 @@ static const char* JsonStatusStr[] = {
   "QueryKeyNotFound",   /* JSONNotFound         */
   "QueryNullPointer",   /* JSONNullParameter    */
   "QueryKeyInvalid",    /* JSONBadParameter     */
+  "IndexFull",          /* JSONIndexFull        */
+  "TokenTooLong",       /* JSONTokenTooLong     */
+  "OutOfRange",         /* JSONOutOfRange       */
   
 };
 
@@ -101,6 +303,173 @@ static const char* JsonTypeStr[] = {
   
 };
 
+/* JSONNumberType_t - Decoded size lookup table */
+
+static const size_t NumTypeSize[] = {
+
+  sizeof(int32),   /* JSONNumInt32  */
+  sizeof(uint32),  /* JSONNumUint32 */
+  sizeof(int64),   /* JSONNumInt64  */
+  sizeof(uint64),  /* JSONNumUint64 */
+  sizeof(float),   /* JSONNumFloat  */
+  sizeof(double),  /* JSONNumDouble */
+
+};
+
+static Cursor_t Cursor;   /* Zeroed so it isn't used until CJSON_LibInit() */
+static CJSON_Stats_t Stats;
+static BufPool_t BufPool;   /* Zeroed so buffers aren't borrowed until CJSON_LibInit() */
+
+
+/******************************************************************************
+** Function: CJSON_AcquireBuf
+**
+** Notes:
+**    1. A zero length request borrows one character so every buffer has a
+**       unique address.
+**    2. A waiting task retries whenever a buffer is released and at least
+**       every CJSON_BUF_POOL_POLL_MS so a missed wake up only delays it. 
+**       Every wait is counted as a full poll, whether it timed out or was
+**       woken by a release, so a task that keeps losing the race for 
+**       released space still gives up after Timeout. 
+**    3. A semaphore error other than a timeout ends the wait.
+**
+*/
+char* CJSON_AcquireBuf(size_t BufLen, int32 Timeout)
+{
+
+   char   *Buf = NULL;
+   bool   Retry;
+   int32  Waited = 0;
+   int32  SysStatus;
+   
+   if (!BufPool.Created)
+   {
+      CFE_EVS_SendEvent(CJSON_INTERNAL_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "CJSON buffer pool isn't available, CJSON_LibInit() failed or wasn't called");
+   }
+   else if (BufLen > CJSON_BUF_POOL_MAX_BUF_CHAR)
+   {
+      CFE_EVS_SendEvent(CJSON_INTERNAL_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "CJSON buffer request for %d characters exceeds the %d character pool buffer limit",
+                        (unsigned int)BufLen, CJSON_BUF_POOL_MAX_BUF_CHAR);
+   }
+   else
+   {
+      
+      if (BufLen == 0)
+      {
+         BufLen = 1;
+      }
+      
+      do
+      {
+         
+         OS_MutSemTake(BufPool.Mutex);
+         Buf = AllocBuf(BufLen);
+         OS_MutSemGive(BufPool.Mutex);
+         
+         Retry = (Buf == NULL && Timeout != OS_CHECK && (Timeout == OS_PEND || Waited < Timeout));
+         if (Retry)
+         {
+            SysStatus = OS_BinSemTimedWait(BufPool.Released, CJSON_BUF_POOL_POLL_MS);
+            if (Timeout != OS_PEND)
+            {
+               Waited += CJSON_BUF_POOL_POLL_MS;
+            }
+            if (SysStatus != OS_SUCCESS && SysStatus != OS_SEM_TIMEOUT)
+            {
+               Retry = false;
+               CFE_EVS_SendEvent(CJSON_INTERNAL_ERR_EID, CFE_EVS_EventType_ERROR,
+                                 "CJSON buffer pool wait failed with status %d", (int)SysStatus);
+            }
+         }
+         
+      } while (Retry);
+      
+   } /* End if valid request */
+   
+   return Buf;
+
+} /* End CJSON_AcquireBuf() */
+
+
+/******************************************************************************
+** Function: CJSON_AcquireFileBuf
+**
+** Notes:
+**    1. An empty file gets a one character buffer, see CJSON_AcquireBuf().
+**
+*/
+char* CJSON_AcquireFileBuf(const char *Filename, size_t MaxJsonFileChar, size_t *BufLen, int32 Timeout)
+{
+
+   char        *Buf = NULL;
+   int32       SysStatus;
+   os_fstat_t  FileStatus;
+   
+   *BufLen = 0;
+   
+   SysStatus = OS_stat(Filename, &FileStatus);
+   
+   if (SysStatus == OS_SUCCESS)
+   {
+      
+      *BufLen = OS_FILESTAT_SIZE(FileStatus);
+      if (*BufLen > MaxJsonFileChar)
+      {
+         *BufLen = MaxJsonFileChar;
+      }
+      
+      Buf = CJSON_AcquireBuf(*BufLen, Timeout);
+      
+      if (Buf == NULL)
+      {
+         CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                           "CJSON couldn't borrow a %d character buffer for file %s",
+                           (unsigned int)*BufLen, Filename);
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                        "CJSON error sizing file %s. Status = %d",
+                        Filename, (int)SysStatus);
+   }
+   
+   return Buf;
+
+} /* End CJSON_AcquireFileBuf() */
+
+
+/******************************************************************************
+** Function: CJSON_ArrayObjConstructor
+**
+*/
+void CJSON_ArrayObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey, 
+                               JSONNumberType_t NumType, void *TblData, size_t TblDataLen)
+{
+
+   CJSON_ObjConstructor(Obj, QueryKey, JSONArray, TblData, TblDataLen);
+   
+   Obj->TypeFlt = (NumType == JSONNumFloat || NumType == JSONNumDouble);
+   Obj->NumType = NumType;
+         
+} /* End CJSON_ArrayObjConstructor() */
+
+
+/******************************************************************************
+** Function: CJSON_BoolObjConstructor
+**
+*/
+void CJSON_BoolObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey, 
+                              void *TblData, size_t TblDataLen)
+{
+
+   CJSON_ObjConstructor(Obj, QueryKey, JSONTrue, TblData, TblDataLen);
+         
+} /* End CJSON_BoolObjConstructor() */
+
 
 /******************************************************************************
 ** Function: CJSON_FltObjConstructor
@@ -117,6 +486,7 @@ void CJSON_FltObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey,
    CJSON_ObjConstructor(Obj, QueryKey, JsonType, TblData, TblDataLen);
    
    Obj->TypeFlt = true;
+   Obj->NumType = JSONNumFloat;
          
 } /* End CJSON_FltObjConstructor() */
 
@@ -128,6 +498,11 @@ void CJSON_FltObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey,
 **    1. This is used to construct individual CJSON_Obj_t structures. This 
 **       constructor is not needed if the user creates a static CJSON_Obj_t
 **       array with default values.
+**    2. The query key is compiled once here so loads don't reparse it. If
+**       the key can't be compiled (e.g. more than CJSON_MAX_QUERY_PARTS
+**       parts) or it compiles to a wildcard query the loads fall back to
+**       searching with the key string, which has no wildcards. Statically
+**       initialized objects have a zero PartCnt and always use the fallback.
 */
 void CJSON_ObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey, 
                           JSONTypes_t JsonType, void *TblData, size_t TblDataLen)
@@ -138,12 +513,19 @@ void CJSON_ObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey,
    Obj->TblDataLen = TblDataLen;   
    Obj->Type       = JsonType;
    Obj->TypeFlt    = false;
+   Obj->NumType    = JSONNumInt32;
+   Obj->StrMode    = CJSON_STR_COPY;
+   Obj->ArrayCnt   = 0;
    
-   if (strlen(QueryKey) <= CJSON_MAX_KEY_LEN)
+   Obj->Query.PartCnt = 0;
+   
+   if (strlen(QueryKey) < CJSON_MAX_KEY_LEN)
    {
       
       strncpy (Obj->Query.Key, QueryKey, CJSON_MAX_KEY_LEN);
       Obj->Query.KeyLen = strlen(Obj->Query.Key);
+      
+      CompileQuery(&Obj->Query);
    }
    else
    {
@@ -156,375 +538,2869 @@ void CJSON_ObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey,
 
 
 /******************************************************************************
-** Function: CJSON_LoadObj
-**
-** Notes:
-**    1. See LoadObj()'s switch statement for supported JSON types
+** Function: CJSON_NumObjConstructor
 **
 */
-bool CJSON_LoadObj(CJSON_Obj_t *Obj, const char*Buf, size_t BufLen)
+void CJSON_NumObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey, 
+                             JSONNumberType_t NumType, void *TblData, size_t TblDataLen)
 {
+
+   CJSON_ObjConstructor(Obj, QueryKey, JSONNumber, TblData, TblDataLen);
    
-   return LoadObj(Obj, Buf, BufLen, OBJ_REQUIRED);
+   Obj->TypeFlt = (NumType == JSONNumFloat || NumType == JSONNumDouble);
+   Obj->NumType = NumType;
+         
+} /* End CJSON_NumObjConstructor() */
+
+
+/******************************************************************************
+** Function: CJSON_StrObjConstructor
+**
+*/
+void CJSON_StrObjConstructor(CJSON_Obj_t *Obj, const char *QueryKey, 
+                             CJSON_StrMode_t StrMode, void *TblData, size_t TblDataLen)
+{
+
+   CJSON_ObjConstructor(Obj, QueryKey, JSONString, TblData, TblDataLen);
    
-} /* End CJSON_LoadObj() */
+   Obj->StrMode = StrMode;
+         
+} /* End CJSON_StrObjConstructor() */
 
 
 /******************************************************************************
-** Function: CJSON_LoadObjArray
+** Function: CJSON_GetFileBuf
 **
 ** Notes:
-**    1. See CJSON_LoadObj() for supported JSON types
+**    1. Searches the pool for the buffer ProcessFile() marked for the 
+**       calling task, a task has at most one callback running.
 **
 */
-size_t CJSON_LoadObjArray(CJSON_Obj_t *Obj, size_t ObjCnt, const char *Buf, size_t BufLen)
+const char* CJSON_GetFileBuf(void)
 {
+
+   const char *Buf = NULL;
+   uint32     TaskIndex;
+   size_t     i;
    
-   int     i;
-   size_t  ObjLoadCnt = 0;
-   
-   for (i=0; i < ObjCnt; i++)
+   if (BufPool.Created && CallerTaskIndex(&TaskIndex))
    {
    
-      if (CJSON_LoadObj(&Obj[i], Buf, BufLen)) ObjLoadCnt++;
+      OS_MutSemTake(BufPool.Mutex);
       
-   } /* End object loop */
-   
-   return ObjLoadCnt;
+      for (i=0; Buf == NULL && i < CJSON_BUF_POOL_MAX_BUFS; i++)
+      {
+         if (BufPool.Block[i].InUse && BufPool.Block[i].FileLoad && BufPool.Block[i].TaskIndex == TaskIndex)
+         {
+            Buf = (char*)BufPool.Arena + BufPool.Block[i].Offset;
+         }
+      }
       
-} /* End CJSON_LoadObjArray() */
+      OS_MutSemGive(BufPool.Mutex);
+   
+   }
+   
+   return Buf;
+
+} /* End CJSON_GetFileBuf() */
 
 
 /******************************************************************************
-** Function: CJSON_LoadObjOptional
-**
-** Notes:
-**    1. See LoadObj()'s switch statement for supported JSON types
+** Function: CJSON_GetStats
 **
 */
-bool CJSON_LoadObjOptional(CJSON_Obj_t *Obj, const char *Buf, size_t BufLen)
+void CJSON_GetStats(CJSON_Stats_t *StatsCopy)
 {
+
+   *StatsCopy = Stats;
    
-   return LoadObj(Obj, Buf, BufLen, OBJ_OPTIONAL);
-   
-} /* End CJSON_LoadObjOptional() */
+} /* End CJSON_GetStats() */
 
 
 /******************************************************************************
-** Function: CJSON_ObjTypeStr
+** Function: CJSON_LibInit
 **
-** Type checking should enforce valid parameter but check just to be safe.
 */
-const char* CJSON_ObjTypeStr(JSONTypes_t  ObjType)
+bool CJSON_LibInit(void)
 {
 
-   uint8 i = 0;
+   int32 SysStatus;
    
-   if ( ObjType >= JSONInvalid &&
-        ObjType <= JSONArray)
+   SysStatus = OS_MutSemCreate(&Cursor.Mutex, "CJSON_CURSOR", 0);
+   
+   Cursor.Created = (SysStatus == OS_SUCCESS);
+   Cursor.Claimed = false;
+   
+   CJSON_ResetStats();
+   
+   if (!Cursor.Created)
    {
+      CFE_EVS_SendEvent(CJSON_INTERNAL_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "CJSON search cursor mutex create failed. Status = %d", (int)SysStatus);
+   }
    
-      i =  ObjType;
+   memset(BufPool.Block, 0, sizeof(BufPool.Block));
+   
+   SysStatus = OS_MutSemCreate(&BufPool.Mutex, "CJSON_BUFPOOL", 0);
+   if (SysStatus == OS_SUCCESS)
+   {
+      SysStatus = OS_BinSemCreate(&BufPool.Released, "CJSON_BUFREL", 0, 0);
+   }
    
+   BufPool.Created = (SysStatus == OS_SUCCESS);
+   
+   if (!BufPool.Created)
+   {
+      CFE_EVS_SendEvent(CJSON_INTERNAL_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "CJSON buffer pool semaphore create failed. Status = %d", (int)SysStatus);
    }
-        
-   return JsonTypeStr[i];
-
-} /* End CJSON_ObjTypeStr() */
+   
+   return (Cursor.Created && BufPool.Created);
+   
+} /* End CJSON_LibInit() */
 
 
 /******************************************************************************
-** Function: CJSON_ProcessFile
+** Function: CJSON_LoadObj
 **
 ** Notes:
-**  1. See ProcessFile() for details.
-**  2. The JsonBuf pointer is passed in as an unused UserDataPtr. 
+**    1. See LoadObj()'s switch statement for supported JSON types
+**
 */
-bool CJSON_ProcessFile(const char *Filename, char *JsonBuf, 
-                       size_t MaxJsonFileChar, CJSON_LoadJsonData_t LoadJsonData)
+bool CJSON_LoadObj(CJSON_Obj_t *Obj, const char*Buf, size_t BufLen)
 {
-
-
-   return ProcessFile(Filename, JsonBuf, MaxJsonFileChar, LoadJsonData, StubLoadJsonDataAlt, (void*)JsonBuf, false);
-
    
-} /* End CJSON_ProcessFile() */
+   return LoadObj(Obj, Buf, BufLen, NULL, OBJ_REQUIRED);
+   
+} /* End CJSON_LoadObj() */
 
 
 /******************************************************************************
-** Function: CJSON_ProcessFileAlt
+** Function: CJSON_LoadObjIndexed
 **
 ** Notes:
-**  1. See ProcessFile() for details.
+**    1. See LoadObj()'s switch statement for supported JSON types
+**
 */
-bool CJSON_ProcessFileAlt(const char *Filename, char *JsonBuf, 
-                          size_t MaxJsonFileChar, CJSON_LoadJsonDataAlt_t LoadJsonDataAlt,
-                          void *UserDataPtr)
+bool CJSON_LoadObjIndexed(CJSON_Obj_t *Obj, const JSONIndex_t *Index)
 {
-
-   return ProcessFile(Filename, JsonBuf, MaxJsonFileChar, StubLoadJsonData, LoadJsonDataAlt, UserDataPtr, true);
-
    
-} /* End CJSON_ProcessFileAlt() */
+   return LoadObj(Obj, Index->buf, Index->max, Index, OBJ_REQUIRED);
+   
+} /* End CJSON_LoadObjIndexed() */
 
 
 /******************************************************************************
-** Function: LoadObj
+** Function: CJSON_LoadObjLoc
 **
 ** Notes:
-**    None
+**    1. See LoadObj()'s switch statement for supported JSON types
 **
 */
-static bool LoadObj(CJSON_Obj_t* Obj, const char* Buf, size_t BufLen, OBJ_Necessity_t Necessity)
+bool CJSON_LoadObjLoc(CJSON_Obj_t *Obj, const char *Buf, const CJSON_ObjLoc_t *ObjLoc)
 {
    
-   bool         RetStatus = false;
-   JSONStatus_t JsonStatus;
-   const char   *Value;
-   size_t       ValueLen;
-   JSONTypes_t  ValueType;
-   char         *ErrCheck;
-   char         NumberBuf[20], StrBuf[256];
-   int          IntValue;
-   float        FltValue;
+   bool RetStatus = false;
    
    Obj->Updated = false;
-      
-   JsonStatus = JSON_SearchConst(Buf, BufLen, 
-                                 Obj->Query.Key, Obj->Query.KeyLen,
-                                 &Value, &ValueLen, &ValueType);
-                                 
-   if (JsonStatus == JSONSuccess)
+   
+   if (ObjLoc->Located)
    {
+      RetStatus = LoadObjValue(Obj, &Buf[ObjLoc->Value], ObjLoc->ValueLen, ObjLoc->Type);
+   }
    
-      CFE_EVS_SendEvent(CJSON_LOAD_OBJ_EID, CFE_EVS_EventType_DEBUG,
-                        "CJSON_LoadObj: Type=%s, Value=%s, Len=%d",
-                        JsonTypeStr[ValueType], Value, (unsigned int)ValueLen);
+   return RetStatus;
+   
+} /* End CJSON_LoadObjLoc() */
 
-      switch (ValueType)
-      {
-         
-         case JSONString:
-         
-            if (ValueLen <= Obj->TblDataLen)
-            {
 
-               strncpy(StrBuf,Value,ValueLen);
-               StrBuf[ValueLen] = '\0';
-               
-               memcpy(Obj->TblData,StrBuf,ValueLen+1);
-               Obj->Updated = true;
-               RetStatus = true;
-            
-            }
-            else
-            {
-               
-               CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR, 
-                                 "JSON string length %d exceeds %s's max length %d", 
-                                 (unsigned int)ValueLen, Obj->Query.Key, (unsigned int)Obj->TblDataLen);
-            
-            }
-            break;
-   
-         case JSONNumber:
-            
-            strncpy(NumberBuf, Value, ValueLen);
-            NumberBuf[ValueLen] = '\0';
-            
-            if (Obj->TypeFlt)
+/******************************************************************************
+** Function: CJSON_LoadObjArray
+**
+** Notes:
+**    1. See CJSON_LoadObj() for supported JSON types
+**    2. The JSON buffer is traversed once for every CJSON_MAX_STAGED_OBJ
+**       objects and each visited value is only compared with the query keys
+**       that hash like its path. Loading N objects used to cost N complete 
+**       searches of the buffer.
+**    3. Each object's Updated flag is set the same way CJSON_LoadObj() sets
+**       it. If a key appears more than once the first occurrence is loaded.
+**    4. Values that can't be decoded have been reported by the decoder so
+**       only objects the traversal didn't find are reported as search 
+**       errors.
+**
+*/
+size_t CJSON_LoadObjArray(CJSON_Obj_t *Obj, size_t ObjCnt, const char *Buf, size_t BufLen)
+{
+   
+   size_t  i;
+   size_t  Start = 0;
+   size_t  Base;
+   ObjArrayLoad_t ObjArrayLoad;
+
+   ObjArrayLoad.ObjLoadCnt = 0;
+   ObjArrayLoad.Buf        = Buf;
+   ObjArrayLoad.BufLen     = BufLen;
+   
+   for (i=0; i < ObjCnt; i++)
+   {
+      Obj[i].Updated = false;
+   }
+   
+   /* Root is the collection that starts with the first non-whitespace character */ 
+   while ((Start < BufLen) && (Buf[Start] == ' ' || Buf[Start] == '\t' || Buf[Start] == '\n' || Buf[Start] == '\r'))
+   {
+      Start++;
+   }
+   
+   for (Base=0; Base < ObjCnt; Base += CJSON_MAX_STAGED_OBJ)
+   {
+      
+      ObjArrayLoad.Obj    = &Obj[Base];
+      ObjArrayLoad.ObjCnt = ((ObjCnt - Base) < CJSON_MAX_STAGED_OBJ) ? (ObjCnt - Base) : CJSON_MAX_STAGED_OBJ;
+      IndexObjArray(&ObjArrayLoad);
+      
+      if ((Start < BufLen) && (Buf[Start] == '{' || Buf[Start] == '['))
+      {
+         LoadObjArrayCollection(&ObjArrayLoad, Start, 0, PATH_HASH_SEED);
+      }
+
+      for (i=0; i < ObjArrayLoad.ObjCnt; i++)
+      {
+         if (!ObjArrayLoad.Found[i])
+         {
+            CFE_EVS_SendEvent(CJSON_LOAD_OBJ_EID, CFE_EVS_EventType_INFORMATION,
+                              "JSON search error for query %s. Status = %s.", 
+                              ObjArrayLoad.Obj[i].Query.Key, JsonStatusStr[JSONNotFound]);
+         }
+      }
+   
+   } /* End object group loop */
+   
+   return ObjArrayLoad.ObjLoadCnt;
+      
+} /* End CJSON_LoadObjArray() */
+
+
+/******************************************************************************
+** Function: CJSON_LoadObjOptional
+**
+** Notes:
+**    1. See LoadObj()'s switch statement for supported JSON types
+**
+*/
+bool CJSON_LoadObjOptional(CJSON_Obj_t *Obj, const char *Buf, size_t BufLen)
+{
+   
+   return LoadObj(Obj, Buf, BufLen, NULL, OBJ_OPTIONAL);
+   
+} /* End CJSON_LoadObjOptional() */
+
+
+/******************************************************************************
+** Function: CJSON_LoadStructArray
+**
+** Notes:
+**    1. Each element's members are iterated and matched against Field[] so
+**       the buffer is traversed once. A bit mask records which fields have
+**       been loaded so duplicate members can't hide a missing field.
+**
+*/
+size_t CJSON_LoadStructArray(const char *Buf, size_t BufLen, const char *ArrayQuery,
+                             void *StructArray, size_t StructSize, size_t StructCnt,
+                             const CJSON_Field_t *Field, size_t FieldCnt)
+{
+
+   size_t       StructLoadCnt = 0;
+   size_t       ElementCnt = 0;
+   size_t       ArrayStart = 0, ArrayNext = 0;
+   size_t       MemberStart, MemberNext;
+   size_t       ArrayLen, f;
+   uint32       FieldMask, FieldLoadMask;
+   uint8        *Struct;
+   const char   *ArrayValue;
+   JSONTypes_t  ArrayType;
+   JSONStatus_t JsonStatus;
+   JSONPair_t   Element, Member;
+   
+   
+   if (FieldCnt == 0 || FieldCnt > CJSON_MAX_STRUCT_FIELDS)
+   {
+      CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "JSON array %s field count %d is not between 1 and %d",
+                        ArrayQuery, (unsigned int)FieldCnt, CJSON_MAX_STRUCT_FIELDS);
+   }
+   else
+   {
+   
+      FieldMask = (FieldCnt == 32) ? 0xFFFFFFFF : (((uint32)1 << FieldCnt) - 1);
+   
+      JsonStatus = JSON_SearchConst(Buf, BufLen, ArrayQuery, strlen(ArrayQuery),
+                                    &ArrayValue, &ArrayLen, &ArrayType);
+                                 
+      if (JsonStatus == JSONSuccess && ArrayType == JSONArray)
+      {
+      
+         while (JSON_Iterate(ArrayValue, ArrayLen, &ArrayStart, &ArrayNext, &Element) == JSONSuccess)
+         {
+         
+            if (ElementCnt >= StructCnt)
             {
-               FltValue = (float)strtod(NumberBuf, &ErrCheck);
-               if (ErrCheck != NumberBuf)
-               {
-                  memcpy(Obj->TblData, &FltValue, sizeof(float));
-               }
+               CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                                 "JSON array %s has more than the %d elements that can be loaded",
+                                 ArrayQuery, (unsigned int)StructCnt);
+               break;
             }
-            else
+         
+            Struct = (uint8*)StructArray + (ElementCnt * StructSize);
+            FieldLoadMask = 0;
+         
+            if (Element.jsonType == JSONObject)
+            {
+            
+               MemberStart = 0;
+               MemberNext  = 0;
+            
+               while (JSON_Iterate(Element.value, Element.valueLength, &MemberStart, &MemberNext, &Member) == JSONSuccess)
+               {
+                  for (f=0; f < FieldCnt; f++)
+                  {
+                     if (Field[f].Key != NULL && strncmp(Field[f].Key, Member.key, Member.keyLength) == 0 &&
+                         Field[f].Key[Member.keyLength] == '\0')
+                     {
+                        if (DecodeValue(&Struct[Field[f].Offset], Field[f].Size, Field[f].Type, Field[f].NumType,
+                                        Field[f].StrMode, Field[f].Key, Member.value, Member.valueLength, Member.jsonType))
+                        {
+                           FieldLoadMask |= ((uint32)1 << f);
+                        }
+                        break;
+                     }
+                  } /* End field loop */
+               } /* End member loop */
+         
+            } /* End if object element */
+            else if (FieldCnt == 1 && Field[0].Key == NULL)
             {
-               IntValue = (int)strtol(NumberBuf, &ErrCheck, 10);
-               if (ErrCheck != NumberBuf)
+            
+               if (DecodeValue(&Struct[Field[0].Offset], Field[0].Size, Field[0].Type, Field[0].NumType,
+                               Field[0].StrMode, ArrayQuery, Element.value, Element.valueLength, Element.jsonType))
                {
-                  memcpy(Obj->TblData, &IntValue, sizeof(int));
+                  FieldLoadMask = 1;
                }
+         
+            } /* End if scalar element */
+         
+            if (FieldLoadMask == FieldMask)
+            {
+               StructLoadCnt++;
             }
-            if (ErrCheck != NumberBuf)
+            ElementCnt++;
+         
+         } /* End element loop */
+      
+         if (StructLoadCnt < ElementCnt)
+         {
+            CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "JSON array %s has %d of %d elements with missing or invalid fields",
+                              ArrayQuery, (unsigned int)(ElementCnt-StructLoadCnt), (unsigned int)ElementCnt);
+         }
+      
+      } /* End if array found */
+      else
+      {
+      
+         if (JsonStatus == JSONSuccess)
+         {
+            JsonStatus = JSONNotFound;
+         }
+         CFE_EVS_SendEvent(CJSON_LOAD_OBJ_EID, CFE_EVS_EventType_INFORMATION,
+                           "JSON search error for query %s. Status = %s.", 
+                           ArrayQuery, JsonStatusStr[JsonStatus]);
+      }
+      
+   } /* End if valid field count */
+   
+   return StructLoadCnt;
+   
+} /* End CJSON_LoadStructArray() */
+
+
+/******************************************************************************
+** Function: CJSON_ObjTypeStr
+**
+** Type checking should enforce valid parameter but check just to be safe.
+*/
+const char* CJSON_ObjTypeStr(JSONTypes_t  ObjType)
+{
+
+   uint8 i = 0;
+   
+   if ( ObjType >= JSONInvalid &&
+        ObjType <= JSONArray)
+   {
+   
+      i =  ObjType;
+   
+   }
+        
+   return JsonTypeStr[i];
+
+} /* End CJSON_ObjTypeStr() */
+
+
+/******************************************************************************
+** Function: CJSON_ProcessFile
+**
+** Notes:
+**  1. See ProcessFile() for details.
+**  2. The JsonBuf pointer is passed in as an unused UserDataPtr. 
+*/
+bool CJSON_ProcessFile(const char *Filename, char *JsonBuf, 
+                       size_t MaxJsonFileChar, CJSON_LoadJsonData_t LoadJsonData)
+{
+
+
+   return ProcessFile(Filename, JsonBuf, MaxJsonFileChar, LoadJsonData, StubLoadJsonDataAlt, (void*)JsonBuf, false, NULL, 0, NULL);
+
+   
+} /* End CJSON_ProcessFile() */
+
+
+/******************************************************************************
+** Function: CJSON_ProcessFileAlt
+**
+** Notes:
+**  1. See ProcessFile() for details.
+*/
+bool CJSON_ProcessFileAlt(const char *Filename, char *JsonBuf, 
+                          size_t MaxJsonFileChar, CJSON_LoadJsonDataAlt_t LoadJsonDataAlt,
+                          void *UserDataPtr)
+{
+
+   return ProcessFile(Filename, JsonBuf, MaxJsonFileChar, StubLoadJsonData, LoadJsonDataAlt, UserDataPtr, true, NULL, 0, NULL);
+
+   
+} /* End CJSON_ProcessFileAlt() */
+
+
+/******************************************************************************
+** Function: CJSON_ProcessFileObjArray
+**
+** Notes:
+**  1. See ProcessFile() for details.
+*/
+bool CJSON_ProcessFileObjArray(const char *Filename, char *JsonBuf, 
+                               size_t MaxJsonFileChar, CJSON_Obj_t *Obj, size_t ObjCnt,
+                               CJSON_LoadJsonDataAlt_t LoadJsonDataAlt, void *UserDataPtr)
+{
+
+   return ProcessFile(Filename, JsonBuf, MaxJsonFileChar, StubLoadJsonData, LoadJsonDataAlt, UserDataPtr, true, Obj, ObjCnt, NULL);
+
+   
+} /* End CJSON_ProcessFileObjArray() */
+
+
+/******************************************************************************
+** Function: CJSON_ProcessFileLocate
+**
+** Notes:
+**  1. See ProcessFile() for details.
+*/
+bool CJSON_ProcessFileLocate(const char *Filename, char *JsonBuf, 
+                             size_t MaxJsonFileChar, CJSON_Obj_t *Obj, CJSON_ObjLoc_t *ObjLoc,
+                             size_t ObjCnt, CJSON_LoadJsonDataAlt_t LoadJsonDataAlt, void *UserDataPtr)
+{
+
+   bool RetStatus = false;
+   
+   if (ObjCnt > CJSON_MAX_STAGED_OBJ)
+   {
+      CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                        "CJSON error locating objects in file %s. Object count %d exceeds maximum %d",
+                        Filename, (unsigned int)ObjCnt, CJSON_MAX_STAGED_OBJ);
+   }
+   else
+   {
+      RetStatus = ProcessFile(Filename, JsonBuf, MaxJsonFileChar, StubLoadJsonData, LoadJsonDataAlt, 
+                              UserDataPtr, true, Obj, ObjCnt, ObjLoc);
+   }
+   
+   return RetStatus;
+   
+} /* End CJSON_ProcessFileLocate() */
+
+
+/******************************************************************************
+** Function: CJSON_ProcessFileStream
+**
+** Notes:
+**  1. The file is read in CJSON_STREAM_CHUNK_LEN chunks and each chunk is
+**     parsed before the next is read so the file's size isn't limited by a
+**     JSON buffer.
+**  2. Objects that weren't constructed with a compiled query are compiled
+**     here because they can't be searched for after the file is parsed.
+**
+*/
+bool CJSON_ProcessFileStream(const char *Filename, CJSON_Obj_t *Obj, size_t ObjCnt,
+                             CJSON_LoadJsonDataAlt_t LoadJsonDataAlt, void *UserDataPtr)
+{
+
+   bool            RetStatus = false;
+   osal_id_t       FileHandle;
+   int32           SysStatus;
+   int32           ReadStatus;
+   size_t          FileLen = 0;
+   size_t          i;
+   JSONStatus_t    JsonStatus = JSONPartial;
+   JSONStream_t    JsonStream;
+   ObjArrayFused_t ObjArrayStream;
+   char            Chunk[CJSON_STREAM_CHUNK_LEN];
+   os_err_name_t   OsErrStr;
+   
+   if (ObjCnt > CJSON_MAX_STAGED_OBJ)
+   {
+      CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                        "CJSON error streaming file %s. Object count %d exceeds maximum %d",
+                        Filename, (unsigned int)ObjCnt, CJSON_MAX_STAGED_OBJ);
+   }
+   else
+   {
+   
+      for (i=0; i < ObjCnt; i++)
+      {
+         Obj[i].Updated = false;
+         if (Obj[i].Query.PartCnt == 0)
+         {
+            if (!CompileQuery(&Obj[i].Query))
             {
-               Obj->Updated = true;
-               RetStatus = true;
+               CFE_EVS_SendEvent(CJSON_OBJ_CONSTRUCT_ERR_EID, CFE_EVS_EventType_ERROR,
+                                 "CJSON error streaming file %s. Query key %s can't be compiled",
+                                 Filename, Obj[i].Query.Key);
             }
-            else
+         }
+      }
+   
+      ObjArrayStream.Obj    = Obj;
+      ObjArrayStream.ObjCnt = ObjCnt;
+      memset(ObjArrayStream.Stage, 0, sizeof(ObjArrayStream.Stage));
+      JSON_StreamInit(&JsonStream, LoadObjArrayStreamVisit, &ObjArrayStream);
+   
+      SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+   
+      if (SysStatus == OS_SUCCESS)
+      {
+      
+         CFE_ES_PerfLogEntry(CJSON_PARSE_PERF_ID);
+         do
+         {
+         
+            ReadStatus = OS_read(FileHandle, Chunk, sizeof(Chunk));
+         
+            if (ReadStatus > 0)
             {
-               CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
-                                 "CJSON number conversion error for value %s",
-                                 NumberBuf);
+               FileLen += ReadStatus;
+               JsonStatus = JSON_StreamParse(&JsonStream, Chunk, ReadStatus);
             }
+      
+         } while ((ReadStatus > 0) && ((JsonStatus == JSONPartial) || (JsonStatus == JSONSuccess)));
+         CFE_ES_PerfLogExit(CJSON_PARSE_PERF_ID);
+      
+         if (ReadStatus >= 0)
+         {
+      
+            JsonStatus = JSON_StreamFinish(&JsonStream);
+         
+            if (JsonStatus == JSONSuccess)
+            {
             
-            break;
-
-         case JSONArray:
+               for (i=0; i < ObjCnt; i++)
+               {
+                  if (!ObjArrayStream.Stage[i].Staged)
+                  {
+                     CFE_EVS_SendEvent(CJSON_LOAD_OBJ_EID, CFE_EVS_EventType_INFORMATION,
+                                       "JSON search error for query %s. Status = %s.", 
+                                       Obj[i].Query.Key, JsonStatusStr[JSONNotFound]);
+                  }
+               }
+            
+               CFE_ES_PerfLogEntry(CJSON_LOAD_PERF_ID);
+               RetStatus = LoadJsonDataAlt(FileLen, UserDataPtr);
+               CFE_ES_PerfLogExit(CJSON_LOAD_PERF_ID);
          
-            CFE_EVS_SendEvent(CJSON_LOAD_OBJ_EID, CFE_EVS_EventType_INFORMATION,
-                              "JSON array %s, len = %d", Value, (unsigned int)ValueLen);
-            PrintJsonBuf(Value, ValueLen);
+            }
+            else
+            {
          
-            break;
+               CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                                 "CJSON error validating file %s at character %d.  Status = %s.",
+                                 Filename, (unsigned int)JsonStream.position, JsonStatusStr[JsonStatus]);
 
-         case JSONObject:
+            }
+
+         } /* End if valid reads */
+         else
+         {
          
-            CFE_EVS_SendEvent(CJSON_LOAD_OBJ_EID, CFE_EVS_EventType_INFORMATION,
-                              "JSON array %s, len = %d", Value, (unsigned int)ValueLen);
-            PrintJsonBuf(Value, ValueLen);
+            CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                              "CJSON error reading file %s. Status = %d",
+                              Filename, ReadStatus);
          
-            break;
+         } /* End if invalid read */
+   
+         OS_close(FileHandle);
+      
+      }/* End if valid open */
+      else
+      {
+         OS_GetErrorName(SysStatus, &OsErrStr);
+         CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "CJSON error opening file %s. Status = %s", 
+                           Filename, OsErrStr);
+      }
+      
+   } /* End if valid object count */
+   
+   CountFile(FileLen, RetStatus);
+   
+   return RetStatus;
+   
+} /* End CJSON_ProcessFileStream() */
+
+
+/******************************************************************************
+** Function: CJSON_ReleaseBuf
+**
+*/
+void CJSON_ReleaseBuf(const char *Buf)
+{
+
+   BufBlock_t *Block;
+   
+   if (BufPool.Created)
+   {
+      
+      OS_MutSemTake(BufPool.Mutex);
+      Block = PoolBlock(Buf);
+      if (Block != NULL)
+      {
+         Block->InUse = false;
+      }
+      OS_MutSemGive(BufPool.Mutex);
+      
+      if (Block != NULL)
+      {
+         OS_BinSemFlush(BufPool.Released);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(CJSON_INTERNAL_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "CJSON buffer release ignored, the buffer wasn't borrowed from the pool");
+      }
+   }
+   
+} /* End CJSON_ReleaseBuf() */
+
+
+/******************************************************************************
+** Function: CJSON_ResetStats
+**
+*/
+void CJSON_ResetStats(void)
+{
+
+   memset(&Stats, 0, sizeof(Stats));
+   
+} /* End CJSON_ResetStats() */
+
+
+/******************************************************************************
+** Function: CJSON_SchemaConstructor
+**
+** Notes:
+**  1. Fields must be strings or numbers.
+**  2. A path may contain one "[*]", which JSON_QueryCompile() compiles to a
+**     JSON_QUERY_ANY_INDEX part. "*" object member wildcards aren't 
+**     supported because a field has one location per array element.
+**
+*/
+bool CJSON_SchemaConstructor(CJSON_Schema_t *Schema, const CJSON_SchemaField_t *Field,
+                             uint16 FieldCnt)
+{
+
+   bool                 RetStatus = true;
+   uint16               i;
+   uint16               p;
+   const CJSON_SchemaField_t  *SchemaField;
+   CJSON_SchemaEntry_t  *Entry;
+   JSONStatus_t         JsonStatus;
+   
+   Schema->Field    = Field;
+   Schema->FieldCnt = 0;
+   
+   if (FieldCnt > CJSON_MAX_SCHEMA_FIELDS)
+   {
+      CFE_EVS_SendEvent(CJSON_OBJ_CONSTRUCT_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Error constructing schema. Field count %d exceeds maximum %d",
+                        FieldCnt, CJSON_MAX_SCHEMA_FIELDS);
+      RetStatus = false;
+   }
+   
+   for (i=0; RetStatus && i < FieldCnt; i++)
+   {
+   
+      SchemaField = &Field[i];
+      Entry       = &Schema->Entry[i];
+      
+      Entry->EachDepth  = 0;
+      Entry->LoadCnt    = 0;
+      Entry->ElementCnt = 0;
+      Entry->Query.partCount = 0;
+      
+      if (SchemaField->Type != JSONString && SchemaField->Type != JSONNumber)
+      {
+         JsonStatus = JSONBadParameter;
+      }
+      else
+      {
+         JsonStatus = JSON_QueryCompile(SchemaField->Path, strlen(SchemaField->Path), &Entry->Query);
+      }
+      
+      if (JsonStatus == JSONSuccess && Entry->Query.wildcardCount > 0)
+      {
+      
+         for (p=0; p < Entry->Query.partCount; p++)
+         {
+            if (Entry->Query.parts[p].arrayIndex == JSON_QUERY_ANY_INDEX)
+            {
+               Entry->EachDepth = p + 1;
+            }
+         }
+         
+         if (Entry->Query.wildcardCount > 1 || Entry->EachDepth == 0 ||
+             SchemaField->Stride == 0 || SchemaField->MaxCnt == 0)
+         {
+            JsonStatus = JSONBadParameter;
+         }
+      
+      } /* End if "[*]" path */
+   
+      if (JsonStatus != JSONSuccess)
+      {
+         CFE_EVS_SendEvent(CJSON_OBJ_CONSTRUCT_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Error constructing schema field %d. Path %s with type %s can't be compiled. Status = %s",
+                           i, SchemaField->Path, JsonTypeStr[SchemaField->Type], JsonStatusStr[JsonStatus]);
+         RetStatus = false;
+      }
+   
+   } /* End field loop */
+   
+   if (RetStatus)
+   {
+      Schema->FieldCnt = FieldCnt;
+   }
+   
+   return RetStatus;
+   
+} /* End CJSON_SchemaConstructor() */
+
+
+/******************************************************************************
+** Function: CJSON_SchemaLoad
+**
+*/
+bool CJSON_SchemaLoad(CJSON_Schema_t *Schema, const char *Buf, size_t BufLen, void *Tbl)
+{
+
+   bool          RetStatus = false;
+   uint16        i;
+   JSONStatus_t  JsonStatus;
+   SchemaLoad_t  SchemaLoad;
+   const CJSON_SchemaField_t  *Field;
+   CJSON_SchemaEntry_t        *Entry;
+   
+   SchemaLoad.Schema = Schema;
+   SchemaLoad.Tbl    = (uint8*)Tbl;
+   memset(SchemaLoad.Stage, 0, sizeof(SchemaLoad.Stage));
+   
+   for (i=0; i < Schema->FieldCnt; i++)
+   {
+      Schema->Entry[i].LoadCnt    = 0;
+      Schema->Entry[i].ElementCnt = 0;
+   }
+   
+   JsonStatus = JSON_ValidateVisit(Buf, BufLen, SchemaVisit, &SchemaLoad);
+   
+   if (JsonStatus == JSONSuccess)
+   {
+   
+      RetStatus = true;
+      
+      for (i=0; i < Schema->FieldCnt; i++)
+      {
+         
+         Field = &Schema->Field[i];
+         Entry = &Schema->Entry[i];
+         
+         if (Field->Required)
+         {
+            if ((Entry->EachDepth == 0 && Entry->LoadCnt == 0) ||
+                (Entry->EachDepth > 0 && Entry->LoadCnt < Entry->ElementCnt))
+            {
+               CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                                 "JSON schema required field %s loaded %d of %d values",
+                                 Field->Path, (unsigned int)Entry->LoadCnt, 
+                                 (unsigned int)(Entry->EachDepth == 0 ? 1 : Entry->ElementCnt));
+               RetStatus = false;
+            }
+         }
+      
+      } /* End field loop */
+   }
+   else
+   {
+      CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "JSON schema load error. Invalid JSON buffer. Status = %s",
+                        JsonStatusStr[JsonStatus]);
+   }
+   
+   return RetStatus;
+   
+} /* End CJSON_SchemaLoad() */
+
+
+/******************************************************************************
+** Function: CJSON_SchemaLoadCnt
+**
+*/
+size_t CJSON_SchemaLoadCnt(const CJSON_Schema_t *Schema, uint16 FieldIdx)
+{
+
+   size_t LoadCnt = 0;
+   
+   if (FieldIdx < Schema->FieldCnt)
+   {
+      LoadCnt = Schema->Entry[FieldIdx].LoadCnt;
+   }
+   
+   return LoadCnt;
+   
+} /* End CJSON_SchemaLoadCnt() */
+
+
+/******************************************************************************
+** Function: CJSON_ShrinkBuf
+**
+*/
+bool CJSON_ShrinkBuf(const char *Buf, size_t BufLen)
+{
+
+   bool       RetStatus = false;
+   BufBlock_t *Block;
+   
+   if (BufPool.Created)
+   {
+      
+      OS_MutSemTake(BufPool.Mutex);
+      Block = PoolBlock(Buf);
+      if (Block != NULL && BufLen <= Block->Len)
+      {
+         Block->Len = (BufLen > 0) ? BufLen : 1;   /* Keeps the buffer's address unique */
+         RetStatus  = true;
+      }
+      OS_MutSemGive(BufPool.Mutex);
+      
+      if (RetStatus)
+      {
+         OS_BinSemFlush(BufPool.Released);
+      }
+   }
+   
+   return RetStatus;
+   
+} /* End CJSON_ShrinkBuf() */
+
+
+/******************************************************************************
+** Function: CJSON_WriterOpen
+**
+*/
+bool CJSON_WriterOpen(CJSON_Writer_t *Writer, const char *Filename, char *Buf, size_t BufLen)
+{
+
+   int32          SysStatus;
+   os_err_name_t  OsErrStr;
+   
+   memset(Writer, 0, sizeof(CJSON_Writer_t));
+   Writer->Buf    = Buf;
+   Writer->BufLen = BufLen;
+   
+   if (BufLen > 0)
+   {
+   
+      SysStatus = OS_OpenCreate(&Writer->FileHandle, Filename, 
+                                OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+   
+      if (SysStatus == OS_SUCCESS)
+      {
+         Writer->FileOpen = true;
+         Writer->Valid    = true;
+      }
+      else
+      {
+         OS_GetErrorName(SysStatus, &OsErrStr);
+         CFE_EVS_SendEvent(CJSON_WRITE_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "CJSON error creating file %s. Status = %s", 
+                           Filename, OsErrStr);
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent(CJSON_WRITE_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "CJSON error creating file %s. Write buffer length is zero", 
+                        Filename);
+   }
+   
+   return Writer->Valid;
+   
+} /* End CJSON_WriterOpen() */
+
+
+/******************************************************************************
+** Function: CJSON_WriterClose
+**
+*/
+bool CJSON_WriterClose(CJSON_Writer_t *Writer)
+{
+
+   if (Writer->FileOpen)
+   {
+   
+      if (Writer->Valid && Writer->Depth > 0)
+      {
+         CFE_EVS_SendEvent(CJSON_WRITE_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "CJSON write error. File closed with %d unterminated objects or arrays",
+                           Writer->Depth);
+         Writer->Valid = false;
+      }
+      
+      WriterAppend(Writer, "\n", 1);
+      WriterFlush(Writer);
+      OS_close(Writer->FileHandle);
+      Writer->FileOpen = false;
+      
+   }
+   
+   return Writer->Valid;
+   
+} /* End CJSON_WriterClose() */
+
+
+/******************************************************************************
+** Function: CJSON_WriterBeginArray
+**
+*/
+void CJSON_WriterBeginArray(CJSON_Writer_t *Writer, const char *Key)
+{
+
+   WriterBegin(Writer, Key, "[");
+   
+} /* End CJSON_WriterBeginArray() */
+
+
+/******************************************************************************
+** Function: CJSON_WriterBeginObj
+**
+*/
+void CJSON_WriterBeginObj(CJSON_Writer_t *Writer, const char *Key)
+{
+
+   WriterBegin(Writer, Key, "{");
+   
+} /* End CJSON_WriterBeginObj() */
+
+
+/******************************************************************************
+** Function: CJSON_WriterDbl
+**
+*/
+void CJSON_WriterDbl(CJSON_Writer_t *Writer, const char *Key, double Value)
+{
+
+   WriterMember(Writer, Key);
+   WriterReal(Writer, Value, 17);
+   
+} /* End CJSON_WriterDbl() */
+
+
+/******************************************************************************
+** Function: CJSON_WriterEndArray
+**
+*/
+void CJSON_WriterEndArray(CJSON_Writer_t *Writer)
+{
+
+   WriterEnd(Writer, "]");
+   
+} /* End CJSON_WriterEndArray() */
+
+
+/******************************************************************************
+** Function: CJSON_WriterEndObj
+**
+*/
+void CJSON_WriterEndObj(CJSON_Writer_t *Writer)
+{
+
+   WriterEnd(Writer, "}");
+   
+} /* End CJSON_WriterEndObj() */
+
+
+/******************************************************************************
+** Function: CJSON_WriterFlt
+**
+*/
+void CJSON_WriterFlt(CJSON_Writer_t *Writer, const char *Key, float Value)
+{
+
+   WriterMember(Writer, Key);
+   WriterReal(Writer, (double)Value, 9);
+   
+} /* End CJSON_WriterFlt() */
+
+
+/******************************************************************************
+** Function: CJSON_WriterHex
+**
+*/
+void CJSON_WriterHex(CJSON_Writer_t *Writer, const char *Key, uint32 Value)
+{
+
+   static const char HexDigit[] = "0123456789ABCDEF";
+   
+   char   Str[12];   /* "0x" plus 8 digits plus quotes */
+   size_t i = sizeof(Str);
+   
+   Str[--i] = '"';
+   do
+   {
+      Str[--i] = HexDigit[Value & 0xF];
+      Value >>= 4;
+   } while (Value > 0);
+   Str[--i] = 'x';
+   Str[--i] = '0';
+   Str[--i] = '"';
+   
+   WriterMember(Writer, Key);
+   WriterAppend(Writer, &Str[i], sizeof(Str) - i);
+   
+} /* End CJSON_WriterHex() */
+
+
+/******************************************************************************
+** Function: CJSON_WriterInt
+**
+*/
+void CJSON_WriterInt(CJSON_Writer_t *Writer, const char *Key, int64 Value)
+{
+
+   char    Str[WRITER_NUM_STR_LEN];
+   size_t  Len = 0;
+   uint64  Magnitude = (uint64)Value;
+   
+   if (Value < 0)
+   {
+      Str[Len++] = '-';
+      Magnitude  = 0 - Magnitude;
+   }
+   Len += FormatUint(Magnitude, &Str[Len]);
+   
+   WriterMember(Writer, Key);
+   WriterAppend(Writer, Str, Len);
+   
+} /* End CJSON_WriterInt() */
+
+
+/******************************************************************************
+** Function: CJSON_WriterStr
+**
+*/
+void CJSON_WriterStr(CJSON_Writer_t *Writer, const char *Key, const char *Str)
+{
+
+   WriterMember(Writer, Key);
+   WriterStr(Writer, Str);
+   
+} /* End CJSON_WriterStr() */
+
+
+/******************************************************************************
+** Function: CJSON_WriterStats
+**
+*/
+void CJSON_WriterStats(CJSON_Writer_t *Writer, const char *Key)
+{
+
+   CJSON_Stats_t StatsCopy = Stats;
+   
+   CJSON_WriterBeginObj(Writer, Key);
+   CJSON_WriterUint(Writer, "file-cnt",      StatsCopy.FileCnt);
+   CJSON_WriterUint(Writer, "file-err-cnt",  StatsCopy.FileErrCnt);
+   CJSON_WriterUint(Writer, "file-char-cnt", StatsCopy.FileCharCnt);
+   CJSON_WriterUint(Writer, "max-file-len",  StatsCopy.MaxFileLen);
+   CJSON_WriterUint(Writer, "query-cnt",     StatsCopy.QueryCnt);
+   CJSON_WriterUint(Writer, "query-err-cnt", StatsCopy.QueryErrCnt);
+   CJSON_WriterEndObj(Writer);
+   
+} /* End CJSON_WriterStats() */
+
+
+/******************************************************************************
+** Function: CJSON_WriterUint
+**
+*/
+void CJSON_WriterUint(CJSON_Writer_t *Writer, const char *Key, uint64 Value)
+{
+
+   char    Str[WRITER_NUM_STR_LEN];
+   size_t  Len = FormatUint(Value, Str);
+   
+   WriterMember(Writer, Key);
+   WriterAppend(Writer, Str, Len);
+   
+} /* End CJSON_WriterUint() */
+
+
+/******************************************************************************
+** Function: AllocBuf
+**
+** Notes:
+**    1. Caller must hold the pool mutex. BufLen must not be 0 so each 
+**       borrowed buffer has a unique offset.
+**    2. First fit: the candidate offsets are the start of the arena and the
+**       end of each borrowed buffer, rounded up to a uint64 boundary, and 
+**       the lowest one that doesn't overlap a borrowed buffer is used.
+**
+*/
+static char* AllocBuf(size_t BufLen)
+{
+
+   char       *Buf = NULL;
+   BufBlock_t *FreeBlock = NULL;
+   size_t     i, j;
+   size_t     Offset, BestOffset = CJSON_BUF_POOL_CHAR;
+   bool       Fits;
+   
+   for (i=0; i < CJSON_BUF_POOL_MAX_BUFS; i++)
+   {
+      if (!BufPool.Block[i].InUse)
+      {
+         FreeBlock = &BufPool.Block[i];
+      }
+   }
+   
+   /* Candidate CJSON_BUF_POOL_MAX_BUFS is the start of the arena */
+   for (i=0; FreeBlock != NULL && i <= CJSON_BUF_POOL_MAX_BUFS; i++)
+   {
+      
+      if (i == CJSON_BUF_POOL_MAX_BUFS)
+      {
+         Offset = 0;
+         Fits   = true;
+      }
+      else
+      {
+         Offset = BufPool.Block[i].Offset + BufPool.Block[i].Len;
+         Offset = (Offset + sizeof(uint64) - 1) & ~(sizeof(uint64) - 1);
+         Fits   = BufPool.Block[i].InUse;
+      }
+      
+      Fits = (Fits && Offset < BestOffset && (Offset + BufLen) <= CJSON_BUF_POOL_CHAR);
+      for (j=0; Fits && j < CJSON_BUF_POOL_MAX_BUFS; j++)
+      {
+         if (BufPool.Block[j].InUse && Offset < (BufPool.Block[j].Offset + BufPool.Block[j].Len) &&
+             BufPool.Block[j].Offset < (Offset + BufLen))
+         {
+            Fits = false;
+         }
+      }
+      
+      if (Fits)
+      {
+         BestOffset = Offset;
+      }
+      
+   } /* End candidate loop */
+   
+   if (BestOffset < CJSON_BUF_POOL_CHAR)
+   {
+      FreeBlock->InUse    = true;
+      FreeBlock->FileLoad = false;
+      FreeBlock->Offset   = BestOffset;
+      FreeBlock->Len    = BufLen;
+      Buf = (char*)BufPool.Arena + BestOffset;
+   }
+   
+   return Buf;
+   
+} /* End AllocBuf() */
+
+
+/******************************************************************************
+** Function: CallerTaskIndex
+**
+** Notes:
+**    1. Returns true if the calling task's CFE_ES_TaskID_ToIndex() index 
+**       was written to TaskIndex.
+**
+*/
+static bool CallerTaskIndex(uint32* TaskIndex)
+{
+
+   CFE_ES_TaskId_t  TaskId;
+   
+   return (CFE_ES_GetTaskID(&TaskId) == CFE_SUCCESS &&
+           CFE_ES_TaskID_ToIndex(TaskId, TaskIndex) == CFE_SUCCESS);
+   
+} /* End CallerTaskIndex() */
+
+
+/******************************************************************************
+** Function: ClaimCursor
+**
+** Notes:
+**    1. Returns true if the calling task claimed the search cursor for 
+**       JsonBuf. The cursor is reset because JsonBuf was just loaded. A 
+**       task that can't claim it loads without a cursor rather than waiting
+**       for another task's callback.
+**
+*/
+static bool ClaimCursor(const char* JsonBuf)
+{
+
+   bool    RetStatus = false;
+   uint32  TaskIndex;
+   
+   if (Cursor.Created && CallerTaskIndex(&TaskIndex))
+   {
+   
+      OS_MutSemTake(Cursor.Mutex);
+      
+      if (!Cursor.Claimed)
+      {
+         Cursor.Claimed        = true;
+         Cursor.OwnerTaskIndex = TaskIndex;
+         Cursor.JsonBuf        = JsonBuf;
+         JSON_CursorInit(&Cursor.JsonCursor);
+         RetStatus = true;
+      }
+      
+      OS_MutSemGive(Cursor.Mutex);
+   
+   }
+   
+   return RetStatus;
+   
+} /* End ClaimCursor() */
+
+
+/******************************************************************************
+** Function: CompileQuery
+**
+** Notes:
+**    1. Compiles Query's key into its compact parts. PartCnt is 0 and false
+**       is returned if the key can't be compiled, has more than 
+**       CJSON_MAX_QUERY_PARTS parts, or contains a wildcard.
+**
+*/
+static bool CompileQuery(CJSON_Query_t* Query)
+{
+
+   JSONQuery_t  Compiled;
+   size_t       i;
+   
+   Query->PartCnt = 0;
+   
+   if (JSON_QueryCompile(Query->Key, Query->KeyLen, &Compiled) == JSONSuccess &&
+       Compiled.wildcardCount == 0 && Compiled.partCount <= CJSON_MAX_QUERY_PARTS)
+   {
+      
+      for (i=0; i < Compiled.partCount; i++)
+      {
+         if (Compiled.parts[i].arrayIndex == JSON_QUERY_KEY)
+         {
+            Query->Part[i].Value     = Compiled.parts[i].keyHash;
+            Query->Part[i].KeyOffset = (uint8)Compiled.parts[i].keyOffset;
+            Query->Part[i].KeyLen    = (uint8)Compiled.parts[i].keyLength;
+         }
+         else
+         {
+            Query->Part[i].Value     = Compiled.parts[i].arrayIndex;
+            Query->Part[i].KeyOffset = 0;
+            Query->Part[i].KeyLen    = 0;
+         }
+      }
+      
+      Query->PartCnt = (uint8)Compiled.partCount;
+   
+   } /* End if compiled */
+   
+   return (Query->PartCnt > 0);
+
+} /* End CompileQuery() */
+
+
+/******************************************************************************
+** Function: CountFile
+**
+** Notes:
+**    1. Called once per CJSON_ProcessFile*() call with the number of
+**       characters read and whether the file was loaded.
+**
+*/
+static void CountFile(size_t FileLen, bool Loaded)
+{
+
+   Stats.FileCnt++;
+   Stats.FileCharCnt += FileLen;
+   
+   if (!Loaded)
+   {
+      Stats.FileErrCnt++;
+   }
+   
+   if (FileLen > Stats.MaxFileLen)
+   {
+      Stats.MaxFileLen = (uint32)FileLen;
+   }
+   
+} /* End CountFile() */
+
+
+/******************************************************************************
+** Function: DecodeArray
+**
+** Notes:
+**    1. Decodes each element of a JSON array into the object's consecutive
+**       NumType elements in one iteration. See CJSON_ArrayObjConstructor().
+**    2. ArrayCnt is only changed when every element is decoded.
+**
+*/
+static bool DecodeArray(CJSON_Obj_t* Obj, const char* Value, size_t ValueLen, JSONTypes_t ValueType)
+{
+   
+   bool        RetStatus = false;
+   size_t      Start = 0, Next = 0;
+   size_t      ElementCnt = 0;
+   size_t      ElementSize, MaxElementCnt;
+   JSONPair_t  Element;
+   JSONNumberType_t NumType = ObjNumType(Obj);
+   
+   if (ValueType != JSONArray)
+   {
+   
+      CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "JSON %s returned for array %s", JsonTypeStr[ValueType], Obj->Query.Key);
+   
+   }
+   else if ((uint32)NumType > (uint32)JSONNumDouble)
+   {
+   
+      CFE_EVS_SendEvent(CJSON_INTERNAL_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid number type %d for array %s", (int)NumType, Obj->Query.Key);
+   
+   }
+   else
+   {
+      
+      RetStatus     = true;
+      ElementSize   = NumTypeSize[NumType];
+      MaxElementCnt = Obj->TblDataLen / ElementSize;
+      
+      while (RetStatus && JSON_Iterate(Value, ValueLen, &Start, &Next, &Element) == JSONSuccess)
+      {
+      
+         if (ElementCnt < MaxElementCnt)
+         {
+            RetStatus = DecodeValue((uint8*)Obj->TblData + (ElementCnt * ElementSize), ElementSize, JSONNumber,
+                                    NumType, CJSON_STR_COPY, Obj->Query.Key, Element.value,
+                                    Element.valueLength, Element.jsonType);
+            ElementCnt++;
+         }
+         else
+         {
+            RetStatus = false;
+            CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "JSON array %s has more than the %d elements that can be loaded",
+                              Obj->Query.Key, (unsigned int)MaxElementCnt);
+         }
+      
+      } /* End element loop */
+      
+      if (RetStatus)
+      {
+         Obj->ArrayCnt = ElementCnt;
+      }
+      
+   } /* End if valid array */
+   
+   return RetStatus;
+   
+} /* End DecodeArray() */
+
+
+/******************************************************************************
+** Function: DecodeNumber
+**
+** Notes:
+**    1. Decodes a number in place with JSON_NumberDecode(). Integers may be
+**       loaded into 1 or 2 byte table data when the value fits.
+**
+*/
+static bool DecodeNumber(void* TblData, size_t TblDataLen, JSONNumberType_t NumType, const char* Name,
+                         const char* Value, size_t ValueLen)
+{
+   
+   bool          RetStatus = false;
+   bool          Narrow;
+   int64         IntValue = 0;
+   int8          Int8Value;
+   int16         Int16Value;
+   JSONStatus_t  JsonStatus;
+   
+   Narrow = ((NumType == JSONNumInt32 || NumType == JSONNumUint32) && 
+             (TblDataLen == sizeof(int8) || TblDataLen == sizeof(int16)));
+   
+   if ((uint32)NumType > (uint32)JSONNumDouble || (TblDataLen < NumTypeSize[NumType] && !Narrow))
+   {
+   
+      CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "JSON number %s table data length %d is less than its type's size", 
+                        Name, (unsigned int)TblDataLen);
+   
+   }
+   else if (Narrow)
+   {
+   
+      /* Accept either the signed or unsigned range of the narrow field */
+      JsonStatus = JSON_NumberDecode(Value, ValueLen, JSONNumInt64, &IntValue);
+      if (JsonStatus == JSONSuccess &&
+          (IntValue < -(((int64)1) << (8*TblDataLen-1)) || IntValue >= (((int64)1) << (8*TblDataLen))))
+      {
+         JsonStatus = JSONOutOfRange;
+      }
+      
+      if (JsonStatus == JSONSuccess)
+      {
+         if (TblDataLen == sizeof(int8))
+         {
+            Int8Value = (int8)IntValue;
+            memcpy(TblData, &Int8Value, sizeof(int8));
+         }
+         else
+         {
+            Int16Value = (int16)IntValue;
+            memcpy(TblData, &Int16Value, sizeof(int16));
+         }
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "CJSON number conversion error for %s value %.*s. Status = %s",
+                           Name, (int)ValueLen, Value, JsonStatusStr[JsonStatus]);
+      }
+      
+   } /* End if narrow integer */
+   else
+   {
+   
+      JsonStatus = JSON_NumberDecode(Value, ValueLen, NumType, TblData);
+      
+      if (JsonStatus == JSONSuccess)
+      {
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "CJSON number conversion error for %s value %.*s. Status = %s",
+                           Name, (int)ValueLen, Value, JsonStatusStr[JsonStatus]);
+      }
+   
+   }
+   
+   return RetStatus;
+   
+} /* End DecodeNumber() */
+
+
+/******************************************************************************
+** Function: DecodeString
+**
+** Notes:
+**    1. Loads a string value, without its quotes, into TblData as selected
+**       by StrMode. See CJSON_StrObjConstructor().
+**    2. Copied strings are terminated so TblDataLen must exceed the string's
+**       length. 
+**
+*/
+static bool DecodeString(void* TblData, size_t TblDataLen, CJSON_StrMode_t StrMode, const char* Name,
+                         const char* Value, size_t ValueLen)
+{
+   
+   bool             RetStatus = false;
+   JSONStatus_t     JsonStatus;
+   CJSON_StrView_t  *StrView;
+   
+   switch (StrMode)
+   {
+      
+      case CJSON_STR_COPY:
+      
+         if (ValueLen < TblDataLen)
+         {
+            memcpy(TblData, Value, ValueLen);
+            ((char*)TblData)[ValueLen] = '\0';
+            RetStatus = true;
+         }
+         else
+         {
+            CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR, 
+                              "JSON string length %d exceeds %s's max length %d", 
+                              (unsigned int)ValueLen, Name, (unsigned int)(TblDataLen-1));
+         }
+         break;
+      
+      case CJSON_STR_UNESCAPE:
+      
+         JsonStatus = JSON_StringUnescape(Value, ValueLen, (char*)TblData, TblDataLen, NULL);
+         
+         if (JsonStatus == JSONSuccess)
+         {
+            RetStatus = true;
+         }
+         else
+         {
+            CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR, 
+                              "JSON string for %s can't be decoded into %d characters. Status = %s.", 
+                              Name, (unsigned int)(TblDataLen-1), JsonStatusStr[JsonStatus]);
+         }
+         break;
+         
+      case CJSON_STR_VIEW:
+      
+         if (TblDataLen >= sizeof(CJSON_StrView_t))
+         {
+            StrView = (CJSON_StrView_t*)TblData;
+            StrView->Str     = Value;
+            StrView->Len     = ValueLen;
+            StrView->Escaped = (memchr(Value, '\\', ValueLen) != NULL);
+            RetStatus = true;
+         }
+         else
+         {
+            CFE_EVS_SendEvent(CJSON_INTERNAL_ERR_EID, CFE_EVS_EventType_ERROR, 
+                              "String view for %s has length %d, a CJSON_StrView_t is %d", 
+                              Name, (unsigned int)TblDataLen, (unsigned int)sizeof(CJSON_StrView_t));
+         }
+         break;
+         
+      default:
+      
+         CFE_EVS_SendEvent(CJSON_INTERNAL_ERR_EID, CFE_EVS_EventType_ERROR, 
+                           "Invalid string mode %d for %s", (int)StrMode, Name);
+   
+   } /* End StrMode switch */
+   
+   return RetStatus;
+   
+} /* End DecodeString() */
+
+
+/******************************************************************************
+** Function: DecodeValue
+**
+** Notes:
+**    1. Decodes a value that has been located in the JSON buffer into 
+**       TblData. Name identifies the value in event messages.
+**    2. A string is decoded as a number when TblType is JSONNumber so hex
+**       integers can be written as strings. 
+**    3. A TblType of JSONTrue is a bool that is only loaded from a JSON true
+**       or false value.
+**
+*/
+static bool DecodeValue(void* TblData, size_t TblDataLen, JSONTypes_t TblType, JSONNumberType_t NumType,
+                        CJSON_StrMode_t StrMode, const char* Name, const char* Value, size_t ValueLen,
+                        JSONTypes_t ValueType)
+{
+   
+   bool         RetStatus = false;
+   bool         BoolValue;
+   
+   CFE_EVS_SendEvent(CJSON_LOAD_OBJ_EID, CFE_EVS_EventType_DEBUG,
+                     "CJSON_LoadObj: Type=%s, Value=%s, Len=%d",
+                     JsonTypeStr[ValueType], Value, (unsigned int)ValueLen);
+
+   switch (ValueType)
+   {
+      
+      case JSONTrue:
+      case JSONFalse:
+      
+         if (TblType != JSONTrue)
+         {
+            CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "JSON boolean returned for %s %s", JsonTypeStr[TblType], Name);
+         }
+         else if (TblDataLen < sizeof(bool))
+         {
+            CFE_EVS_SendEvent(CJSON_INTERNAL_ERR_EID, CFE_EVS_EventType_ERROR, 
+                              "Boolean %s has length %d, a bool is %d", 
+                              Name, (unsigned int)TblDataLen, (unsigned int)sizeof(bool));
+         }
+         else
+         {
+            BoolValue = (ValueType == JSONTrue);
+            memcpy(TblData, &BoolValue, sizeof(bool));
+            RetStatus = true;
+         }
+         break;
+         
+      case JSONString:
+      
+         if (TblType == JSONNumber)
+         {
+            RetStatus = DecodeNumber(TblData, TblDataLen, NumType, Name, Value, ValueLen);
+         }
+         else if (TblType == JSONTrue)
+         {
+            CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "JSON string returned for boolean %s", Name);
+         }
+         else
+         {
+            RetStatus = DecodeString(TblData, TblDataLen, StrMode, Name, Value, ValueLen);
+         }
+         break;
+
+      case JSONNumber:
+         
+         if (TblType == JSONString || TblType == JSONTrue)
+         {
+            CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "JSON number returned for %s %s", 
+                              (TblType == JSONString ? "string" : "boolean"), Name);
+         }
+         else
+         {
+            RetStatus = DecodeNumber(TblData, TblDataLen, NumType, Name, Value, ValueLen);
+         }
+         break;
+
+      case JSONArray:
+      
+         CFE_EVS_SendEvent(CJSON_LOAD_OBJ_EID, CFE_EVS_EventType_INFORMATION,
+                           "JSON array %s, len = %d", Value, (unsigned int)ValueLen);
+         PrintJsonBuf(Value, ValueLen);
+      
+         break;
+
+      case JSONObject:
+      
+         CFE_EVS_SendEvent(CJSON_LOAD_OBJ_EID, CFE_EVS_EventType_INFORMATION,
+                           "JSON array %s, len = %d", Value, (unsigned int)ValueLen);
+         PrintJsonBuf(Value, ValueLen);
+      
+         break;
+
+      default:
+      
+         CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Unsupported JSON type %s returned for query %s", 
+                           JsonTypeStr[ValueType], Name);
+   } /* End ValueType switch */
+         
+   return RetStatus;
+   
+} /* End DecodeValue() */
+
+
+/******************************************************************************
+** Function: ExpandQuery
+**
+** Notes:
+**    1. Expands a compiled CJSON_Query_t into the JSONQuery_t used by the
+**       core_json compiled searches. Query->PartCnt must not be 0.
+**
+*/
+static void ExpandQuery(const CJSON_Query_t* Query, JSONQuery_t* Compiled)
+{
+
+   size_t i;
+   
+   Compiled->partCount     = Query->PartCnt;
+   Compiled->wildcardCount = 0;
+   
+   for (i=0; i < Query->PartCnt; i++)
+   {
+      ExpandQueryPart(&Query->Part[i], &Compiled->parts[i]);
+   }
+
+} /* End ExpandQuery() */
+
+
+/******************************************************************************
+** Function: ExpandQueryPart
+**
+*/
+static void ExpandQueryPart(const CJSON_QueryPart_t* QueryPart, JSONQueryPart_t* Part)
+{
+
+   if (QueryPart->KeyLen > 0)
+   {
+      Part->keyHash    = QueryPart->Value;
+      Part->arrayIndex = JSON_QUERY_KEY;
+   }
+   else
+   {
+      Part->keyHash    = 0;
+      Part->arrayIndex = QueryPart->Value;
+   }
+   Part->keyOffset = QueryPart->KeyOffset;
+   Part->keyLength = QueryPart->KeyLen;
+
+} /* End ExpandQueryPart() */
+
+
+/******************************************************************************
+** Function: FormatUint
+**
+** Notes:
+**    1. Writes Value's decimal digits to Str without a terminator and 
+**       returns the number of digits. Str must hold 20 characters.
+**
+*/
+static size_t FormatUint(uint64 Value, char* Str)
+{
+
+   char    Digits[20];
+   size_t  i = sizeof(Digits);
+   size_t  Len;
+   
+   do
+   {
+      Digits[--i] = (char)('0' + (Value % 10));
+      Value /= 10;
+   } while (Value > 0);
+   
+   Len = sizeof(Digits) - i;
+   memcpy(Str, &Digits[i], Len);
+   
+   return Len;
+   
+} /* End FormatUint() */
+
+
+/******************************************************************************
+** Function: HashPath
+**
+** Notes:
+**    1. Continues Hash, the FNV-1a hash of a path, over StrLen more 
+**       characters. PATH_HASH_SEED is the hash of an empty path.
+**
+*/
+static uint32 HashPath(uint32 Hash, const char* Str, size_t StrLen)
+{
+
+   size_t i;
+   
+   for (i=0; i < StrLen; i++)
+   {
+      Hash = (Hash ^ (uint8)Str[i]) * PATH_HASH_PRIME;
+   }
+   
+   return Hash;
+   
+} /* End HashPath() */
+
+
+/******************************************************************************
+** Function: IndexObjArray
+**
+** Notes:
+**    1. Prepares ObjArrayLoad to load its Obj[], which must not have more 
+**       than CJSON_MAX_STAGED_OBJ objects. Each query key's hash selects its
+**       bucket and the hash of the key up to each '.' or '[' after its first
+**       character is added to the prefix filter.
+**    2. Objects are chained from the last to the first so each bucket lists
+**       its objects in Obj[] order.
+**
+*/
+static void IndexObjArray(ObjArrayLoad_t* ObjArrayLoad)
+{
+
+   size_t  i, j;
+   uint32  Hash;
+   const CJSON_Query_t *Query;
+   
+   ObjArrayLoad->ObjPendingCnt = ObjArrayLoad->ObjCnt;
+   ObjArrayLoad->Path[0]       = '\0';
+   memset(ObjArrayLoad->Bucket, 0, sizeof(ObjArrayLoad->Bucket));
+   memset(ObjArrayLoad->Prefix, 0, sizeof(ObjArrayLoad->Prefix));
+   memset(ObjArrayLoad->Found, 0, sizeof(ObjArrayLoad->Found));
+   
+   for (i=ObjArrayLoad->ObjCnt; i > 0; i--)
+   {
+      
+      Query = &ObjArrayLoad->Obj[i-1].Query;
+      Hash  = PATH_HASH_SEED;
+      
+      for (j=0; j < Query->KeyLen; j++)
+      {
+         if (j > 0 && (Query->Key[j] == '.' || Query->Key[j] == '['))
+         {
+            ObjArrayLoad->Prefix[(Hash % OBJ_ARRAY_PREFIX_BITS)/32] |= (1U << ((Hash % OBJ_ARRAY_PREFIX_BITS) % 32));
+         }
+         Hash = HashPath(Hash, &Query->Key[j], 1);
+      }
+      
+      ObjArrayLoad->Next[i-1] = ObjArrayLoad->Bucket[Hash % OBJ_ARRAY_HASH_LEN];
+      ObjArrayLoad->Bucket[Hash % OBJ_ARRAY_HASH_LEN] = (uint16)i;
+      
+   } /* End object loop */
+   
+} /* End IndexObjArray() */
+
+
+/******************************************************************************
+** Function: LoadObj
+**
+** Notes:
+**    1. If Index is not NULL it must be a structural index of Buf and it is
+**       used to locate the object's value instead of searching Buf.
+**    2. When called from the task's CJSON_ProcessFile*() callback for Buf,
+**       compiled queries are searched with the task's search cursor so 
+**       ascending indexed keys such as "tbl[i].x" resume from the previous
+**       element.
+**    3. A compiled query is expanded into a JSONQuery_t on the stack for
+**       the core_json compiled searches.
+**
+*/
+static bool LoadObj(CJSON_Obj_t* Obj, const char* Buf, size_t BufLen, const JSONIndex_t* Index,
+                    OBJ_Necessity_t Necessity)
+{
+   
+   bool         RetStatus = false;
+   JSONStatus_t JsonStatus;
+   const char   *Value;
+   size_t       ValueLen;
+   JSONTypes_t  ValueType;
+   JSONCursor_t *JsonCursor;
+   JSONQuery_t  Compiled;
+   
+   Obj->Updated = false;
+   Stats.QueryCnt++;
+      
+   if (Obj->Query.PartCnt > 0)
+   {
+      ExpandQuery(&Obj->Query, &Compiled);
+      if (Index != NULL)
+      {
+         JsonStatus = JSON_IndexSearchCompiled(Index, Obj->Query.Key, &Compiled,
+                                               &Value, &ValueLen, &ValueType);
+      }
+      else if ((JsonCursor = OwnedCursor(Buf)) != NULL)
+      {
+         JsonStatus = JSON_SearchCursor(Buf, BufLen, Obj->Query.Key, &Compiled, JsonCursor,
+                                        &Value, &ValueLen, &ValueType);
+      }
+      else
+      {
+         JsonStatus = JSON_SearchCompiled(Buf, BufLen, Obj->Query.Key, &Compiled,
+                                          &Value, &ValueLen, &ValueType);
+      }
+   }
+   else if (Index != NULL)
+   {
+      JsonStatus = JSON_IndexSearch(Index, Obj->Query.Key, Obj->Query.KeyLen,
+                                    &Value, &ValueLen, &ValueType);
+   }
+   else
+   {
+      JsonStatus = JSON_SearchConst(Buf, BufLen, 
+                                    Obj->Query.Key, Obj->Query.KeyLen,
+                                    &Value, &ValueLen, &ValueType);
+   }
+                                 
+   if (JsonStatus == JSONSuccess)
+   {
+   
+      RetStatus = LoadObjValue(Obj, Value, ValueLen, ValueType);
+      
+   }/* End if successful search */
+   else 
+   {
+   
+      Stats.QueryErrCnt++;
+      
+      if (Necessity == OBJ_REQUIRED)
+      {
+         CFE_EVS_SendEvent(CJSON_LOAD_OBJ_EID, CFE_EVS_EventType_INFORMATION,
+                           "JSON search error for query %s. Status = %s.", 
+                           Obj->Query.Key, JsonStatusStr[JsonStatus]);
+      }
+   }
+         
+   return RetStatus;
+   
+} /* End LoadObj() */
+
+
+/******************************************************************************
+** Function: LoadObjArrayCollection
+**
+** Notes:
+**    1. Iterates over the members of the JSON object or array that starts at
+**       CollectionStart. Path[0..PathLen) contains the collection's query
+**       form and PathHash is its hash.
+**
+*/
+static void LoadObjArrayCollection(ObjArrayLoad_t* ObjArrayLoad, size_t CollectionStart, size_t PathLen,
+                                   uint32 PathHash)
+{
+
+   size_t       Start = CollectionStart;
+   size_t       Next  = 0;
+   uint32       Index = 0, Digits;
+   size_t       SegLen, MemberPathLen;
+   char         IndexStr[QUERY_INDEX_STR_LEN];
+   int          i;
+   JSONPair_t   Pair;
+   
+   while ((ObjArrayLoad->ObjPendingCnt > 0) &&
+          (JSON_Iterate(ObjArrayLoad->Buf, ObjArrayLoad->BufLen, &Start, &Next, &Pair) == JSONSuccess))
+   {
+   
+      MemberPathLen = 0;
+      
+      if (Pair.key == NULL)
+      {
+         
+         /* Array element: append "[Index]", digits are generated in reverse */
+         i = QUERY_INDEX_STR_LEN;
+         IndexStr[--i] = ']';
+         Digits = Index++;
+         do
+         {
+            IndexStr[--i] = '0' + (Digits % 10);
+            Digits /= 10;
+         } while (Digits > 0);
+         IndexStr[--i] = '[';
+
+         SegLen = QUERY_INDEX_STR_LEN - i;
+         if ((PathLen + SegLen) <= CJSON_MAX_KEY_LEN)
+         {
+            memcpy(&ObjArrayLoad->Path[PathLen], &IndexStr[i], SegLen);
+            MemberPathLen = PathLen + SegLen;
+         }
+      
+      }
+      else
+      {
+         
+         /* Object member: append ".key", the root's members have no separator */
+         SegLen = Pair.keyLength + ((PathLen > 0) ? 1 : 0);
+         if ((PathLen + SegLen) <= CJSON_MAX_KEY_LEN)
+         {
+            if (PathLen > 0)
+            {
+               ObjArrayLoad->Path[PathLen] = '.';
+            }
+            memcpy(&ObjArrayLoad->Path[PathLen + SegLen - Pair.keyLength], Pair.key, Pair.keyLength);
+            MemberPathLen = PathLen + SegLen;
+         }
+
+      }
+
+      /* A path longer than the maximum key length can't match any query */
+      if (MemberPathLen > 0)
+      {
+         LoadObjArrayValue(ObjArrayLoad, &Pair, MemberPathLen, 
+                           HashPath(PathHash, &ObjArrayLoad->Path[PathLen], MemberPathLen - PathLen));
+      }
+      
+   } /* End member loop */
+   
+} /* End LoadObjArrayCollection() */
+
+
+/******************************************************************************
+** Function: LoadObjArrayFused
+**
+** Notes:
+**    1. Validates Buf and locates each object's value in a single traversal.
+**       Nothing is written to the objects unless Buf is valid JSON.
+**    2. Objects without a compiled query are loaded with a search after Buf
+**       has been validated.
+**    3. Returns the validation status. Load errors are reported by events
+**       and each object's Updated flag.
+**
+*/
+static JSONStatus_t LoadObjArrayFused(CJSON_Obj_t* Obj, size_t ObjCnt, const char* Buf, size_t BufLen)
+{
+
+   JSONStatus_t     JsonStatus;
+   ObjArrayFused_t  ObjArrayFused;
+   ObjStage_t       *Stage;
+   const char       *Value;
+   size_t           i;
+
+   
+   if (ObjCnt > CJSON_MAX_STAGED_OBJ)
+   {
+      
+      JsonStatus = JSON_Validate(Buf, BufLen);
+      if (JsonStatus == JSONSuccess)
+      {
+         CJSON_LoadObjArray(Obj, ObjCnt, Buf, BufLen);
+      }
+      
+   } /* End if too many objects to stage */
+   else
+   {
+      
+      ObjArrayFused.Obj    = Obj;
+      ObjArrayFused.ObjCnt = ObjCnt;
+      memset(ObjArrayFused.Stage, 0, sizeof(ObjArrayFused.Stage));
+      
+      JsonStatus = JSON_ValidateVisit(Buf, BufLen, LoadObjArrayVisit, &ObjArrayFused);
+
+      if (JsonStatus == JSONSuccess)
+      {
+         
+         for (i=0; i < ObjCnt; i++)
+         {
+         
+            Stage = &ObjArrayFused.Stage[i];
+            
+            if (Stage->Staged)
+            {
+               
+               Obj[i].Updated = false;
+               Value = &Buf[Stage->Value];
+               
+               if (Stage->Type == JSONString)
+               {
+                  /* Strip the surrounding quotes */
+                  Value++;
+                  Stage->ValueLen -= 2;
+               }
+               
+               LoadObjValue(&Obj[i], Value, Stage->ValueLen, Stage->Type);
+            
+            }
+            else if (Obj[i].Query.PartCnt > 0)
+            {
+               
+               Obj[i].Updated = false;
+               CFE_EVS_SendEvent(CJSON_LOAD_OBJ_EID, CFE_EVS_EventType_INFORMATION,
+                                 "JSON search error for query %s. Status = %s.", 
+                                 Obj[i].Query.Key, JsonStatusStr[JSONNotFound]);
+            }
+            else
+            {
+               
+               LoadObj(&Obj[i], Buf, BufLen, NULL, OBJ_REQUIRED);
+            
+            }
+         
+         } /* End object loop */
+      } /* End if valid JSON */
+   } /* End if objects can be staged */
+   
+   return JsonStatus;
+   
+} /* End LoadObjArrayFused() */
+
+
+/******************************************************************************
+** Function: LoadObjArrayStreamVisit
+**
+** Notes:
+**    1. JSON_StreamParse() callback that loads each object's value as soon
+**       as it is parsed because Buf, the stream's window, only holds the
+**       current value. See MatchQuery() for how values are matched.
+**    2. If a key appears more than once the first occurrence is loaded.
+**
+*/
+static void LoadObjArrayStreamVisit(void* Context, const char* Buf, const JSONVisit_t* Visit)
+{
+
+   ObjArrayFused_t  *ObjArrayStream = (ObjArrayFused_t*)Context;
+   ObjStage_t       *Stage;
+   CJSON_Obj_t      *Obj;
+   size_t           i;
+   
+   for (i=0; i < ObjArrayStream->ObjCnt; i++)
+   {
+   
+      Obj   = &ObjArrayStream->Obj[i];
+      Stage = &ObjArrayStream->Stage[i];
+      
+      if (!Stage->Staged && MatchQuery(NULL, &Obj->Query, Obj->Query.Key, Stage, Buf, Visit))
+      {
+         
+         Stage->Staged = true;
+         
+         if (Visit->jsonType == JSONObject || Visit->jsonType == JSONArray ||
+             (Visit->jsonType == JSONString && Obj->StrMode == CJSON_STR_VIEW))
+         {
+            /* A view would point into the stream's window */
+            CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "JSON %s for query %s can't be loaded from a stream", 
+                              JsonTypeStr[Visit->jsonType], Obj->Query.Key);
+         }
+         else if (Visit->jsonType == JSONString)
+         {
+            /* Strip the surrounding quotes */
+            LoadObjValue(Obj, &Buf[Visit->value+1], Visit->valueLength-2, JSONString);
+         }
+         else
+         {
+            LoadObjValue(Obj, &Buf[Visit->value], Visit->valueLength, Visit->jsonType);
+         }
+      
+      } /* End if object's value */
+   } /* End object loop */
+   
+} /* End LoadObjArrayStreamVisit() */
+
+
+/******************************************************************************
+** Function: LoadObjArrayValue
+**
+** Notes:
+**    1. Path[0..PathLen) contains the value's query form and PathHash is its
+**       hash. The value is loaded into every pending object in PathHash's
+**       bucket with a matching query key and collections are only traversed
+**       when a query key may be nested within them.
+**
+*/
+static void LoadObjArrayValue(ObjArrayLoad_t* ObjArrayLoad, const JSONPair_t* Pair, size_t PathLen,
+                              uint32 PathHash)
+{
+
+   size_t       i;
+   CJSON_Obj_t  *Obj;
+   
+   for (i=ObjArrayLoad->Bucket[PathHash % OBJ_ARRAY_HASH_LEN]; i > 0; i=ObjArrayLoad->Next[i-1])
+   {
+      
+      Obj = &ObjArrayLoad->Obj[i-1];
+      
+      if ((!Obj->Updated) && (Obj->Query.KeyLen == PathLen) &&
+          (memcmp(Obj->Query.Key, ObjArrayLoad->Path, PathLen) == 0))
+      {
+         ObjArrayLoad->Found[i-1] = true;
+         if (LoadObjValue(Obj, Pair->value, Pair->valueLength, Pair->jsonType))
+         {
+            ObjArrayLoad->ObjPendingCnt--;
+            ObjArrayLoad->ObjLoadCnt++;
+         }
+      }
+   }
+
+   if ((Pair->jsonType == JSONObject || Pair->jsonType == JSONArray) &&
+       PathIsQueryPrefix(ObjArrayLoad, PathHash))
+   {
+      LoadObjArrayCollection(ObjArrayLoad, (Pair->value - ObjArrayLoad->Buf), PathLen, PathHash);
+   }
+   
+} /* End LoadObjArrayValue() */
+
+
+/******************************************************************************
+** Function: LoadObjArrayVisit
+**
+** Notes:
+**    1. JSON_ValidateVisit() callback that stages each object's value. See
+**       MatchQuery() for how values are matched.
+**    2. A collection's length isn't known until it closes so a staged
+**       collection's length is filled in by its close visit.
+**    3. If a key appears more than once the first occurrence is staged.
+**
+*/
+static void LoadObjArrayVisit(void* Context, const char* Buf, const JSONVisit_t* Visit)
+{
+
+   ObjArrayFused_t  *ObjArrayFused = (ObjArrayFused_t*)Context;
+   ObjStage_t       *Stage;
+   size_t           i;
+   
+   for (i=0; i < ObjArrayFused->ObjCnt; i++)
+   {
+   
+      Stage = &ObjArrayFused->Stage[i];
+      
+      if (Stage->Staged)
+      {
+         if (Stage->ValueLen == 0 && Stage->Value == Visit->value)
+         {
+            Stage->ValueLen = (uint32)Visit->valueLength;
+         }
+      }
+      else if (MatchQuery(NULL, &ObjArrayFused->Obj[i].Query, ObjArrayFused->Obj[i].Query.Key,
+                          Stage, Buf, Visit))
+      {
+         Stage->Staged   = true;
+         Stage->Value    = (uint32)Visit->value;
+         Stage->ValueLen = (uint32)Visit->valueLength;
+         Stage->Type     = Visit->jsonType;
+      }
+      
+   } /* End object loop */
+   
+} /* End LoadObjArrayVisit() */
+
+
+/******************************************************************************
+** Function: LoadObjValue
+**
+** Notes:
+**    1. Loads a value that has been located in the JSON buffer into the
+**       object's table data. Shared by the search and single pass loaders.
+**
+*/
+static bool LoadObjValue(CJSON_Obj_t* Obj, const char* Value, size_t ValueLen, JSONTypes_t ValueType)
+{
+   
+   bool RetStatus;
+   
+   if (Obj->Type == JSONArray)
+   {
+      RetStatus = DecodeArray(Obj, Value, ValueLen, ValueType);
+   }
+   else
+   {
+      RetStatus = DecodeValue(Obj->TblData, Obj->TblDataLen, Obj->Type, ObjNumType(Obj), 
+                              Obj->StrMode, Obj->Query.Key, Value, ValueLen, ValueType);
+   }
+   
+   if (RetStatus)
+   {
+      Obj->Updated = true;
+   }
+   
+   return RetStatus;
+   
+} /* End LoadObjValue() */
+
+
+/******************************************************************************
+** Function: LocateObjArray
+**
+** Notes:
+**    1. Validates Buf and records the location of each object's value in
+**       ObjLoc[] using the same traversal as LoadObjArrayFused(). Values are
+**       decoded later by CJSON_LoadObjLoc().
+**    2. Objects without a compiled query are located with a search after 
+**       Buf has been validated.
+**    3. ObjCnt must not exceed CJSON_MAX_STAGED_OBJ.
+**    4. Objects that aren't located aren't reported because the caller may
+**       be locating optional values. See ObjLoc[].Located.
+**
+*/
+static JSONStatus_t LocateObjArray(CJSON_Obj_t* Obj, size_t ObjCnt, const char* Buf, size_t BufLen,
+                                   CJSON_ObjLoc_t* ObjLoc)
+{
+
+   JSONStatus_t     JsonStatus;
+   ObjArrayFused_t  ObjArrayFused;
+   ObjStage_t       *Stage;
+   const char       *Value;
+   size_t           ValueLen;
+   JSONTypes_t      ValueType;
+   size_t           i;
+
+   ObjArrayFused.Obj    = Obj;
+   ObjArrayFused.ObjCnt = ObjCnt;
+   memset(ObjArrayFused.Stage, 0, sizeof(ObjArrayFused.Stage));
+      
+   JsonStatus = JSON_ValidateVisit(Buf, BufLen, LoadObjArrayVisit, &ObjArrayFused);
+
+   if (JsonStatus == JSONSuccess)
+   {
+         
+      for (i=0; i < ObjCnt; i++)
+      {
+         
+         Stage = &ObjArrayFused.Stage[i];
+         memset(&ObjLoc[i], 0, sizeof(CJSON_ObjLoc_t));
+         
+         if (Stage->Staged)
+         {
+            
+            ObjLoc[i].Value    = Stage->Value;
+            ObjLoc[i].ValueLen = Stage->ValueLen;
+            ObjLoc[i].Type     = Stage->Type;
+            ObjLoc[i].Located  = true;
+            
+            if (Stage->Type == JSONString)
+            {
+               /* Strip the surrounding quotes */
+               ObjLoc[i].Value++;
+               ObjLoc[i].ValueLen -= 2;
+            }
+         
+         }
+         else if ((Obj[i].Query.PartCnt == 0) &&
+                  (JSON_SearchConst(Buf, BufLen, Obj[i].Query.Key, Obj[i].Query.KeyLen,
+                                    &Value, &ValueLen, &ValueType) == JSONSuccess))
+         {
+            
+            ObjLoc[i].Value    = (uint32)(Value - Buf);
+            ObjLoc[i].ValueLen = (uint32)ValueLen;
+            ObjLoc[i].Type     = ValueType;
+            ObjLoc[i].Located  = true;
+         
+         }
+         
+      } /* End object loop */
+   } /* End if valid JSON */
+   
+   return JsonStatus;
+   
+} /* End LocateObjArray() */
+
+
+/******************************************************************************
+** Function: MatchQuery
+**
+** Notes:
+**    1. Returns true if Visit reports the value of the compiled query. 
+**       Visits must be passed in document order and Stage->MatchDepth must
+**       be zero before the first visit.
+**    2. A value at depth D extends the match of a query whose first D-1
+**       parts matched the value's ancestors. A value's siblings are visited
+**       after its members so matches deeper than D-1 belong to a previous
+**       sibling and are discarded first.
+**    3. A JSON_QUERY_ANY_INDEX part matches every array element and the
+**       matched element's index is saved in Stage->Element.
+**    4. A collection is matched when it opens. Close visits are ignored.
+**    5. The query is either a core_json Compiled query or an object's 
+**       ObjQuery. The other is NULL. Only the ObjQuery part being matched
+**       is expanded.
+**
+*/
+static bool MatchQuery(const JSONQuery_t* Compiled, const CJSON_Query_t* ObjQuery, const char* Query,
+                       ObjStage_t* Stage, const char* Buf, const JSONVisit_t* Visit)
+{
+
+   bool    RetStatus = false;
+   bool    Close;
+   bool    Match;
+   size_t  PartCnt = (Compiled != NULL) ? Compiled->partCount : ObjQuery->PartCnt;
+   const JSONQueryPart_t *Part;
+   JSONQueryPart_t       ObjPart;
+   
+   Close = ((Visit->jsonType == JSONObject || Visit->jsonType == JSONArray) && Visit->valueLength > 0);
+   
+   if (!Close && Visit->depth > 0 && Visit->depth <= PartCnt)
+   {
+   
+      if (Stage->MatchDepth >= Visit->depth)
+      {
+         Stage->MatchDepth = Visit->depth - 1;
+      }
+      
+      if (Stage->MatchDepth == (Visit->depth - 1))
+      {
+      
+         if (Compiled != NULL)
+         {
+            Part = &Compiled->parts[Stage->MatchDepth];
+         }
+         else
+         {
+            ExpandQueryPart(&ObjQuery->Part[Stage->MatchDepth], &ObjPart);
+            Part = &ObjPart;
+         }
+         
+         if (Part->arrayIndex == JSON_QUERY_KEY)
+         {
+            Match = (Visit->key != 0 && Visit->keyLength == Part->keyLength &&
+                     strncmp(&Buf[Visit->key], &Query[Part->keyOffset], Part->keyLength) == 0);
+         }
+         else if (Part->arrayIndex == JSON_QUERY_ANY_INDEX)
+         {
+            Match = (Visit->key == 0);
+            Stage->Element = Visit->arrayIndex;
+         }
+         else
+         {
+            Match = (Visit->key == 0 && Visit->arrayIndex == Part->arrayIndex);
+         }
+         
+         if (Match)
+         {
+            Stage->MatchDepth = Visit->depth;
+            RetStatus = (Visit->depth == PartCnt);
+         }
+         
+      } /* End if ancestors matched */
+   } /* End if value within query's depth */
+   
+   return RetStatus;
+   
+} /* End MatchQuery() */
+
+
+/******************************************************************************
+** Function: ObjNumType
+**
+** Notes:
+**    1. Objects that are statically initialized by apps written before
+**       NumType was added set the deprecated TypeFlt and leave NumType 
+**       zero, which is JSONNumInt32. They're loaded as floats.
+**
+*/
+static JSONNumberType_t ObjNumType(const CJSON_Obj_t* Obj)
+{
+
+   return (Obj->TypeFlt && Obj->NumType == JSONNumInt32) ? JSONNumFloat : Obj->NumType;
+
+} /* End ObjNumType() */
+
+
+/******************************************************************************
+** Function: OwnedCursor
+**
+** Notes:
+**    1. Returns the search cursor if the calling task claimed it for Buf,
+**       otherwise NULL.
+**
+*/
+static JSONCursor_t* OwnedCursor(const char* Buf)
+{
+
+   JSONCursor_t  *JsonCursor = NULL;
+   uint32        TaskIndex;
+   
+   if (Cursor.Created && CallerTaskIndex(&TaskIndex))
+   {
+   
+      OS_MutSemTake(Cursor.Mutex);
+      
+      if (Cursor.Claimed && Cursor.OwnerTaskIndex == TaskIndex &&
+          Cursor.JsonBuf == Buf)
+      {
+         JsonCursor = &Cursor.JsonCursor;
+      }
+      
+      OS_MutSemGive(Cursor.Mutex);
+   
+   }
+   
+   return JsonCursor;
+   
+} /* End OwnedCursor() */
+
+
+/******************************************************************************
+** Function: PathIsQueryPrefix
+**
+** Notes:
+**    1. Returns true if an object's query key may continue beyond the path
+**       with an object key or an array index. A hash collision only costs
+**       an unnecessary traversal of the collection.
+**
+*/
+static bool PathIsQueryPrefix(const ObjArrayLoad_t* ObjArrayLoad, uint32 PathHash)
+{
+
+   uint32 Bit = PathHash % OBJ_ARRAY_PREFIX_BITS;
+   
+   return ((ObjArrayLoad->Prefix[Bit/32] & (1U << (Bit % 32))) != 0);
+   
+} /* End PathIsQueryPrefix() */
+
+
+/******************************************************************************
+** Function: PoolBlock
+**
+** Notes:
+**    1. Returns the borrowed block for Buf or NULL. Caller must hold the 
+**       pool mutex.
+**
+*/
+static BufBlock_t* PoolBlock(const char* Buf)
+{
+
+   BufBlock_t *Block = NULL;
+   size_t     i;
+   
+   for (i=0; Block == NULL && i < CJSON_BUF_POOL_MAX_BUFS; i++)
+   {
+      if (BufPool.Block[i].InUse && Buf == ((char*)BufPool.Arena + BufPool.Block[i].Offset))
+      {
+         Block = &BufPool.Block[i];
+      }
+   }
+   
+   return Block;
+   
+} /* End PoolBlock() */
+
+
+/******************************************************************************
+** Function: PrintJsonBuf
+**
+** Notes:
+**    1. OS_printf() limits the number of characters so this loops through
+**       printing 100 bytes per OS_printf() call
+**
+*/
+static void PrintJsonBuf(const char* JsonBuf, size_t BufLen)
+{
+   
+   int  i = 0;
+   char PrintBuf[PRINT_BUF_SEGMENT_BYTES+1];
+   
+   OS_printf("\n>>> JSON table file buffer:\n");
+   for (i=0; i < BufLen; i += PRINT_BUF_SEGMENT_BYTES)
+   {
+      
+      strncpy(PrintBuf, &JsonBuf[i], PRINT_BUF_SEGMENT_BYTES);
+      PrintBuf[PRINT_BUF_SEGMENT_BYTES] = '\0';
+      OS_printf("%s",PrintBuf); 
+      
+   }
+   OS_printf("\n");
+   
+} /* End PrintJsonBuf() */
+
+
+/******************************************************************************
+** Function: ProcessFile
+**
+** Notes:
+**  1. Entire JSON file is read into memory
+**  2. User callback function LoadJsonData() or LoadJsonDataAlt() calls 
+**     a CJSON_LoadObj*() method to load the JSON data into the user's table. 
+**     The user's callback function can perform table-specific procesing such  
+**     as validation prior to loading the table data.
+**  3. The alternate callback method allows the user to pass in a pointer to
+**     their JSON file processing data structure which is then passed back to
+**     the callback function. This is needed in situations when the caller
+**     needs to be reentrant and doesn't own the JSON file procesing data
+**     structure. 
+**  4. If Obj is not NULL the file's validation and the loading of Obj[] are
+**     fused into one traversal by LoadObjArrayFused() before the callback
+**     is called.
+**  5. If ObjLoc is not NULL the file's validation and the location of 
+**     Obj[]'s values are fused by LocateObjArray() and nothing is loaded.
+**     ObjCnt must not exceed CJSON_MAX_STAGED_OBJ.
+**  6. The search cursor is claimed for the callback when no other task's
+**     callback holds it. See LoadObj().
+**  7. If JsonBuf is NULL a buffer sized to the file is borrowed from the
+**     pool and returned after the callback. The block is marked with the
+**     calling task's index so the callback can get the buffer from 
+**     CJSON_GetFileBuf(). A buffer that can't be marked is returned with
+**     an event message rather than calling a callback that can't find it.
+**
+*/
+static bool ProcessFile(const char* Filename, char* JsonBuf, size_t MaxJsonFileChar,
+                        CJSON_LoadJsonData_t LoadJsonData,
+                        CJSON_LoadJsonDataAlt_t LoadJsonDataAlt, void* UserDataPtr,
+                        bool CallbackWithUserData, CJSON_Obj_t* Obj, size_t ObjCnt,
+                        CJSON_ObjLoc_t* ObjLoc)
+{
+
+   bool  RetStatus = false;
+   
+   osal_id_t     FileHandle;
+   int32         SysStatus;
+   int32         ReadStatus;
+   JSONStatus_t  JsonStatus;
+   os_err_name_t OsErrStr;
+   char          ExtraChar;
+   bool          CursorClaimed;
+   size_t        FileLen = 0;
+   char          *PoolBuf = NULL;
+   size_t        PoolBufLen;
+   uint32        TaskIndex;
+   BufBlock_t    *Block;
+   
+   if (JsonBuf == NULL)
+   {
+      
+      PoolBuf = CJSON_AcquireFileBuf(Filename, MaxJsonFileChar, &PoolBufLen, CJSON_BUF_POOL_TIMEOUT);
+      
+      if (PoolBuf != NULL)
+      {
+         if (CallerTaskIndex(&TaskIndex))
+         {
+            OS_MutSemTake(BufPool.Mutex);
+            Block = PoolBlock(PoolBuf);
+            Block->FileLoad  = true;
+            Block->TaskIndex = TaskIndex;
+            OS_MutSemGive(BufPool.Mutex);
+            
+            JsonBuf = PoolBuf;
+            MaxJsonFileChar = PoolBufLen;
+         }
+         else
+         {
+            CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                              "CJSON error processing file %s. The calling task can't be identified for CJSON_GetFileBuf()",
+                              Filename);
+         }
+      }
+   }
+   
+   if (JsonBuf == NULL)
+   {
+      /* Error reported above or by CJSON_AcquireFileBuf() */
+   }
+   else
+   {
+   
+      SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+   
+      /*
+      ** Read entire JSON table into buffer. A file that fills the buffer is
+      ** checked for more characters so it is reported as too large rather
+      ** than as invalid JSON.
+      */
+      if (SysStatus == OS_SUCCESS)
+      {
+
+         ReadStatus = OS_read(FileHandle, JsonBuf, MaxJsonFileChar);
+
+         if ((ReadStatus >= 0) && ((size_t)ReadStatus == MaxJsonFileChar) &&
+             (OS_read(FileHandle, &ExtraChar, 1) > 0))
+         {
+         
+            CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                              "CJSON file %s exceeds the %d character JSON buffer. Use CJSON_ProcessFileStream() for large files.",
+                              Filename, (unsigned int)MaxJsonFileChar);
+      
+         } /* End if file too large */
+         else if (ReadStatus >= 0)
+         {
+
+            if (DBG_JSON) PrintJsonBuf(JsonBuf, ReadStatus);
+         
+            /* ReadStatus equals buffer len */
+
+            FileLen = ReadStatus;
+         
+            CFE_ES_PerfLogEntry(CJSON_PARSE_PERF_ID);
+            if (ObjLoc != NULL)
+            {
+               JsonStatus = LocateObjArray(Obj, ObjCnt, JsonBuf, ReadStatus, ObjLoc);
+            }
+            else if (Obj != NULL)
+            {
+               JsonStatus = LoadObjArrayFused(Obj, ObjCnt, JsonBuf, ReadStatus);
+            }
+            else
+            {
+               JsonStatus = JSON_Validate(JsonBuf, ReadStatus);
+            }
+            CFE_ES_PerfLogExit(CJSON_PARSE_PERF_ID);
+
+            if (JsonStatus == JSONSuccess)
+            { 
+         
+               CursorClaimed = ClaimCursor(JsonBuf);
+            
+               CFE_ES_PerfLogEntry(CJSON_LOAD_PERF_ID);
+               if (CallbackWithUserData)
+               {
+                  RetStatus = LoadJsonDataAlt(ReadStatus,UserDataPtr);
+               }
+               else
+               {
+                  RetStatus = LoadJsonData(ReadStatus);
+               }
+               CFE_ES_PerfLogExit(CJSON_LOAD_PERF_ID);
+            
+               if (CursorClaimed)
+               {
+                  ReleaseCursor();
+               }
+         
+            }
+            else
+            {
+         
+               CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                                 "CJSON error validating file %s.  Status = %s.",
+                                 Filename, JsonStatusStr[JsonStatus]);
+
+            }
 
-         default:
+         } /* End if valid read */
+         else
+         {
          
-            CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "Unsupported JSON type %s returned for query %s", 
-                              JsonTypeStr[ValueType], Obj->Query.Key);
-      
-      } /* End ValueType switch */
-      
-   }/* End if successful search */
-   else 
-   {
+            CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                              "CJSON error reading file %s. Status = %d",
+                              Filename, ReadStatus);
+         
+         } /* End if invalid read */
    
-      if (Necessity == OBJ_REQUIRED)
+         OS_close(FileHandle);
+      
+      }/* End if valid open */
+      else
       {
-         CFE_EVS_SendEvent(CJSON_LOAD_OBJ_EID, CFE_EVS_EventType_INFORMATION,
-                           "JSON search error for query %s. Status = %s.", 
-                           Obj->Query.Key, JsonStatusStr[JsonStatus]);
+         OS_GetErrorName(SysStatus, &OsErrStr);
+         CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "CJSON error opening file %s. Status = %s", 
+                           Filename, OsErrStr);
       }
+   
+   } /* End if buffer */
+   
+   if (PoolBuf != NULL)
+   {
+      CJSON_ReleaseBuf(PoolBuf);
    }
-         
+   
+   CountFile(FileLen, RetStatus);
+   
    return RetStatus;
    
-} /* End LoadObj() */
+} /* End ProcessFile() */
 
 
 /******************************************************************************
-** Function: PrintJsonBuf
+** Function: ReleaseCursor
 **
 ** Notes:
-**    1. OS_printf() limits the number of characters so this loops through
-**       printing 100 bytes per OS_printf() call
+**    1. Must only be called by the task that claimed the cursor.
 **
 */
-static void PrintJsonBuf(const char* JsonBuf, size_t BufLen)
+static void ReleaseCursor(void)
 {
+
+   OS_MutSemTake(Cursor.Mutex);
    
-   int  i = 0;
-   char PrintBuf[PRINT_BUF_SEGMENT_BYTES+1];
+   Cursor.Claimed = false;
+   Cursor.JsonBuf = NULL;
    
-   OS_printf("\n>>> JSON table file buffer:\n");
-   for (i=0; i < BufLen; i += PRINT_BUF_SEGMENT_BYTES)
-   {
-      
-      strncpy(PrintBuf, &JsonBuf[i], PRINT_BUF_SEGMENT_BYTES);
-      PrintBuf[PRINT_BUF_SEGMENT_BYTES] = '\0';
-      OS_printf("%s",PrintBuf); 
-      
-   }
-   OS_printf("\n");
+   OS_MutSemGive(Cursor.Mutex);
    
-} /* End PrintJsonBuf() */
+} /* End ReleaseCursor() */
 
 
 /******************************************************************************
-** Function: ProcessFile
+** Function: SchemaVisit
 **
 ** Notes:
-**  1. Entire JSON file is read into memory
-**  2. User callback function LoadJsonData() or LoadJsonDataAlt() calls 
-**     a CJSON_LoadObj*() method to load the JSON data into the user's table. 
-**     The user's callback function can perform table-specific procesing such  
-**     as validation prior to loading the table data.
-**  3. The alternate callback method allows the user to pass in a pointer to
-**     their JSON file processing data structure which is then passed back to
-**     the callback function. This is needed in situations when the caller
-**     needs to be reentrant and doesn't own the JSON file procesing data
-**     structure. 
+**    1. JSON_ValidateVisit() callback that decodes each schema field's value
+**       directly into the table. See MatchQuery() for how values are matched.
+**    2. A "[*]" field's elements are counted when the "[*]" part matches so
+**       CJSON_SchemaLoad() can check that every element had the field. An
+**       element beyond the table array's MaxCnt is reported once and ignored.
 **
 */
-static bool ProcessFile(const char* Filename, char* JsonBuf, size_t MaxJsonFileChar,
-                        CJSON_LoadJsonData_t LoadJsonData,
-                        CJSON_LoadJsonDataAlt_t LoadJsonDataAlt, void* UserDataPtr,
-                        bool CallbackWithUserData)
+static void SchemaVisit(void* Context, const char* Buf, const JSONVisit_t* Visit)
 {
 
-   bool  RetStatus = false;
-   
-   osal_id_t     FileHandle;
-   int32         SysStatus;
-   int32         ReadStatus;
-   JSONStatus_t  JsonStatus;
-   os_err_name_t OsErrStr;
+   SchemaLoad_t        *SchemaLoad = (SchemaLoad_t*)Context;
+   ObjStage_t          *Stage;
+   CJSON_SchemaEntry_t *Entry;
+   const CJSON_SchemaField_t *Field;
+   const char          *Value;
+   size_t              ValueLen;
+   uint8               *TblData;
+   bool                Matched;
+   bool                Close;
+   uint16              i;
    
-   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+   Close = ((Visit->jsonType == JSONObject || Visit->jsonType == JSONArray) && Visit->valueLength > 0);
    
-   /*
-   ** Read entire JSON table into buffer. Logic kept very simple and JSON
-   ** validate will catch if entire file wasn't read.
-   */
-   if (SysStatus == OS_SUCCESS)
+   for (i=0; i < SchemaLoad->Schema->FieldCnt; i++)
    {
-
-      ReadStatus = OS_read(FileHandle, JsonBuf, MaxJsonFileChar);
-
-      if (ReadStatus >= 0)
+   
+      Field = &SchemaLoad->Schema->Field[i];
+      Entry = &SchemaLoad->Schema->Entry[i];
+      Stage = &SchemaLoad->Stage[i];
+      
+      /* Non-array fields load the first occurrence */
+      Matched = false;
+      if (Entry->EachDepth > 0 || !Stage->Staged)
+      {
+         Matched = MatchQuery(&Entry->Query, NULL, Field->Path, Stage, Buf, Visit);
+      }
+      
+      if (!Close && Visit->depth == Entry->EachDepth && Stage->MatchDepth == Entry->EachDepth)
+      {
+         Entry->ElementCnt++;
+      }
+      
+      if (Matched)
       {
-
-         if (DBG_JSON) PrintJsonBuf(JsonBuf, ReadStatus);
          
-         /* ReadStatus equals buffer len */
-
-         JsonStatus = JSON_Validate(JsonBuf, ReadStatus);
-
-         if (JsonStatus == JSONSuccess)
-         { 
-            if (CallbackWithUserData)
+         TblData = SchemaLoad->Tbl + Field->Offset;
+         
+         if (Entry->EachDepth > 0)
+         {
+            if (Stage->Element < Field->MaxCnt)
             {
-               RetStatus = LoadJsonDataAlt(ReadStatus,UserDataPtr);
+               TblData += Stage->Element * Field->Stride;
             }
             else
             {
-               RetStatus = LoadJsonData(ReadStatus);
+               if (!Stage->Staged)
+               {
+                  CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                                    "JSON schema field %s array has more than %d elements", 
+                                    Field->Path, (unsigned int)Field->MaxCnt);
+               }
+               Stage->Staged = true;
+               TblData = NULL;
             }
          }
          else
          {
-         
-            CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR, 
-                              "CJSON error validating file %s.  Status = %s.",
-                              Filename, JsonStatusStr[JsonStatus]);
-
+            Stage->Staged = true;
          }
-
-      } /* End if valid read */
-      else
-      {
          
-         CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR, 
-                           "CJSON error reading file %s. Status = %d",
-                           Filename, ReadStatus);
+         if (Visit->jsonType != Field->Type && 
+             !(Field->Type == JSONNumber && Visit->jsonType == JSONString))
+         {
+            CFE_EVS_SendEvent(CJSON_LOAD_OBJ_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "JSON schema field %s has type %s, expected %s", Field->Path,
+                              JsonTypeStr[Visit->jsonType], JsonTypeStr[Field->Type]);
+         }
+         else if (TblData != NULL)
+         {
+            
+            Value    = &Buf[Visit->value];
+            ValueLen = Visit->valueLength;
+            if (Visit->jsonType == JSONString)
+            {
+               /* Strip the surrounding quotes */
+               Value++;
+               ValueLen -= 2;
+            }
+            
+            if (DecodeValue(TblData, Field->Size, Field->Type, Field->NumType, CJSON_STR_COPY,
+                            Field->Path, Value, ValueLen, Visit->jsonType))
+            {
+               Entry->LoadCnt++;
+            }
+         }
          
-      } /* End if invalid read */
-   
-      OS_close(FileHandle);
-      
-   }/* End if valid open */
-   else
-   {
-      OS_GetErrorName(SysStatus, &OsErrStr);
-      CFE_EVS_SendEvent(CJSON_PROCESS_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
-                        "CJSON error opening file %s. Status = %s", 
-                        Filename, OsErrStr);
-   }
-   
-   return RetStatus;
+      } /* End if matched */
+   } /* End field loop */
    
-} /* End ProcessFile() */
+} /* End SchemaVisit() */
 
 
 /******************************************************************************
@@ -565,3 +3441,287 @@ static bool StubLoadJsonDataAlt(size_t JsonFileLen, void* UserDataPtr)
    return false;
 
 } /* End StubLoadJsonDataAlt() */
+
+
+/******************************************************************************
+** Function: WriterAppend
+**
+** Notes:
+**    1. Copies Str into the writer's buffer and writes the buffer to the
+**       file each time it fills.
+**
+*/
+static void WriterAppend(CJSON_Writer_t* Writer, const char* Str, size_t StrLen)
+{
+
+   size_t CopyLen;
+   
+   while (Writer->Valid && StrLen > 0)
+   {
+   
+      CopyLen = Writer->BufLen - Writer->Len;
+      if (CopyLen > StrLen)
+      {
+         CopyLen = StrLen;
+      }
+      
+      memcpy(&Writer->Buf[Writer->Len], Str, CopyLen);
+      Writer->Len += CopyLen;
+      Str    += CopyLen;
+      StrLen -= CopyLen;
+      
+      if (Writer->Len == Writer->BufLen)
+      {
+         WriterFlush(Writer);
+      }
+   
+   } /* End while characters to append */
+   
+} /* End WriterAppend() */
+
+
+/******************************************************************************
+** Function: WriterBegin
+**
+*/
+static void WriterBegin(CJSON_Writer_t* Writer, const char* Key, const char* Bracket)
+{
+
+   WriterMember(Writer, Key);
+   WriterAppend(Writer, Bracket, 1);
+   
+   if (Writer->Depth < CJSON_WRITER_MAX_DEPTH)
+   {
+      Writer->MemberMask &= ~((uint32)1 << Writer->Depth);
+      Writer->Depth++;
+   }
+   else if (Writer->Valid)
+   {
+      CFE_EVS_SendEvent(CJSON_WRITE_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "CJSON write error. Nesting exceeds maximum depth %d",
+                        CJSON_WRITER_MAX_DEPTH);
+      Writer->Valid = false;
+   }
+   
+} /* End WriterBegin() */
+
+
+/******************************************************************************
+** Function: WriterEnd
+**
+** Notes:
+**    1. An empty object or array is closed on the line it was opened.
+**
+*/
+static void WriterEnd(CJSON_Writer_t* Writer, const char* Bracket)
+{
+
+   if (Writer->Depth > 0)
+   {
+   
+      Writer->Depth--;
+      if (Writer->MemberMask & ((uint32)1 << Writer->Depth))
+      {
+         WriterIndent(Writer);
+      }
+      WriterAppend(Writer, Bracket, 1);
+   
+   }
+   else if (Writer->Valid)
+   {
+      CFE_EVS_SendEvent(CJSON_WRITE_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "CJSON write error. %s doesn't close an object or array", Bracket);
+      Writer->Valid = false;
+   }
+   
+} /* End WriterEnd() */
+
+
+/******************************************************************************
+** Function: WriterFlush
+**
+*/
+static void WriterFlush(CJSON_Writer_t* Writer)
+{
+
+   int32 WriteStatus;
+   
+   if (Writer->Valid && Writer->Len > 0)
+   {
+   
+      WriteStatus = OS_write(Writer->FileHandle, Writer->Buf, Writer->Len);
+      Writer->WriteCnt++;
+      
+      if (WriteStatus == (int32)Writer->Len)
+      {
+         Writer->FileLen += Writer->Len;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(CJSON_WRITE_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "CJSON error writing %d characters at file offset %d. Status = %d",
+                           (unsigned int)Writer->Len, (unsigned int)Writer->FileLen, WriteStatus);
+         Writer->Valid = false;
+      }
+   }
+   
+   Writer->Len = 0;
+   
+} /* End WriterFlush() */
+
+
+/******************************************************************************
+** Function: WriterIndent
+**
+** Notes:
+**    1. Starts a new line indented to the writer's current depth.
+**
+*/
+static void WriterIndent(CJSON_Writer_t* Writer)
+{
+
+   static const char Spaces[] = "                                ";
+   
+   size_t SpaceCnt = Writer->Depth * CJSON_WRITER_INDENT;
+   size_t Len;
+   
+   WriterAppend(Writer, "\n", 1);
+   while (SpaceCnt > 0)
+   {
+      Len = (SpaceCnt < (sizeof(Spaces)-1)) ? SpaceCnt : (sizeof(Spaces)-1);
+      WriterAppend(Writer, Spaces, Len);
+      SpaceCnt -= Len;
+   }
+   
+} /* End WriterIndent() */
+
+
+/******************************************************************************
+** Function: WriterMember
+**
+** Notes:
+**    1. Starts a value by writing the separator from the previous member,
+**       the indentation and the value's key when it has one.
+**
+*/
+static void WriterMember(CJSON_Writer_t* Writer, const char* Key)
+{
+
+   uint32 MemberBit;
+   
+   if (Writer->Depth > 0)
+   {
+   
+      MemberBit = (uint32)1 << (Writer->Depth - 1);
+      if (Writer->MemberMask & MemberBit)
+      {
+         WriterAppend(Writer, ",", 1);
+      }
+      Writer->MemberMask |= MemberBit;
+      
+      WriterIndent(Writer);
+   }
+   
+   if (Key != NULL)
+   {
+      WriterStr(Writer, Key);
+      WriterAppend(Writer, ": ", 2);
+   }
+   
+} /* End WriterMember() */
+
+
+/******************************************************************************
+** Function: WriterReal
+**
+** Notes:
+**    1. Integral values are written with FormatUint() which is much faster
+**       than snprintf() and they load into float objects unchanged.
+**    2. JSON has no infinite or NaN numbers so they are written as null.
+**
+*/
+static void WriterReal(CJSON_Writer_t* Writer, double Value, int Digits)
+{
+
+   char    Str[WRITER_NUM_STR_LEN];
+   size_t  Len = 0;
+   int     PrintLen;
+   
+   if (Value != Value || Value > DBL_MAX || Value < -DBL_MAX)
+   {
+      WriterAppend(Writer, "null", 4);
+   }
+   else if (Value > -WRITER_MAX_EXACT_INT && Value < WRITER_MAX_EXACT_INT && 
+            Value == (double)(int64)Value)
+   {
+      if (Value < 0.0)
+      {
+         Str[Len++] = '-';
+      }
+      Len += FormatUint((uint64)((Value < 0.0) ? -Value : Value), &Str[Len]);
+      WriterAppend(Writer, Str, Len);
+   }
+   else
+   {
+      PrintLen = snprintf(Str, sizeof(Str), "%.*g", Digits, Value);
+      if (PrintLen > 0 && PrintLen < (int)sizeof(Str))
+      {
+         WriterAppend(Writer, Str, (size_t)PrintLen);
+      }
+   }
+   
+} /* End WriterReal() */
+
+
+/******************************************************************************
+** Function: WriterStr
+**
+** Notes:
+**    1. Writes a quoted string. Runs of characters that don't need to be
+**       escaped are appended with a single copy.
+**
+*/
+static void WriterStr(CJSON_Writer_t* Writer, const char* Str)
+{
+
+   static const char HexDigit[] = "0123456789ABCDEF";
+   
+   const char  *Run = Str;
+   char        Esc[6] = { '\\', 'u', '0', '0', '0', '0' };
+   size_t      EscLen;
+   
+   WriterAppend(Writer, "\"", 1);
+   
+   for (; *Str != '\0'; Str++)
+   {
+   
+      if (*Str == '"' || *Str == '\\' || (uint8)*Str < 0x20)
+      {
+      
+         WriterAppend(Writer, Run, Str - Run);
+         Run = Str + 1;
+         
+         EscLen = 2;
+         switch (*Str)
+         {
+            case '"':  Esc[1] = '"';  break;
+            case '\\': Esc[1] = '\\'; break;
+            case '\n': Esc[1] = 'n';  break;
+            case '\r': Esc[1] = 'r';  break;
+            case '\t': Esc[1] = 't';  break;
+            default:
+               Esc[1] = 'u';
+               Esc[4] = HexDigit[((uint8)*Str) >> 4];
+               Esc[5] = HexDigit[((uint8)*Str) & 0xF];
+               EscLen = 6;
+               break;
+         }
+         WriterAppend(Writer, Esc, EscLen);
+         
+      } /* End if escaped character */
+   } /* End character loop */
+   
+   WriterAppend(Writer, Run, Str - Run);
+   WriterAppend(Writer, "\"", 1);
+   
+} /* End WriterStr() */
@@ -26,8 +26,10 @@
  */
 
 #include <assert.h>
+#include <float.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "core_json.h"
 
 /** @cond DO_NOT_DOCUMENT */
@@ -54,6 +56,229 @@ typedef union
 #define isSquareOpen_( x )            ( ( x ) == '[' )
 #define isSquareClose_( x )           ( ( x ) == ']' )
 
+/*
+ * Vector classification of whitespace and plain string characters.
+ *
+ * SSE2 is part of the x86-64 baseline and NEON is part of the AArch64
+ * baseline so both are selected at compile time.  Each vector routine only
+ * advances over bytes that the byte-at-a-time loops would also advance over
+ * and leaves the remaining bytes to those loops, so results are identical
+ * with or without vectors.  Define JSON_DISABLE_SIMD to use only the
+ * byte-at-a-time loops.
+ */
+#if !defined( JSON_DISABLE_SIMD ) && defined( __GNUC__ )
+    #if defined( __SSE2__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+        #define JSON_SIMD_SSE2
+        #include <emmintrin.h>
+    #elif defined( __ARM_NEON ) && defined( __aarch64__ )
+        #define JSON_SIMD_NEON
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#if defined( JSON_SIMD_SSE2 )
+
+/**
+ * @brief Advance buffer index beyond whitespace 16 bytes at a time.
+ *
+ * @param[in] buf  The buffer to parse.
+ * @param[in] i  The index at which to begin.
+ * @param[in] max  The size of the buffer.
+ *
+ * @return the index of the first byte that was not skipped.
+ */
+static size_t skipSpaceSSE2( const char * buf,
+                             size_t i,
+                             size_t max )
+{
+    const __m128i sp = _mm_set1_epi8( ' ' );
+    const __m128i tab = _mm_set1_epi8( '\t' );
+    const __m128i nl = _mm_set1_epi8( '\n' );
+    const __m128i cr = _mm_set1_epi8( '\r' );
+
+    while( ( max - i ) >= 16U )
+    {
+        __m128i v = _mm_loadu_si128( ( const __m128i * ) &buf[ i ] );
+        __m128i space = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, sp ), _mm_cmpeq_epi8( v, tab ) ),
+                                      _mm_or_si128( _mm_cmpeq_epi8( v, nl ), _mm_cmpeq_epi8( v, cr ) ) );
+        uint32_t other = ( ~( uint32_t ) _mm_movemask_epi8( space ) ) & 0xFFFFU;
+
+        if( other != 0U )
+        {
+            i += ( size_t ) __builtin_ctz( other );
+            break;
+        }
+
+        i += 16U;
+    }
+
+    return i;
+}
+
+/**
+ * @brief Advance buffer index beyond string characters that need no
+ * further checks, 16 bytes at a time.
+ *
+ * Plain characters are ASCII, not a control character, and neither a
+ * quote nor a backslash.
+ *
+ * @param[in] buf  The buffer to parse.
+ * @param[in] i  The index at which to begin.
+ * @param[in] max  The size of the buffer.
+ *
+ * @return the index of the first byte that was not skipped.
+ */
+static size_t skipPlainSSE2( const char * buf,
+                             size_t i,
+                             size_t max )
+{
+    const __m128i quote = _mm_set1_epi8( '"' );
+    const __m128i backslash = _mm_set1_epi8( '\\' );
+    const __m128i sp = _mm_set1_epi8( ' ' );
+
+    while( ( max - i ) >= 16U )
+    {
+        __m128i v = _mm_loadu_si128( ( const __m128i * ) &buf[ i ] );
+        /* Signed compare classifies control characters and non-ASCII bytes together */
+        __m128i special = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, quote ), _mm_cmpeq_epi8( v, backslash ) ),
+                                        _mm_cmplt_epi8( v, sp ) );
+        uint32_t mask = ( uint32_t ) _mm_movemask_epi8( special );
+
+        if( mask != 0U )
+        {
+            i += ( size_t ) __builtin_ctz( mask );
+            break;
+        }
+
+        i += 16U;
+    }
+
+    return i;
+}
+
+#endif /* if defined( JSON_SIMD_SSE2 ) */
+
+#if defined( JSON_SIMD_NEON )
+
+/**
+ * @brief Advance buffer index beyond whitespace 16 bytes at a time.
+ *
+ * The byte-at-a-time loop locates the first other character within
+ * the final vector.
+ */
+static size_t skipSpaceNEON( const char * buf,
+                             size_t i,
+                             size_t max )
+{
+    const uint8x16_t sp = vdupq_n_u8( ( uint8_t ) ' ' );
+    const uint8x16_t tab = vdupq_n_u8( ( uint8_t ) '\t' );
+    const uint8x16_t nl = vdupq_n_u8( ( uint8_t ) '\n' );
+    const uint8x16_t cr = vdupq_n_u8( ( uint8_t ) '\r' );
+
+    while( ( max - i ) >= 16U )
+    {
+        uint8x16_t v = vld1q_u8( ( const uint8_t * ) &buf[ i ] );
+        uint8x16_t space = vorrq_u8( vorrq_u8( vceqq_u8( v, sp ), vceqq_u8( v, tab ) ),
+                                     vorrq_u8( vceqq_u8( v, nl ), vceqq_u8( v, cr ) ) );
+
+        if( vminvq_u8( space ) == 0U )
+        {
+            break;
+        }
+
+        i += 16U;
+    }
+
+    return i;
+}
+
+/**
+ * @brief Advance buffer index beyond plain string characters 16 bytes
+ * at a time.
+ *
+ * The byte-at-a-time loop locates the first special character within
+ * the final vector.
+ */
+static size_t skipPlainNEON( const char * buf,
+                             size_t i,
+                             size_t max )
+{
+    const uint8x16_t quote = vdupq_n_u8( ( uint8_t ) '"' );
+    const uint8x16_t backslash = vdupq_n_u8( ( uint8_t ) '\\' );
+    const uint8x16_t sp = vdupq_n_u8( ( uint8_t ) ' ' );
+    const uint8x16_t high = vdupq_n_u8( 0x80U );
+
+    while( ( max - i ) >= 16U )
+    {
+        uint8x16_t v = vld1q_u8( ( const uint8_t * ) &buf[ i ] );
+        uint8x16_t special = vorrq_u8( vorrq_u8( vceqq_u8( v, quote ), vceqq_u8( v, backslash ) ),
+                                       vorrq_u8( vcltq_u8( v, sp ), vcgeq_u8( v, high ) ) );
+
+        if( vmaxvq_u8( special ) != 0U )
+        {
+            break;
+        }
+
+        i += 16U;
+    }
+
+    return i;
+}
+
+#endif /* if defined( JSON_SIMD_NEON ) */
+
+/**
+ * @brief Advance buffer index beyond whitespace using the widest vector
+ * routine available.
+ *
+ * @param[in] buf  The buffer to parse.
+ * @param[in] i  The index at which to begin.
+ * @param[in] max  The size of the buffer.
+ *
+ * @return the index of the first byte that was not skipped.
+ */
+static size_t skipSpaceVector( const char * buf,
+                               size_t i,
+                               size_t max )
+{
+    #if defined( JSON_SIMD_SSE2 )
+        i = skipSpaceSSE2( buf, i, max );
+    #elif defined( JSON_SIMD_NEON )
+        i = skipSpaceNEON( buf, i, max );
+    #else
+        ( void ) buf;
+        ( void ) max;
+    #endif
+
+    return i;
+}
+
+/**
+ * @brief Advance buffer index beyond plain string characters using the
+ * widest vector routine available.
+ *
+ * @param[in] buf  The buffer to parse.
+ * @param[in] i  The index at which to begin.
+ * @param[in] max  The size of the buffer.
+ *
+ * @return the index of the first byte that was not skipped.
+ */
+static size_t skipPlainVector( const char * buf,
+                               size_t i,
+                               size_t max )
+{
+    #if defined( JSON_SIMD_SSE2 )
+        i = skipPlainSSE2( buf, i, max );
+    #elif defined( JSON_SIMD_NEON )
+        i = skipPlainNEON( buf, i, max );
+    #else
+        ( void ) buf;
+        ( void ) max;
+    #endif
+
+    return i;
+}
+
 /**
  * @brief Advance buffer index beyond whitespace.
  *
@@ -69,7 +294,7 @@ static void skipSpace( const char * buf,
 
     assert( ( buf != NULL ) && ( start != NULL ) && ( max > 0U ) );
 
-    for( i = *start; i < max; i++ )
+    for( i = skipSpaceVector( buf, *start, max ); i < max; i++ )
     {
         if( !isspace_( buf[ i ] ) )
         {
@@ -513,6 +738,13 @@ static bool skipString( const char * buf,
 
         while( i < max )
         {
+            i = skipPlainVector( buf, i, max );
+
+            if( i >= max )
+            {
+                break;
+            }
+
             if( buf[ i ] == '"' )
             {
                 ret = true;
@@ -1018,34 +1250,45 @@ static void skipScalars( const char * buf,
     }
 }
 
+/**
+ * @brief Test whether a nesting level is an object rather than an array.
+ *
+ * @param[in] nesting  The nesting bit stack.
+ * @param[in] level  The level to test.
+ */
+#define isNestedObject_( nesting, level ) \
+    ( ( ( nesting )[ ( level ) / 8U ] & ( uint8_t ) ( 1U << ( ( level ) % 8U ) ) ) != 0U )
+
 /**
  * @brief Advance buffer index beyond a collection and handle nesting.
  *
- * A stack is used to continue parsing the prior collection type
- * when a nested collection is finished.
+ * A bit stack, one bit per open collection, is used to continue parsing
+ * the prior collection type when a nested collection is finished.
  *
  * @param[in] buf  The buffer to parse.
  * @param[in,out] start  The index at which to begin.
  * @param[in] max  The size of the buffer.
+ * @param[in] nesting  The nesting bit stack, JSON_NESTING_LEN( maxDepth ) bytes.
+ * @param[in] maxDepth  The maximum number of open collections.
  *
  * @return #JSONSuccess if the buffer contents are a valid JSON collection;
  * #JSONIllegalDocument if the buffer contents are NOT valid JSON;
- * #JSONMaxDepthExceeded if object and array nesting exceeds a threshold;
+ * #JSONMaxDepthExceeded if object and array nesting exceeds maxDepth;
  * #JSONPartial if the buffer contents are potentially valid but incomplete.
  */
-#ifndef JSON_MAX_DEPTH
-    #define JSON_MAX_DEPTH    32
-#endif
-static JSONStatus_t skipCollection( const char * buf,
-                                    size_t * start,
-                                    size_t max )
+static JSONStatus_t skipNestedCollection( const char * buf,
+                                          size_t * start,
+                                          size_t max,
+                                          uint8_t * nesting,
+                                          size_t maxDepth )
 {
     JSONStatus_t ret = JSONPartial;
-    char c, stack[ JSON_MAX_DEPTH ];
-    int16_t depth = -1;
-    size_t i;
+    char c;
+    size_t depth = 0, i;
+    uint8_t bit;
 
     assert( ( buf != NULL ) && ( start != NULL ) && ( max > 0U ) );
+    assert( ( nesting != NULL ) && ( maxDepth > 0U ) );
 
     i = *start;
 
@@ -1058,34 +1301,52 @@ static JSONStatus_t skipCollection( const char * buf,
         {
             case '{':
             case '[':
-                depth++;
 
-                if( depth == JSON_MAX_DEPTH )
+                if( depth == maxDepth )
                 {
                     ret = JSONMaxDepthExceeded;
                     break;
                 }
 
-                stack[ depth ] = c;
-                skipScalars( buf, &i, max, stack[ depth ] );
+                bit = ( uint8_t ) ( 1U << ( depth % 8U ) );
+
+                if( c == '{' )
+                {
+                    nesting[ depth / 8U ] |= bit;
+                }
+                else
+                {
+                    nesting[ depth / 8U ] &= ( uint8_t ) ~bit;
+                }
+
+                depth++;
+                skipScalars( buf, &i, max, c );
                 break;
 
             case '}':
             case ']':
 
-                if( ( depth > 0 ) && isMatchingBracket_( stack[ depth ], c ) )
+                if( ( depth > 0U ) && ( isNestedObject_( nesting, depth - 1U ) == ( c == '}' ) ) )
                 {
                     depth--;
 
-                    if( skipSpaceAndComma( buf, &i, max ) == true )
+                    if( depth == 0U )
+                    {
+                        ret = JSONSuccess;
+                    }
+                    else if( skipSpaceAndComma( buf, &i, max ) == true )
+                    {
+                        skipScalars( buf, &i, max, isNestedObject_( nesting, depth - 1U ) ? '{' : '[' );
+                    }
+                    else
                     {
-                        skipScalars( buf, &i, max, stack[ depth ] );
+                        /* MISRA 15.7 */
                     }
 
                     break;
                 }
 
-                ret = ( depth == 0 ) ? JSONSuccess : JSONIllegalDocument;
+                ret = JSONIllegalDocument;
                 break;
 
             default:
@@ -1107,19 +1368,89 @@ static JSONStatus_t skipCollection( const char * buf,
     return ret;
 }
 
+/**
+ * @brief Advance buffer index beyond a collection of up to JSON_MAX_DEPTH
+ * levels, holding the nesting bit stack on the stack.
+ *
+ * @param[in] buf  The buffer to parse.
+ * @param[in,out] start  The index at which to begin.
+ * @param[in] max  The size of the buffer.
+ *
+ * @return See skipNestedCollection().
+ */
+#ifndef JSON_MAX_DEPTH
+    #define JSON_MAX_DEPTH    32
+#endif
+static JSONStatus_t skipCollection( const char * buf,
+                                    size_t * start,
+                                    size_t max )
+{
+    uint8_t nesting[ JSON_NESTING_LEN( JSON_MAX_DEPTH ) ];
+
+    return skipNestedCollection( buf, start, max, nesting, JSON_MAX_DEPTH );
+}
+
 /** @endcond */
 
+/** @cond DO_NOT_DOCUMENT */
+
 /**
- * See core_json.h for docs.
- *
- * Verify that the entire buffer contains exactly one scalar
+ * @brief Verify that the entire buffer contains exactly one scalar
  * or collection within optional whitespace.
+ *
+ * @param[in] buf  The buffer to parse.
+ * @param[in] max  The size of the buffer.
+ * @param[in] nesting  The nesting bit stack, JSON_NESTING_LEN( maxDepth ) bytes.
+ * @param[in] maxDepth  The maximum number of open collections.
+ *
+ * @return See JSON_Validate().
+ */
+static JSONStatus_t validateDocument( const char * buf,
+                                      size_t max,
+                                      uint8_t * nesting,
+                                      size_t maxDepth )
+{
+    JSONStatus_t ret;
+    size_t i = 0;
+
+    assert( ( buf != NULL ) && ( max > 0U ) );
+
+    skipSpace( buf, &i, max );
+
+    #ifndef JSON_VALIDATE_COLLECTIONS_ONLY
+        if( skipAnyScalar( buf, &i, max ) == true )
+        {
+            ret = JSONSuccess;
+        }
+        else
+    #endif
+    {
+        ret = skipNestedCollection( buf, &i, max, nesting, maxDepth );
+    }
+
+    if( ( ret == JSONSuccess ) && ( i < max ) )
+    {
+        skipSpace( buf, &i, max );
+
+        if( i != max )
+        {
+            ret = JSONIllegalDocument;
+        }
+    }
+
+    return ret;
+}
+
+/** @endcond */
+
+/**
+ * See core_json.h for docs.
  */
 JSONStatus_t JSON_Validate( const char * buf,
                             size_t max )
 {
     JSONStatus_t ret;
-    size_t i = 0;
+    uint8_t nesting[ JSON_NESTING_LEN( JSON_MAX_DEPTH ) ];
 
     if( buf == NULL )
     {
@@ -1131,30 +1462,33 @@ JSONStatus_t JSON_Validate( const char * buf,
     }
     else
     {
-        skipSpace( buf, &i, max );
-
-        /** @cond DO_NOT_DOCUMENT */
-        #ifndef JSON_VALIDATE_COLLECTIONS_ONLY
-            if( skipAnyScalar( buf, &i, max ) == true )
-            {
-                ret = JSONSuccess;
-            }
-            else
-        #endif
-        /** @endcond */
-        {
-            ret = skipCollection( buf, &i, max );
-        }
+        ret = validateDocument( buf, max, nesting, JSON_MAX_DEPTH );
     }
 
-    if( ( ret == JSONSuccess ) && ( i < max ) )
-    {
-        skipSpace( buf, &i, max );
+    return ret;
+}
 
-        if( i != max )
-        {
-            ret = JSONIllegalDocument;
-        }
+/**
+ * See core_json.h for docs.
+ */
+JSONStatus_t JSON_ValidateNested( const char * buf,
+                                  size_t max,
+                                  uint8_t * nesting,
+                                  size_t nestingLength )
+{
+    JSONStatus_t ret;
+
+    if( ( buf == NULL ) || ( nesting == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else if( ( max == 0U ) || ( nestingLength == 0U ) )
+    {
+        ret = JSONBadParameter;
+    }
+    else
+    {
+        ret = validateDocument( buf, max, nesting, nestingLength * 8U );
     }
 
     return ret;
@@ -1292,6 +1626,7 @@ static bool nextKeyValuePair( const char * buf,
  * @param[in] max  size of the buffer.
  * @param[in] query  The object keys and array indexes to search for.
  * @param[in] queryLength  Length of the key.
+ * @param[out] outKey  Optional, a pointer to receive the index of the key found.
  * @param[out] outValue  A pointer to receive the index of the value found.
  * @param[out] outValueLength  A pointer to receive the length of the value found.
  *
@@ -1306,6 +1641,7 @@ static bool objectSearch( const char * buf,
                           size_t max,
                           const char * query,
                           size_t queryLength,
+                          size_t * outKey,
                           size_t * outValue,
                           size_t * outValueLength )
 {
@@ -1349,67 +1685,64 @@ static bool objectSearch( const char * buf,
     {
         *outValue = value;
         *outValueLength = valueLength;
+
+        if( outKey != NULL )
+        {
+            *outKey = key;
+        }
     }
 
     return ret;
 }
 
 /**
- * @brief Find an index in a JSON array and output a pointer to its value.
+ * @brief Find an index in a JSON array starting from one of its elements.
  *
  * @param[in] buf  The buffer to search.
  * @param[in] max  size of the buffer.
- * @param[in] queryIndex  The index to search for.
+ * @param[in] start  The buffer index of element @p startIndex.
+ * @param[in] startIndex  The index of the element at @p start.
+ * @param[in] queryIndex  The index to search for, at least @p startIndex.
  * @param[out] outValue  A pointer to receive the index of the value found.
  * @param[out] outValueLength  A pointer to receive the length of the value found.
  *
- * Iterate over the values of an array, looking for a matching index.
- *
  * @return true if the queryIndex is found and the value output;
  * false otherwise.
- *
- * @note Parsing stops upon finding a match.
  */
-static bool arraySearch( const char * buf,
-                         size_t max,
-                         uint32_t queryIndex,
-                         size_t * outValue,
-                         size_t * outValueLength )
+static bool arraySearchFrom( const char * buf,
+                             size_t max,
+                             size_t start,
+                             uint32_t startIndex,
+                             uint32_t queryIndex,
+                             size_t * outValue,
+                             size_t * outValueLength )
 {
     bool ret = false;
-    size_t i = 0, value = 0, valueLength = 0;
-    uint32_t currentIndex = 0;
+    size_t i = start, value = 0, valueLength = 0;
+    uint32_t currentIndex = startIndex;
 
     assert( buf != NULL );
     assert( ( outValue != NULL ) && ( outValueLength != NULL ) );
 
-    skipSpace( buf, &i, max );
-
-    if( ( i < max ) && ( buf[ i ] == '[' ) )
+    while( i < max )
     {
-        i++;
-        skipSpace( buf, &i, max );
-
-        while( i < max )
+        if( nextValue( buf, &i, max, &value, &valueLength ) != true )
         {
-            if( nextValue( buf, &i, max, &value, &valueLength ) != true )
-            {
-                break;
-            }
+            break;
+        }
 
-            if( currentIndex == queryIndex )
-            {
-                ret = true;
-                break;
-            }
-
-            if( skipSpaceAndComma( buf, &i, max ) != true )
-            {
-                break;
-            }
+        if( currentIndex == queryIndex )
+        {
+            ret = true;
+            break;
+        }
 
-            currentIndex++;
+        if( skipSpaceAndComma( buf, &i, max ) != true )
+        {
+            break;
         }
+
+        currentIndex++;
     }
 
     if( ret == true )
@@ -1421,6 +1754,47 @@ static bool arraySearch( const char * buf,
     return ret;
 }
 
+/**
+ * @brief Find an index in a JSON array and output a pointer to its value.
+ *
+ * @param[in] buf  The buffer to search.
+ * @param[in] max  size of the buffer.
+ * @param[in] queryIndex  The index to search for.
+ * @param[out] outValue  A pointer to receive the index of the value found.
+ * @param[out] outValueLength  A pointer to receive the length of the value found.
+ *
+ * Iterate over the values of an array, looking for a matching index.
+ *
+ * @return true if the queryIndex is found and the value output;
+ * false otherwise.
+ *
+ * @note Parsing stops upon finding a match.
+ */
+static bool arraySearch( const char * buf,
+                         size_t max,
+                         uint32_t queryIndex,
+                         size_t * outValue,
+                         size_t * outValueLength )
+{
+    bool ret = false;
+    size_t i = 0;
+
+    assert( buf != NULL );
+    assert( ( outValue != NULL ) && ( outValueLength != NULL ) );
+
+    skipSpace( buf, &i, max );
+
+    if( ( i < max ) && ( buf[ i ] == '[' ) )
+    {
+        i++;
+        skipSpace( buf, &i, max );
+
+        ret = arraySearchFrom( buf, max, i, 0, queryIndex, outValue, outValueLength );
+    }
+
+    return ret;
+}
+
 /**
  * @brief Advance buffer index beyond a query part.
  *
@@ -1534,7 +1908,7 @@ static JSONStatus_t multiSearch( const char * buf,
                 break;
             }
 
-            found = objectSearch( &buf[ start ], length, &query[ queryStart ], keyLength, &value, &length );
+            found = objectSearch( &buf[ start ], length, &query[ queryStart ], keyLength, NULL, &value, &length );
         }
 
         if( found == false )
@@ -1804,3 +2178,2957 @@ JSONStatus_t JSON_Iterate( const char * buf,
 
     return ret;
 }
+
+/** @cond DO_NOT_DOCUMENT */
+
+/**
+ * @brief Compute the FNV-1a hash of a key.
+ *
+ * @param[in] key  The key's characters.
+ * @param[in] length  The length of the key.
+ *
+ * @return the hash.
+ */
+static uint32_t hashKey( const char * key,
+                         size_t length )
+{
+    uint32_t hash = 0x811C9DC5U;
+    size_t i;
+
+    assert( key != NULL );
+
+    for( i = 0; i < length; i++ )
+    {
+        char_ c;
+
+        c.c = key[ i ];
+        hash = ( hash ^ c.u ) * 0x01000193U;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Append a value to a structural index.
+ *
+ * @param[in,out] index  The index being built.
+ * @param[in] value  Buffer index of the value.
+ * @param[in] type  JSON-specific type of the value.
+ * @param[in] key  Buffer index of the value's key, 0 if none.
+ * @param[in] keyLength  Length of the value's key.
+ * @param[in] parent  Entry of the enclosing collection.
+ *
+ * @return true if the entry was added;
+ * false if the arena is full.
+ */
+static bool indexAdd( JSONIndex_t * index,
+                      size_t value,
+                      JSONTypes_t type,
+                      size_t key,
+                      size_t keyLength,
+                      uint32_t parent )
+{
+    bool ret = false;
+    JSONIndexEntry_t * entry;
+
+    assert( index != NULL );
+
+    if( index->count < index->capacity )
+    {
+        entry = &index->entries[ index->count ];
+        entry->value = ( uint32_t ) value;
+        entry->valueLength = 0;
+        entry->key = ( uint32_t ) key;
+        entry->keyLength = ( uint32_t ) keyLength;
+        entry->keyHash = ( key == 0U ) ? 0U : hashKey( &index->buf[ key ], keyLength );
+        entry->parent = parent;
+        entry->jsonType = type;
+        index->count++;
+        entry->next = ( uint32_t ) index->count;
+        ret = true;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Output the value of an index entry.
+ *
+ * @param[in] index  The index that was searched.
+ * @param[in] e  The entry that matched.
+ * @param[out] outValue  A pointer to receive the address of the value found.
+ * @param[out] outValueLength  A pointer to receive the length of the value found.
+ * @param[out] outType  An enum indicating the JSON-specific type of the value.
+ */
+static void indexOutput( const JSONIndex_t * index,
+                         uint32_t e,
+                         const char ** outValue,
+                         size_t * outValueLength,
+                         JSONTypes_t * outType )
+{
+    size_t value = index->entries[ e ].value;
+    size_t valueLength = index->entries[ e ].valueLength;
+
+    assert( ( outValue != NULL ) && ( outValueLength != NULL ) );
+
+    if( index->entries[ e ].jsonType == JSONString )
+    {
+        /* strip the surrounding quotes */
+        value++;
+        valueLength -= 2U;
+    }
+
+    *outValue = &index->buf[ value ];
+    *outValueLength = valueLength;
+
+    if( outType != NULL )
+    {
+        *outType = index->entries[ e ].jsonType;
+    }
+}
+
+/**
+ * @brief Validate a document, reporting each value to a visitor.
+ *
+ * The document is parsed iteratively.  The position and value count of
+ * each open collection replace the bit stack used by skipCollection().
+ *
+ * @param[in] buf  The buffer to parse.
+ * @param[in] max  The size of the buffer.
+ * @param[in] visitor  The function called for each value.
+ * @param[in] context  Passed to @p visitor.
+ * @param[in] nesting  The nesting state arrays.
+ *
+ * @return #JSONSuccess if the buffer contents are valid JSON;
+ * #JSONIllegalDocument if the buffer contents are NOT valid JSON;
+ * #JSONMaxDepthExceeded if object and array nesting exceeds a threshold;
+ * #JSONPartial if the buffer contents are potentially valid but incomplete.
+ */
+static JSONStatus_t visitDocument( const char * buf,
+                                   size_t max,
+                                   JSONVisitor_t visitor,
+                                   void * context,
+                                   const JSONNesting_t * nesting )
+{
+    JSONStatus_t ret = JSONPartial;
+    size_t * stack = nesting->start;
+    uint32_t * count = nesting->count;
+    int32_t depth = -1;
+    size_t i = 0, start, key = 0, keyLength = 0;
+    bool expectKey = false, expectValue = true;
+    JSONVisit_t visit;
+    char c;
+
+    assert( ( buf != NULL ) && ( visitor != NULL ) );
+    assert( ( stack != NULL ) && ( count != NULL ) );
+    assert( ( max > 0U ) && ( nesting->maxDepth > 0U ) );
+
+    skipSpace( buf, &i, max );
+
+    while( ( ret == JSONPartial ) && ( i < max ) )
+    {
+        c = buf[ i ];
+
+        if( expectKey == true )
+        {
+            /* A key followed by a colon */
+            start = i;
+
+            if( skipString( buf, &i, max ) != true )
+            {
+                ret = JSONIllegalDocument;
+                break;
+            }
+
+            key = start + 1U;
+            keyLength = i - start - 2U;
+            skipSpace( buf, &i, max );
+
+            if( i >= max )
+            {
+                break;
+            }
+
+            if( buf[ i ] != ':' )
+            {
+                ret = JSONIllegalDocument;
+                break;
+            }
+
+            i++;
+            skipSpace( buf, &i, max );
+            expectKey = false;
+            expectValue = true;
+        }
+        else if( expectValue == true )
+        {
+            visit.value = i;
+            visit.key = key;
+            visit.keyLength = keyLength;
+            visit.arrayIndex = ( depth < 0 ) ? 0U : count[ depth ];
+            visit.depth = ( uint16_t ) ( depth + 1 );
+            visit.jsonType = getType( c );
+
+            if( isOpenBracket_( c ) )
+            {
+                if( ( size_t ) ( depth + 1 ) == nesting->maxDepth )
+                {
+                    ret = JSONMaxDepthExceeded;
+                    break;
+                }
+
+                visit.valueLength = 0;
+                visitor( context, buf, &visit );
+
+                if( depth >= 0 )
+                {
+                    count[ depth ]++;
+                }
+
+                depth++;
+                stack[ depth ] = i;
+                count[ depth ] = 0;
+                key = 0;
+                keyLength = 0;
+                i++;
+                skipSpace( buf, &i, max );
+
+                if( ( i < max ) && isMatchingBracket_( c, buf[ i ] ) )
+                {
+                    /* An empty collection, the close is handled below */
+                    expectValue = false;
+                }
+                else
+                {
+                    expectKey = ( c == '{' ) ? true : false;
+                    expectValue = !expectKey;
+                }
+            }
+            else
+            {
+                #ifdef JSON_VALIDATE_COLLECTIONS_ONLY
+                    if( depth < 0 )
+                    {
+                        ret = JSONIllegalDocument;
+                        break;
+                    }
+                #endif
+
+                if( skipAnyScalar( buf, &i, max ) != true )
+                {
+                    ret = JSONIllegalDocument;
+                    break;
+                }
+
+                visit.valueLength = i - visit.value;
+                visitor( context, buf, &visit );
+
+                if( depth >= 0 )
+                {
+                    count[ depth ]++;
+                }
+
+                key = 0;
+                keyLength = 0;
+                expectValue = false;
+
+                if( depth < 0 )
+                {
+                    ret = JSONSuccess;
+                }
+            }
+        }
+        else
+        {
+            /* A comma or the close of the innermost collection */
+            skipSpace( buf, &i, max );
+
+            if( i >= max )
+            {
+                break;
+            }
+
+            c = buf[ i ];
+
+            if( c == ',' )
+            {
+                i++;
+                skipSpace( buf, &i, max );
+
+                if( ( i < max ) && isCloseBracket_( buf[ i ] ) )
+                {
+                    ret = JSONIllegalDocument;
+                    break;
+                }
+
+                expectKey = ( buf[ stack[ depth ] ] == '{' ) ? true : false;
+                expectValue = !expectKey;
+            }
+            else if( isMatchingBracket_( buf[ stack[ depth ] ], c ) )
+            {
+                i++;
+                visit.value = stack[ depth ];
+                visit.valueLength = i - stack[ depth ];
+                visit.key = 0;
+                visit.keyLength = 0;
+                visit.arrayIndex = ( depth > 0 ) ? ( count[ depth - 1 ] - 1U ) : 0U;
+                visit.depth = ( uint16_t ) depth;
+                visit.jsonType = getType( buf[ stack[ depth ] ] );
+                visitor( context, buf, &visit );
+                depth--;
+
+                if( depth < 0 )
+                {
+                    ret = JSONSuccess;
+                }
+            }
+            else
+            {
+                ret = JSONIllegalDocument;
+            }
+        }
+    }
+
+    if( ( ret == JSONSuccess ) && ( i < max ) )
+    {
+        skipSpace( buf, &i, max );
+
+        if( i != max )
+        {
+            ret = JSONIllegalDocument;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief State used while building a structural index.
+ */
+typedef struct
+{
+    JSONIndex_t * index;
+    uint32_t stack[ JSON_MAX_DEPTH ]; /* entries of the open collections */
+    bool full;
+} indexContext_t;
+
+/**
+ * @brief Visitor that records each value in a structural index.
+ *
+ * Once the arena is full the remaining values are ignored so the
+ * document is still validated.
+ *
+ * @param[in] context  The index build state.
+ * @param[in] buf  The buffer being indexed.
+ * @param[in] visit  The value being reported.
+ */
+static void indexVisit( void * context,
+                        const char * buf,
+                        const JSONVisit_t * visit )
+{
+    indexContext_t * ctx = ( indexContext_t * ) context;
+    JSONIndex_t * index = ctx->index;
+    bool collection = ( ( visit->jsonType == JSONObject ) || ( visit->jsonType == JSONArray ) );
+
+    ( void ) buf;
+
+    if( ctx->full == false )
+    {
+        if( collection && ( visit->valueLength > 0U ) )
+        {
+            JSONIndexEntry_t * entry = &index->entries[ ctx->stack[ visit->depth ] ];
+
+            entry->valueLength = ( uint32_t ) visit->valueLength;
+            entry->next = ( uint32_t ) index->count;
+        }
+        else
+        {
+            uint32_t parent = ( visit->depth == 0U ) ? JSON_INDEX_NONE : ctx->stack[ visit->depth - 1U ];
+
+            if( indexAdd( index, visit->value, visit->jsonType, visit->key, visit->keyLength, parent ) != true )
+            {
+                ctx->full = true;
+            }
+            else if( collection )
+            {
+                ctx->stack[ visit->depth ] = ( uint32_t ) ( index->count - 1U );
+            }
+            else
+            {
+                index->entries[ index->count - 1U ].valueLength = ( uint32_t ) visit->valueLength;
+            }
+        }
+    }
+}
+
+/** @endcond */
+
+/**
+ * See core_json.h for docs.
+ */
+JSONStatus_t JSON_ValidateVisit( const char * buf,
+                                 size_t max,
+                                 JSONVisitor_t visitor,
+                                 void * context )
+{
+    JSONStatus_t ret;
+
+    if( ( buf == NULL ) || ( visitor == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else if( max == 0U )
+    {
+        ret = JSONBadParameter;
+    }
+    else
+    {
+        size_t start[ JSON_MAX_DEPTH ];
+        uint32_t count[ JSON_MAX_DEPTH ];
+        JSONNesting_t nesting = { start, count, JSON_MAX_DEPTH };
+
+        ret = visitDocument( buf, max, visitor, context, &nesting );
+    }
+
+    return ret;
+}
+
+/**
+ * See core_json.h for docs.
+ */
+JSONStatus_t JSON_ValidateVisitNested( const char * buf,
+                                       size_t max,
+                                       JSONVisitor_t visitor,
+                                       void * context,
+                                       const JSONNesting_t * nesting )
+{
+    JSONStatus_t ret;
+
+    if( ( buf == NULL ) || ( visitor == NULL ) || ( nesting == NULL ) ||
+        ( nesting->start == NULL ) || ( nesting->count == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else if( ( max == 0U ) || ( nesting->maxDepth == 0U ) )
+    {
+        ret = JSONBadParameter;
+    }
+    else
+    {
+        ret = visitDocument( buf, max, visitor, context, nesting );
+    }
+
+    return ret;
+}
+
+/**
+ * See core_json.h for docs.
+ */
+JSONStatus_t JSON_IndexBuild( const char * buf,
+                              size_t max,
+                              JSONIndex_t * index,
+                              JSONIndexEntry_t * arena,
+                              size_t arenaCount )
+{
+    JSONStatus_t ret;
+    indexContext_t context;
+    size_t start[ JSON_MAX_DEPTH ];
+    uint32_t count[ JSON_MAX_DEPTH ];
+    JSONNesting_t nesting = { start, count, JSON_MAX_DEPTH };
+
+    if( ( buf == NULL ) || ( index == NULL ) || ( arena == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else if( ( max == 0U ) || ( arenaCount == 0U ) || ( max >= ( size_t ) JSON_INDEX_NONE ) )
+    {
+        ret = JSONBadParameter;
+    }
+    else
+    {
+        index->buf = buf;
+        index->max = max;
+        index->entries = arena;
+        index->capacity = arenaCount;
+        index->count = 0;
+
+        context.index = index;
+        context.full = false;
+
+        ret = visitDocument( buf, max, indexVisit, &context, &nesting );
+
+        if( ( ret == JSONSuccess ) && ( context.full == true ) )
+        {
+            ret = JSONIndexFull;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * See core_json.h for docs.
+ *
+ * Members of a collection are visited by following the next links
+ * so nested values are never rescanned.
+ */
+JSONStatus_t JSON_IndexSearch( const JSONIndex_t * index,
+                               const char * query,
+                               size_t queryLength,
+                               const char ** outValue,
+                               size_t * outValueLength,
+                               JSONTypes_t * outType )
+{
+    JSONStatus_t ret = JSONSuccess;
+    size_t i = 0, queryStart, keyLength;
+    uint32_t e = 0, member, queryIndex, currentIndex;
+    const JSONIndexEntry_t * entries;
+
+    if( ( index == NULL ) || ( query == NULL ) ||
+        ( outValue == NULL ) || ( outValueLength == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else if( ( index->count == 0U ) || ( queryLength == 0U ) )
+    {
+        ret = JSONBadParameter;
+    }
+    else
+    {
+        entries = index->entries;
+
+        while( i < queryLength )
+        {
+            bool found = false;
+
+            if( isSquareOpen_( query[ i ] ) )
+            {
+                int32_t value = -1;
+                i++;
+
+                ( void ) skipDigits( query, &i, queryLength, &value );
+
+                if( ( value < 0 ) ||
+                    ( i >= queryLength ) || !isSquareClose_( query[ i ] ) )
+                {
+                    ret = JSONBadParameter;
+                    break;
+                }
+
+                i++;
+                queryIndex = ( uint32_t ) value;
+
+                if( entries[ e ].jsonType == JSONArray )
+                {
+                    currentIndex = 0;
+
+                    for( member = e + 1U; member < entries[ e ].next; member = entries[ member ].next )
+                    {
+                        if( currentIndex == queryIndex )
+                        {
+                            found = true;
+                            break;
+                        }
+
+                        currentIndex++;
+                    }
+                }
+            }
+            else
+            {
+                keyLength = 0;
+                queryStart = i;
+
+                if( ( skipQueryPart( query, &i, queryLength, &keyLength ) != true ) ||
+                    /* catch an empty key part or a trailing separator */
+                    ( i == ( queryLength - 1U ) ) )
+                {
+                    ret = JSONBadParameter;
+                    break;
+                }
+
+                if( entries[ e ].jsonType == JSONObject )
+                {
+                    for( member = e + 1U; member < entries[ e ].next; member = entries[ member ].next )
+                    {
+                        if( ( entries[ member ].keyLength == keyLength ) &&
+                            ( strnEq( &query[ queryStart ], &index->buf[ entries[ member ].key ], keyLength ) == true ) )
+                        {
+                            found = true;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if( found == false )
+            {
+                ret = JSONNotFound;
+                break;
+            }
+
+            e = member;
+
+            if( ( i < queryLength ) && isSeparator_( query[ i ] ) )
+            {
+                i++;
+            }
+        }
+    }
+
+    if( ret == JSONSuccess )
+    {
+        indexOutput( index, e, outValue, outValueLength, outType );
+    }
+
+    return ret;
+}
+
+/**
+ * See core_json.h for docs.
+ *
+ * The parts are located the same way multiSearch() locates them.
+ */
+JSONStatus_t JSON_QueryCompile( const char * query,
+                                size_t queryLength,
+                                JSONQuery_t * outQuery )
+{
+    JSONStatus_t ret = JSONSuccess;
+    size_t i = 0, queryStart, keyLength, partCount = 0, wildcardCount = 0;
+    JSONQueryPart_t * part;
+
+    if( ( query == NULL ) || ( outQuery == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else if( ( queryLength == 0U ) || ( queryLength > 0xFFFFU ) )
+    {
+        ret = JSONBadParameter;
+    }
+    else
+    {
+        while( i < queryLength )
+        {
+            if( partCount == JSON_QUERY_MAX_PARTS )
+            {
+                ret = JSONBadParameter;
+                break;
+            }
+
+            part = &outQuery->parts[ partCount ];
+
+            if( isSquareOpen_( query[ i ] ) )
+            {
+                int32_t queryIndex = -1;
+                queryStart = i;
+                i++;
+
+                if( ( i < queryLength ) && ( query[ i ] == '*' ) )
+                {
+                    i++;
+                    queryIndex = 0;
+                }
+                else
+                {
+                    ( void ) skipDigits( query, &i, queryLength, &queryIndex );
+                }
+
+                if( ( queryIndex < 0 ) ||
+                    ( i >= queryLength ) || !isSquareClose_( query[ i ] ) )
+                {
+                    ret = JSONBadParameter;
+                    break;
+                }
+
+                i++;
+
+                part->keyHash = 0;
+                part->arrayIndex = ( uint32_t ) queryIndex;
+                part->keyOffset = 0;
+                part->keyLength = 0;
+
+                if( query[ queryStart + 1U ] == '*' )
+                {
+                    part->arrayIndex = JSON_QUERY_ANY_INDEX;
+                    wildcardCount++;
+                }
+            }
+            else
+            {
+                keyLength = 0;
+                queryStart = i;
+
+                if( ( skipQueryPart( query, &i, queryLength, &keyLength ) != true ) ||
+                    /* catch an empty key part or a trailing separator */
+                    ( i == ( queryLength - 1U ) ) )
+                {
+                    ret = JSONBadParameter;
+                    break;
+                }
+
+                part->keyHash = hashKey( &query[ queryStart ], keyLength );
+                part->arrayIndex = JSON_QUERY_KEY;
+                part->keyOffset = ( uint16_t ) queryStart;
+                part->keyLength = ( uint16_t ) keyLength;
+
+                if( ( keyLength == 1U ) && ( query[ queryStart ] == '*' ) )
+                {
+                    part->arrayIndex = JSON_QUERY_ANY_KEY;
+                    wildcardCount++;
+                }
+            }
+
+            partCount++;
+
+            if( ( i < queryLength ) && isSeparator_( query[ i ] ) )
+            {
+                i++;
+            }
+        }
+
+        outQuery->partCount = ( ret == JSONSuccess ) ? partCount : 0U;
+        outQuery->wildcardCount = ( ret == JSONSuccess ) ? wildcardCount : 0U;
+    }
+
+    return ret;
+}
+
+/**
+ * See core_json.h for docs.
+ */
+JSONStatus_t JSON_SearchCompiled( const char * buf,
+                                  size_t max,
+                                  const char * query,
+                                  const JSONQuery_t * compiled,
+                                  const char ** outValue,
+                                  size_t * outValueLength,
+                                  JSONTypes_t * outType )
+{
+    JSONStatus_t ret = JSONSuccess;
+    size_t p, start = 0, value = 0, length = max;
+
+    if( ( buf == NULL ) || ( query == NULL ) || ( compiled == NULL ) ||
+        ( outValue == NULL ) || ( outValueLength == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else if( ( max == 0U ) || ( compiled->partCount == 0U ) || ( compiled->wildcardCount > 0U ) )
+    {
+        ret = JSONBadParameter;
+    }
+    else
+    {
+        for( p = 0; p < compiled->partCount; p++ )
+        {
+            const JSONQueryPart_t * part = &compiled->parts[ p ];
+            bool found;
+
+            if( part->arrayIndex != JSON_QUERY_KEY )
+            {
+                found = arraySearch( &buf[ start ], length, part->arrayIndex, &value, &length );
+            }
+            else
+            {
+                found = objectSearch( &buf[ start ], length, &query[ part->keyOffset ],
+                                      part->keyLength, NULL, &value, &length );
+            }
+
+            if( found == false )
+            {
+                ret = JSONNotFound;
+                break;
+            }
+
+            start += value;
+        }
+    }
+
+    if( ret == JSONSuccess )
+    {
+        JSONTypes_t t = getType( buf[ start ] );
+
+        if( t == JSONString )
+        {
+            /* strip the surrounding quotes */
+            start++;
+            length -= 2U;
+        }
+
+        *outValue = &buf[ start ];
+        *outValueLength = length;
+
+        if( outType != NULL )
+        {
+            *outType = t;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * See core_json.h for docs.
+ */
+void JSON_CursorInit( JSONCursor_t * cursor )
+{
+    if( cursor != NULL )
+    {
+        cursor->buf = NULL;
+        cursor->max = 0;
+    }
+}
+
+/**
+ * See core_json.h for docs.
+ *
+ * This is JSON_SearchCompiled() except that each part first checks the
+ * value the cursor found for the same part in the same collection.
+ */
+JSONStatus_t JSON_SearchCursor( const char * buf,
+                                size_t max,
+                                const char * query,
+                                const JSONQuery_t * compiled,
+                                JSONCursor_t * cursor,
+                                const char ** outValue,
+                                size_t * outValueLength,
+                                JSONTypes_t * outType )
+{
+    JSONStatus_t ret = JSONSuccess;
+    size_t p, start = 0, key = 0, value = 0, length = max;
+    bool found, cached;
+
+    if( ( buf == NULL ) || ( query == NULL ) || ( compiled == NULL ) || ( cursor == NULL ) ||
+        ( outValue == NULL ) || ( outValueLength == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else if( ( max == 0U ) || ( compiled->partCount == 0U ) || ( compiled->wildcardCount > 0U ) )
+    {
+        ret = JSONBadParameter;
+    }
+    else
+    {
+        if( ( cursor->buf != buf ) || ( cursor->max != max ) )
+        {
+            /* A different document, forget every part's value */
+            for( p = 0; p < JSON_QUERY_MAX_PARTS; p++ )
+            {
+                cursor->parts[ p ].collection = JSON_CURSOR_NONE;
+            }
+
+            cursor->buf = buf;
+            cursor->max = max;
+        }
+
+        for( p = 0; p < compiled->partCount; p++ )
+        {
+            const JSONQueryPart_t * part = &compiled->parts[ p ];
+            JSONCursorPart_t * cursorPart = &cursor->parts[ p ];
+
+            cached = false;
+
+            if( cursorPart->collection == start )
+            {
+                if( part->arrayIndex == JSON_QUERY_KEY )
+                {
+                    cached = ( ( cursorPart->arrayIndex == JSON_QUERY_KEY ) &&
+                               ( cursorPart->keyLength == part->keyLength ) &&
+                               ( strnEq( &buf[ cursorPart->key ], &query[ part->keyOffset ],
+                                         part->keyLength ) == true ) );
+                }
+                else
+                {
+                    cached = ( cursorPart->arrayIndex == part->arrayIndex );
+                }
+            }
+
+            if( cached == true )
+            {
+                found = true;
+                value = cursorPart->value - start;
+                length = cursorPart->valueLength;
+            }
+            else if( part->arrayIndex == JSON_QUERY_KEY )
+            {
+                found = objectSearch( &buf[ start ], length, &query[ part->keyOffset ],
+                                      part->keyLength, &key, &value, &length );
+                key += start;
+            }
+            else if( ( cursorPart->collection == start ) && ( cursorPart->arrayIndex != JSON_QUERY_KEY ) &&
+                     ( cursorPart->arrayIndex < part->arrayIndex ) )
+            {
+                /* resume from the previous element of the same array */
+                found = arraySearchFrom( &buf[ start ], length, cursorPart->value - start,
+                                         cursorPart->arrayIndex, part->arrayIndex, &value, &length );
+            }
+            else
+            {
+                found = arraySearch( &buf[ start ], length, part->arrayIndex, &value, &length );
+            }
+
+            if( found == false )
+            {
+                ret = JSONNotFound;
+                break;
+            }
+
+            if( cached == false )
+            {
+                cursorPart->collection = start;
+                cursorPart->value = start + value;
+                cursorPart->valueLength = length;
+                cursorPart->key = key;
+                cursorPart->keyLength = part->keyLength;
+                cursorPart->arrayIndex = part->arrayIndex;
+            }
+
+            start += value;
+        }
+    }
+
+    if( ret == JSONSuccess )
+    {
+        JSONTypes_t t = getType( buf[ start ] );
+
+        if( t == JSONString )
+        {
+            /* strip the surrounding quotes */
+            start++;
+            length -= 2U;
+        }
+
+        *outValue = &buf[ start ];
+        *outValueLength = length;
+
+        if( outType != NULL )
+        {
+            *outType = t;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * See core_json.h for docs.
+ */
+JSONStatus_t JSON_IndexSearchCompiled( const JSONIndex_t * index,
+                                       const char * query,
+                                       const JSONQuery_t * compiled,
+                                       const char ** outValue,
+                                       size_t * outValueLength,
+                                       JSONTypes_t * outType )
+{
+    JSONStatus_t ret = JSONSuccess;
+    size_t p;
+    uint32_t e = 0, member, currentIndex;
+    const JSONIndexEntry_t * entries;
+
+    if( ( index == NULL ) || ( query == NULL ) || ( compiled == NULL ) ||
+        ( outValue == NULL ) || ( outValueLength == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else if( ( index->count == 0U ) || ( compiled->partCount == 0U ) || ( compiled->wildcardCount > 0U ) )
+    {
+        ret = JSONBadParameter;
+    }
+    else
+    {
+        entries = index->entries;
+
+        for( p = 0; p < compiled->partCount; p++ )
+        {
+            const JSONQueryPart_t * part = &compiled->parts[ p ];
+            bool found = false;
+
+            if( part->arrayIndex != JSON_QUERY_KEY )
+            {
+                if( entries[ e ].jsonType == JSONArray )
+                {
+                    currentIndex = 0;
+
+                    for( member = e + 1U; member < entries[ e ].next; member = entries[ member ].next )
+                    {
+                        if( currentIndex == part->arrayIndex )
+                        {
+                            found = true;
+                            break;
+                        }
+
+                        currentIndex++;
+                    }
+                }
+            }
+            else if( entries[ e ].jsonType == JSONObject )
+            {
+                for( member = e + 1U; member < entries[ e ].next; member = entries[ member ].next )
+                {
+                    if( ( entries[ member ].keyLength == part->keyLength ) &&
+                        ( entries[ member ].keyHash == part->keyHash ) &&
+                        ( strnEq( &query[ part->keyOffset ], &index->buf[ entries[ member ].key ],
+                                  part->keyLength ) == true ) )
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                /* MISRA 15.7 */
+            }
+
+            if( found == false )
+            {
+                ret = JSONNotFound;
+                break;
+            }
+
+            e = member;
+        }
+    }
+
+    if( ret == JSONSuccess )
+    {
+        indexOutput( index, e, outValue, outValueLength, outType );
+    }
+
+    return ret;
+}
+
+/** @cond DO_NOT_DOCUMENT */
+
+#define isWildcard_( x )    ( ( ( x ) == JSON_QUERY_ANY_INDEX ) || ( ( x ) == JSON_QUERY_ANY_KEY ) )
+
+/**
+ * @brief State used while searching for every match of a query.
+ */
+typedef struct
+{
+    const char * query;
+    const JSONQuery_t * compiled;
+    JSONMatchCallback_t callback;
+    void * context;
+    size_t matchDepth; /* number of leading parts matched by the current value's ancestors */
+    size_t matchCount;
+    JSONWildcard_t wildcards[ JSON_QUERY_MAX_PARTS ];
+} searchEachContext_t;
+
+/**
+ * @brief Report a matched value to the search's callback.
+ *
+ * @param[in] ctx  The search state.
+ * @param[in] buf  The buffer being searched.
+ * @param[in] visit  The matched value.
+ */
+static void searchEachReport( searchEachContext_t * ctx,
+                              const char * buf,
+                              const JSONVisit_t * visit )
+{
+    JSONMatch_t match;
+
+    match.value = &buf[ visit->value ];
+    match.valueLength = visit->valueLength;
+    match.jsonType = visit->jsonType;
+    match.wildcards = ctx->wildcards;
+    match.wildcardCount = ctx->compiled->wildcardCount;
+
+    if( visit->jsonType == JSONString )
+    {
+        /* strip the surrounding quotes */
+        match.value++;
+        match.valueLength -= 2U;
+    }
+
+    ctx->callback( ctx->context, &match );
+    ctx->matchCount++;
+}
+
+/**
+ * @brief Visitor that matches each value against a compiled query.
+ *
+ * A value at depth D extends the match of a query whose first D-1 parts
+ * matched the value's ancestors.  A collection is matched when it opens
+ * and reported when it closes so its full length is known.
+ *
+ * @param[in] context  The search state.
+ * @param[in] buf  The buffer being searched.
+ * @param[in] visit  The value being reported.
+ */
+static void searchEachVisit( void * context,
+                             const char * buf,
+                             const JSONVisit_t * visit )
+{
+    searchEachContext_t * ctx = ( searchEachContext_t * ) context;
+    const JSONQuery_t * compiled = ctx->compiled;
+    const JSONQueryPart_t * part;
+    size_t depth = visit->depth, p, w;
+    bool collection = ( ( visit->jsonType == JSONObject ) || ( visit->jsonType == JSONArray ) );
+    bool match;
+
+    if( ( depth == 0U ) || ( depth > compiled->partCount ) )
+    {
+        /* The root or a value nested below the query's last part */
+    }
+    else if( collection && ( visit->valueLength > 0U ) )
+    {
+        if( ( depth == compiled->partCount ) && ( ctx->matchDepth == depth ) )
+        {
+            searchEachReport( ctx, buf, visit );
+        }
+    }
+    else
+    {
+        if( ctx->matchDepth >= depth )
+        {
+            ctx->matchDepth = depth - 1U;
+        }
+
+        if( ctx->matchDepth == ( depth - 1U ) )
+        {
+            part = &compiled->parts[ depth - 1U ];
+
+            /* The part's position among the query's wildcards */
+            w = 0;
+
+            for( p = 0; p < ( depth - 1U ); p++ )
+            {
+                if( isWildcard_( compiled->parts[ p ].arrayIndex ) )
+                {
+                    w++;
+                }
+            }
+
+            if( part->arrayIndex == JSON_QUERY_KEY )
+            {
+                match = ( ( visit->key != 0U ) && ( visit->keyLength == part->keyLength ) &&
+                          ( strnEq( &buf[ visit->key ], &ctx->query[ part->keyOffset ], part->keyLength ) == true ) );
+            }
+            else if( part->arrayIndex == JSON_QUERY_ANY_KEY )
+            {
+                match = ( visit->key != 0U );
+                ctx->wildcards[ w ].key = &buf[ visit->key ];
+                ctx->wildcards[ w ].keyLength = visit->keyLength;
+                ctx->wildcards[ w ].arrayIndex = 0;
+            }
+            else if( part->arrayIndex == JSON_QUERY_ANY_INDEX )
+            {
+                match = ( visit->key == 0U );
+                ctx->wildcards[ w ].key = NULL;
+                ctx->wildcards[ w ].keyLength = 0;
+                ctx->wildcards[ w ].arrayIndex = visit->arrayIndex;
+            }
+            else
+            {
+                match = ( ( visit->key == 0U ) && ( visit->arrayIndex == part->arrayIndex ) );
+            }
+
+            if( match == true )
+            {
+                ctx->matchDepth = depth;
+
+                if( ( depth == compiled->partCount ) && !collection )
+                {
+                    searchEachReport( ctx, buf, visit );
+                }
+            }
+        }
+    }
+}
+
+/** @endcond */
+
+/**
+ * See core_json.h for docs.
+ */
+JSONStatus_t JSON_SearchEach( const char * buf,
+                              size_t max,
+                              const char * query,
+                              size_t queryLength,
+                              JSONMatchCallback_t callback,
+                              void * context )
+{
+    JSONStatus_t ret;
+    JSONQuery_t compiled;
+
+    if( ( buf == NULL ) || ( query == NULL ) || ( callback == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else
+    {
+        ret = JSON_QueryCompile( query, queryLength, &compiled );
+
+        if( ret == JSONSuccess )
+        {
+            ret = JSON_SearchEachCompiled( buf, max, query, &compiled, callback, context );
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * See core_json.h for docs.
+ */
+JSONStatus_t JSON_SearchEachCompiled( const char * buf,
+                                      size_t max,
+                                      const char * query,
+                                      const JSONQuery_t * compiled,
+                                      JSONMatchCallback_t callback,
+                                      void * context )
+{
+    JSONStatus_t ret;
+    searchEachContext_t ctx;
+
+    if( ( buf == NULL ) || ( query == NULL ) || ( compiled == NULL ) || ( callback == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else if( ( max == 0U ) || ( compiled->partCount == 0U ) )
+    {
+        ret = JSONBadParameter;
+    }
+    else
+    {
+        ctx.query = query;
+        ctx.compiled = compiled;
+        ctx.callback = callback;
+        ctx.context = context;
+        ctx.matchDepth = 0;
+        ctx.matchCount = 0;
+
+        ret = JSON_ValidateVisit( buf, max, searchEachVisit, &ctx );
+
+        if( ( ret == JSONSuccess ) && ( ctx.matchCount == 0U ) )
+        {
+            ret = JSONNotFound;
+        }
+    }
+
+    return ret;
+}
+
+/** @cond DO_NOT_DOCUMENT */
+
+/**
+ * @brief What a stream expects next.
+ */
+typedef enum
+{
+    streamValue,      /* a value */
+    streamFirstValue, /* a value or the close of an empty array */
+    streamKey,        /* a key */
+    streamFirstKey,   /* a key or the close of an empty object */
+    streamColon,      /* the colon following a key */
+    streamNext,       /* a comma or the close of the innermost collection */
+    streamDone        /* whitespace following a complete document */
+} streamState_t;
+
+/**
+ * @brief Kind of token a stream is accumulating in its window.
+ */
+typedef enum
+{
+    streamTokenNone,
+    streamTokenKey,
+    streamTokenString,
+    streamTokenScalar
+} streamToken_t;
+
+/**
+ * @brief Append a character to a stream's window.
+ *
+ * @param[in,out] stream  The stream.
+ * @param[in] c  The character.
+ *
+ * @return true if the character was appended;
+ * false if the window is full.
+ */
+static bool streamAppend( JSONStream_t * stream,
+                          char c )
+{
+    bool ret = false;
+
+    if( stream->windowLength < JSON_STREAM_WINDOW_LEN )
+    {
+        stream->window[ stream->windowLength ] = c;
+        stream->windowLength++;
+        ret = true;
+    }
+    else
+    {
+        stream->status = JSONTokenTooLong;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Report the value in a stream's window to the visitor.
+ *
+ * @param[in] stream  The stream.
+ * @param[in] valueLength  The length of the value.
+ * @param[in] type  The type of the value.
+ */
+static void streamVisit( const JSONStream_t * stream,
+                         size_t valueLength,
+                         JSONTypes_t type )
+{
+    JSONVisit_t visit;
+
+    visit.value = stream->valueStart;
+    visit.valueLength = valueLength;
+    visit.key = ( stream->member == true ) ? 1U : 0U;
+    visit.keyLength = ( stream->member == true ) ? ( stream->valueStart - 2U ) : 0U;
+    visit.arrayIndex = ( stream->depth < 0 ) ? 0U : stream->count[ stream->depth ];
+    visit.depth = ( uint16_t ) ( stream->depth + 1 );
+    visit.jsonType = type;
+
+    stream->visitor( stream->context, stream->window, &visit );
+}
+
+/**
+ * @brief Clear a stream's window and expect what follows a value.
+ *
+ * @param[in,out] stream  The stream.
+ */
+static void streamValueDone( JSONStream_t * stream )
+{
+    stream->member = false;
+    stream->valueStart = 0;
+    stream->windowLength = 0;
+
+    if( stream->depth < 0 )
+    {
+        stream->state = ( uint8_t ) streamDone;
+        stream->status = JSONSuccess;
+    }
+    else
+    {
+        stream->state = ( uint8_t ) streamNext;
+    }
+}
+
+/**
+ * @brief Validate the key or scalar a stream accumulated in its window.
+ *
+ * The window is validated with the same functions as a complete buffer.
+ *
+ * @param[in,out] stream  The stream.
+ */
+static void streamTokenEnd( JSONStream_t * stream )
+{
+    size_t i = stream->valueStart;
+    streamToken_t token = ( streamToken_t ) stream->token;
+
+    stream->token = ( uint8_t ) streamTokenNone;
+
+    if( token == streamTokenKey )
+    {
+        if( ( skipString( stream->window, &i, stream->windowLength ) == true ) &&
+            ( i == stream->windowLength ) )
+        {
+            stream->member = true;
+            stream->valueStart = stream->windowLength;
+            stream->state = ( uint8_t ) streamColon;
+        }
+        else
+        {
+            stream->status = JSONIllegalDocument;
+        }
+    }
+    else
+    {
+        #ifdef JSON_VALIDATE_COLLECTIONS_ONLY
+            if( stream->depth < 0 )
+            {
+                stream->status = JSONIllegalDocument;
+            }
+        #endif
+
+        if( ( stream->status == JSONPartial ) &&
+            ( skipAnyScalar( stream->window, &i, stream->windowLength ) == true ) &&
+            ( i == stream->windowLength ) )
+        {
+            streamVisit( stream, stream->windowLength - stream->valueStart,
+                         getType( stream->window[ stream->valueStart ] ) );
+
+            if( stream->depth >= 0 )
+            {
+                stream->count[ stream->depth ]++;
+            }
+
+            streamValueDone( stream );
+        }
+        else
+        {
+            stream->status = JSONIllegalDocument;
+        }
+    }
+}
+
+/**
+ * @brief Open a collection.
+ *
+ * @param[in,out] stream  The stream.
+ * @param[in] c  The opening bracket.
+ */
+static void streamOpen( JSONStream_t * stream,
+                        char c )
+{
+    if( ( stream->depth + 1 ) == JSON_MAX_DEPTH )
+    {
+        stream->status = JSONMaxDepthExceeded;
+    }
+    else if( streamAppend( stream, c ) == true )
+    {
+        streamVisit( stream, 0, getType( c ) );
+
+        if( stream->depth >= 0 )
+        {
+            stream->count[ stream->depth ]++;
+        }
+
+        stream->depth++;
+        stream->start[ stream->depth ] = stream->position;
+        stream->count[ stream->depth ] = 0;
+        stream->open[ stream->depth ] = c;
+        stream->member = false;
+        stream->valueStart = 0;
+        stream->windowLength = 0;
+        stream->state = ( uint8_t ) ( ( c == '{' ) ? streamFirstKey : streamFirstValue );
+    }
+    else
+    {
+        /* MISRA 15.7 */
+    }
+}
+
+/**
+ * @brief Close the innermost collection.
+ *
+ * @param[in,out] stream  The stream.
+ */
+static void streamClose( JSONStream_t * stream )
+{
+    JSONVisit_t visit;
+    int16_t depth = stream->depth;
+
+    stream->window[ 0 ] = stream->open[ depth ];
+
+    visit.value = 0;
+    visit.valueLength = stream->position + 1U - stream->start[ depth ];
+    visit.key = 0;
+    visit.keyLength = 0;
+    visit.arrayIndex = ( depth > 0 ) ? ( stream->count[ depth - 1 ] - 1U ) : 0U;
+    visit.depth = ( uint16_t ) depth;
+    visit.jsonType = getType( stream->open[ depth ] );
+
+    stream->visitor( stream->context, stream->window, &visit );
+
+    stream->depth--;
+    streamValueDone( stream );
+}
+
+/**
+ * @brief Parse one character of a stream.
+ *
+ * @param[in,out] stream  The stream.
+ * @param[in] c  The character.
+ */
+static void streamChar( JSONStream_t * stream,
+                        char c )
+{
+    bool consumed = false;
+
+    if( ( stream->token == ( uint8_t ) streamTokenKey ) ||
+        ( stream->token == ( uint8_t ) streamTokenString ) )
+    {
+        consumed = true;
+
+        if( streamAppend( stream, c ) == true )
+        {
+            if( stream->escape == true )
+            {
+                stream->escape = false;
+            }
+            else if( c == '\\' )
+            {
+                stream->escape = true;
+            }
+            else if( c == '"' )
+            {
+                streamTokenEnd( stream );
+            }
+            else
+            {
+                /* MISRA 15.7 */
+            }
+        }
+    }
+    else if( stream->token == ( uint8_t ) streamTokenScalar )
+    {
+        if( !isspace_( c ) && ( c != ',' ) && !isCloseBracket_( c ) )
+        {
+            consumed = true;
+            ( void ) streamAppend( stream, c );
+        }
+        else
+        {
+            /* The delimiter is handled by the state that follows the scalar. */
+            streamTokenEnd( stream );
+            consumed = ( ( stream->status != JSONPartial ) && ( stream->status != JSONSuccess ) );
+        }
+    }
+    else
+    {
+        /* MISRA 15.7 */
+    }
+
+    if( ( consumed == false ) && !isspace_( c ) )
+    {
+        switch( ( streamState_t ) stream->state )
+        {
+            case streamFirstValue:
+            case streamValue:
+
+                if( ( stream->state == ( uint8_t ) streamFirstValue ) &&
+                    isMatchingBracket_( stream->open[ stream->depth ], c ) )
+                {
+                    streamClose( stream );
+                }
+                else if( isOpenBracket_( c ) )
+                {
+                    streamOpen( stream, c );
+                }
+                else if( isCloseBracket_( c ) || ( c == ',' ) || ( c == ':' ) )
+                {
+                    stream->status = JSONIllegalDocument;
+                }
+                else
+                {
+                    stream->token = ( uint8_t ) ( ( c == '"' ) ? streamTokenString : streamTokenScalar );
+                    stream->escape = false;
+                    ( void ) streamAppend( stream, c );
+                }
+
+                break;
+
+            case streamFirstKey:
+            case streamKey:
+
+                if( ( stream->state == ( uint8_t ) streamFirstKey ) && ( c == '}' ) )
+                {
+                    streamClose( stream );
+                }
+                else if( c == '"' )
+                {
+                    stream->token = ( uint8_t ) streamTokenKey;
+                    stream->escape = false;
+                    stream->windowLength = 0;
+                    ( void ) streamAppend( stream, c );
+                }
+                else
+                {
+                    stream->status = JSONIllegalDocument;
+                }
+
+                break;
+
+            case streamColon:
+
+                if( c == ':' )
+                {
+                    stream->state = ( uint8_t ) streamValue;
+                }
+                else
+                {
+                    stream->status = JSONIllegalDocument;
+                }
+
+                break;
+
+            case streamNext:
+
+                if( c == ',' )
+                {
+                    stream->state = ( uint8_t ) ( ( stream->open[ stream->depth ] == '{' ) ? streamKey : streamValue );
+                }
+                else if( isMatchingBracket_( stream->open[ stream->depth ], c ) )
+                {
+                    streamClose( stream );
+                }
+                else
+                {
+                    stream->status = JSONIllegalDocument;
+                }
+
+                break;
+
+            default:
+
+                /* Only whitespace may follow a complete document */
+                stream->status = JSONIllegalDocument;
+                break;
+        }
+    }
+
+    stream->position++;
+}
+
+/** @endcond */
+
+/**
+ * See core_json.h for docs.
+ */
+JSONStatus_t JSON_StreamInit( JSONStream_t * stream,
+                              JSONVisitor_t visitor,
+                              void * context )
+{
+    JSONStatus_t ret = JSONSuccess;
+
+    if( ( stream == NULL ) || ( visitor == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else
+    {
+        stream->visitor = visitor;
+        stream->context = context;
+        stream->status = JSONPartial;
+        stream->position = 0;
+        stream->depth = -1;
+        stream->state = ( uint8_t ) streamValue;
+        stream->token = ( uint8_t ) streamTokenNone;
+        stream->escape = false;
+        stream->member = false;
+        stream->valueStart = 0;
+        stream->windowLength = 0;
+    }
+
+    return ret;
+}
+
+/**
+ * See core_json.h for docs.
+ *
+ * Keys and scalars are accumulated in the window until their final
+ * character is seen and then validated as a whole.
+ */
+JSONStatus_t JSON_StreamParse( JSONStream_t * stream,
+                               const char * chunk,
+                               size_t length )
+{
+    JSONStatus_t ret;
+    size_t i;
+
+    if( ( stream == NULL ) || ( chunk == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else
+    {
+        for( i = 0; ( i < length ) &&
+             ( ( stream->status == JSONPartial ) || ( stream->status == JSONSuccess ) ); i++ )
+        {
+            streamChar( stream, chunk[ i ] );
+        }
+
+        ret = stream->status;
+    }
+
+    return ret;
+}
+
+/**
+ * See core_json.h for docs.
+ */
+JSONStatus_t JSON_StreamFinish( JSONStream_t * stream )
+{
+    JSONStatus_t ret;
+
+    if( stream == NULL )
+    {
+        ret = JSONNullParameter;
+    }
+    else
+    {
+        if( ( stream->status == JSONPartial ) &&
+            ( stream->token == ( uint8_t ) streamTokenScalar ) )
+        {
+            streamTokenEnd( stream );
+        }
+        else if( ( stream->status == JSONPartial ) &&
+                 ( stream->token != ( uint8_t ) streamTokenNone ) )
+        {
+            /* An unterminated string is illegal, as it is for a complete buffer. */
+            stream->status = JSONIllegalDocument;
+        }
+        else
+        {
+            /* MISRA 15.7 */
+        }
+
+        ret = stream->status;
+    }
+
+    return ret;
+}
+
+/** @cond DO_NOT_DOCUMENT */
+
+/* Powers of ten that are exactly representable as doubles. */
+static const double exactPowersOf10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+#define DOUBLE_MAX_EXACT_EXPONENT    22
+#define DOUBLE_MAX_EXACT_MANTISSA    ( ( ( uint64_t ) 1U ) << 53 )
+#define FLOAT_MAX_EXACT_EXPONENT     10
+#define FLOAT_MAX_EXACT_MANTISSA     ( ( ( uint64_t ) 1U ) << 24 )
+#define MAX_MANTISSA_DIGITS          19U
+#define MAX_EXPONENT_DIGITS_VALUE    100000
+
+/**
+ * @brief A decimal number split into its parts.
+ *
+ * The value is mantissa * 10^exponent.  Only the first MAX_MANTISSA_DIGITS
+ * significant digits are kept in the mantissa.
+ */
+typedef struct
+{
+    uint64_t mantissa;
+    int32_t exponent;
+    uint32_t digits;  /**< Significant digits in the mantissa. */
+    bool negative;
+    bool truncated;   /**< Non-zero digits beyond the mantissa were dropped. */
+} numberParts_t;
+
+/** @endcond */
+
+/**
+ * @brief Add a digit to a number's parts.
+ *
+ * @param[in,out] parts  The number's parts.
+ * @param[in] c  The digit character.
+ * @param[in] fraction  true if the digit follows the decimal point.
+ */
+static void numberDigit( numberParts_t * parts,
+                         char c,
+                         bool fraction )
+{
+    uint8_t d = ( uint8_t ) c - ( uint8_t ) '0';
+
+    if( parts->digits < MAX_MANTISSA_DIGITS )
+    {
+        /* Leading zeroes are not significant. */
+        if( ( parts->mantissa > 0U ) || ( d > 0U ) )
+        {
+            parts->digits++;
+        }
+
+        parts->mantissa = ( parts->mantissa * 10U ) + d;
+
+        if( fraction == true )
+        {
+            parts->exponent--;
+        }
+    }
+    else
+    {
+        if( d > 0U )
+        {
+            parts->truncated = true;
+        }
+
+        if( fraction == false )
+        {
+            parts->exponent++;
+        }
+    }
+}
+
+/**
+ * @brief Split a number that uses the JSON grammar into its parts.
+ *
+ * @param[in] buf  The number's characters.
+ * @param[in] length  Number of characters in the number.
+ * @param[out] parts  The number's parts.
+ *
+ * @return true if all of buf[0..length) is a number;
+ * false otherwise.
+ */
+static bool numberParse( const char * buf,
+                         size_t length,
+                         numberParts_t * parts )
+{
+    bool ret = false;
+    bool expNegative = false;
+    int32_t exp = 0;
+    size_t i = 0, first;
+
+    assert( ( buf != NULL ) && ( parts != NULL ) && ( length > 0U ) );
+
+    parts->mantissa = 0U;
+    parts->exponent = 0;
+    parts->digits = 0U;
+    parts->negative = false;
+    parts->truncated = false;
+
+    if( buf[ i ] == '-' )
+    {
+        parts->negative = true;
+        i++;
+    }
+
+    /* An initial zero must be alone. */
+    if( ( i < length ) && ( buf[ i ] == '0' ) )
+    {
+        ret = true;
+        i++;
+    }
+    else
+    {
+        first = i;
+
+        while( ( i < length ) && isdigit_( buf[ i ] ) )
+        {
+            numberDigit( parts, buf[ i ], false );
+            i++;
+        }
+
+        ret = ( i > first );
+    }
+
+    if( ( ret == true ) && ( i < length ) && ( buf[ i ] == '.' ) )
+    {
+        i++;
+        first = i;
+
+        while( ( i < length ) && isdigit_( buf[ i ] ) )
+        {
+            numberDigit( parts, buf[ i ], true );
+            i++;
+        }
+
+        ret = ( i > first );
+    }
+
+    if( ( ret == true ) && ( i < length ) && ( ( buf[ i ] == 'e' ) || ( buf[ i ] == 'E' ) ) )
+    {
+        i++;
+
+        if( ( i < length ) && ( ( buf[ i ] == '-' ) || ( buf[ i ] == '+' ) ) )
+        {
+            expNegative = ( buf[ i ] == '-' );
+            i++;
+        }
+
+        first = i;
+
+        while( ( i < length ) && isdigit_( buf[ i ] ) )
+        {
+            /* Larger exponents are out of range whatever the mantissa. */
+            if( exp < MAX_EXPONENT_DIGITS_VALUE )
+            {
+                exp = ( exp * 10 ) + ( int32_t ) ( ( uint8_t ) buf[ i ] - ( uint8_t ) '0' );
+            }
+
+            i++;
+        }
+
+        ret = ( i > first );
+        parts->exponent += ( expNegative == true ) ? -exp : exp;
+    }
+
+    return ( ret == true ) && ( i == length );
+}
+
+/**
+ * @brief Get the integer value of a number with a fraction or exponent.
+ *
+ * @param[in] buf  The number's characters.
+ * @param[in] length  Number of characters in the number.
+ * @param[out] magnitude  Receives the value's magnitude.
+ * @param[out] negative  Receives true if the value is negative.
+ *
+ * @return #JSONSuccess if the value is an integer, such as 1.0 or 25e2;
+ * #JSONIllegalDocument if it isn't a number or has a non-zero fraction;
+ * #JSONOutOfRange if it has more than MAX_MANTISSA_DIGITS significant
+ * digits or exceeds UINT64_MAX.
+ */
+static JSONStatus_t integralNumber( const char * buf,
+                                    size_t length,
+                                    uint64_t * magnitude,
+                                    bool * negative )
+{
+    JSONStatus_t ret = JSONSuccess;
+    numberParts_t parts;
+
+    if( numberParse( buf, length, &parts ) == false )
+    {
+        ret = JSONIllegalDocument;
+    }
+    else if( parts.truncated == true )
+    {
+        ret = JSONOutOfRange;
+    }
+    else
+    {
+        /* Each loop ends within MAX_MANTISSA_DIGITS + 1 iterations. */
+        while( ( ret == JSONSuccess ) && ( parts.mantissa > 0U ) && ( parts.exponent < 0 ) )
+        {
+            if( ( parts.mantissa % 10U ) != 0U )
+            {
+                ret = JSONIllegalDocument;
+            }
+
+            parts.mantissa /= 10U;
+            parts.exponent++;
+        }
+
+        while( ( ret == JSONSuccess ) && ( parts.mantissa > 0U ) && ( parts.exponent > 0 ) )
+        {
+            if( parts.mantissa > ( UINT64_MAX / 10U ) )
+            {
+                ret = JSONOutOfRange;
+            }
+
+            parts.mantissa *= 10U;
+            parts.exponent--;
+        }
+    }
+
+    *magnitude = parts.mantissa;
+    *negative = parts.negative;
+
+    return ret;
+}
+
+/**
+ * @brief Decode an integer, see JSON_NumberDecode().
+ *
+ * A decimal number with a fraction or exponent is accepted when its value
+ * is an integer, so 1.0 and 1e3 decode as 1 and 1000.
+ *
+ * @param[in] buf  The number's characters.
+ * @param[in] length  Number of characters in the number.
+ * @param[in] type  An integer type.
+ * @param[out] outValue  Receives the value.
+ *
+ * @return #JSONSuccess, #JSONIllegalDocument or #JSONOutOfRange.
+ */
+static JSONStatus_t decodeInteger( const char * buf,
+                                   size_t length,
+                                   JSONNumberType_t type,
+                                   void * outValue )
+{
+    JSONStatus_t ret = JSONSuccess;
+    uint64_t magnitude = 0U, limit;
+    uint8_t d;
+    bool negative = false;
+    bool hex = false;
+    size_t i = 0;
+    int64_t signedValue;
+    int32_t value32;
+    uint32_t uvalue32;
+
+    if( ( length > 2U ) && ( buf[ 0 ] == '0' ) && ( ( buf[ 1 ] == 'x' ) || ( buf[ 1 ] == 'X' ) ) )
+    {
+        hex = true;
+        i = 2;
+    }
+    else if( buf[ 0 ] == '-' )
+    {
+        negative = true;
+        i = 1;
+    }
+    else
+    {
+        /* MISRA 15.7 */
+    }
+
+    if( ( hex == false ) &&
+        ( ( memchr( buf, '.', length ) != NULL ) || ( memchr( buf, 'e', length ) != NULL ) ||
+          ( memchr( buf, 'E', length ) != NULL ) ) )
+    {
+        ret = integralNumber( buf, length, &magnitude, &negative );
+        i = length;
+    }
+    /* An initial zero must be alone. */
+    else if( ( i == length ) ||
+             ( ( hex == false ) && ( buf[ i ] == '0' ) && ( ( i + 1U ) < length ) ) )
+    {
+        ret = JSONIllegalDocument;
+    }
+    else
+    {
+        /* MISRA 15.7 */
+    }
+
+    for( ; ( ret == JSONSuccess ) && ( i < length ); i++ )
+    {
+        if( isdigit_( buf[ i ] ) )
+        {
+            d = ( uint8_t ) buf[ i ] - ( uint8_t ) '0';
+        }
+        else if( ( hex == true ) && ( buf[ i ] >= 'a' ) && ( buf[ i ] <= 'f' ) )
+        {
+            d = ( uint8_t ) buf[ i ] - ( uint8_t ) 'a' + 10U;
+        }
+        else if( ( hex == true ) && ( buf[ i ] >= 'A' ) && ( buf[ i ] <= 'F' ) )
+        {
+            d = ( uint8_t ) buf[ i ] - ( uint8_t ) 'A' + 10U;
+        }
+        else
+        {
+            ret = JSONIllegalDocument;
+        }
+
+        if( ret == JSONSuccess )
+        {
+            if( hex == true )
+            {
+                if( magnitude > ( UINT64_MAX >> 4 ) )
+                {
+                    ret = JSONOutOfRange;
+                }
+
+                magnitude = ( magnitude << 4 ) | d;
+            }
+            else
+            {
+                if( magnitude > ( ( UINT64_MAX - d ) / 10U ) )
+                {
+                    ret = JSONOutOfRange;
+                }
+
+                magnitude = ( magnitude * 10U ) + d;
+            }
+        }
+    }
+
+    if( magnitude == 0U )
+    {
+        /* -0 is 0 */
+        negative = false;
+    }
+
+    if( ret == JSONSuccess )
+    {
+        switch( type )
+        {
+            case JSONNumInt32:
+                limit = ( negative == true ) ? ( ( uint64_t ) INT32_MAX + 1U ) : ( uint64_t ) INT32_MAX;
+                break;
+
+            case JSONNumUint32:
+                limit = ( negative == true ) ? 0U : ( uint64_t ) UINT32_MAX;
+                break;
+
+            case JSONNumInt64:
+                limit = ( negative == true ) ? ( ( uint64_t ) INT64_MAX + 1U ) : ( uint64_t ) INT64_MAX;
+                break;
+
+            default:
+                limit = ( negative == true ) ? 0U : UINT64_MAX;
+                break;
+        }
+
+        if( magnitude > limit )
+        {
+            ret = JSONOutOfRange;
+        }
+    }
+
+    if( ret == JSONSuccess )
+    {
+        /* Avoids converting an unsigned value above INT64_MAX to signed. */
+        signedValue = ( negative == true ) ? ( -( int64_t ) ( magnitude - 1U ) - 1 ) : ( int64_t ) magnitude;
+
+        switch( type )
+        {
+            case JSONNumInt32:
+                value32 = ( int32_t ) signedValue;
+                ( void ) memcpy( outValue, &value32, sizeof( value32 ) );
+                break;
+
+            case JSONNumUint32:
+                uvalue32 = ( uint32_t ) magnitude;
+                ( void ) memcpy( outValue, &uvalue32, sizeof( uvalue32 ) );
+                break;
+
+            case JSONNumInt64:
+                ( void ) memcpy( outValue, &signedValue, sizeof( signedValue ) );
+                break;
+
+            default:
+                ( void ) memcpy( outValue, &magnitude, sizeof( magnitude ) );
+                break;
+        }
+    }
+
+    return ret;
+}
+
+/** @cond DO_NOT_DOCUMENT */
+
+#define DECIMAL_MAX_SHIFT    60U
+#define DECIMAL_MAX_POINT    310
+#define DECIMAL_MIN_POINT    ( -330 )
+
+/**
+ * @brief A decimal number for the conversions exact powers of ten can't do.
+ *
+ * The value is 0.d[0]d[1]...d[count-1] * 10^point, where d[0] isn't zero
+ * and d[count-1] isn't zero.  Non-zero digits that don't fit are
+ * remembered by truncated so they still break rounding ties.  The spare
+ * digit is written by decimalLeftShift() before it knows the result's
+ * length.
+ */
+typedef struct
+{
+    uint8_t digits[ JSON_NUMBER_MAX_DIGITS + 1U ];
+    int32_t count;
+    int32_t point;
+    bool negative;
+    bool truncated;
+} decimal_t;
+
+/**
+ * @brief An IEEE 754 binary format.
+ */
+typedef struct
+{
+    uint32_t mantissaBits; /**< Stored mantissa bits, without the implicit one. */
+    uint32_t exponentBits;
+    int32_t bias;          /**< Exponent of the smallest normal number less one. */
+} floatFormat_t;
+
+static const floatFormat_t floatFormat = { 23U, 8U, -127 };
+static const floatFormat_t doubleFormat = { 52U, 11U, -1023 };
+
+/** @endcond */
+
+/**
+ * @brief Drop a decimal's trailing zeroes.
+ *
+ * @param[in,out] decimal  The decimal.
+ */
+static void decimalTrim( decimal_t * decimal )
+{
+    while( ( decimal->count > 0 ) && ( decimal->digits[ decimal->count - 1 ] == 0U ) )
+    {
+        decimal->count--;
+    }
+
+    if( decimal->count == 0 )
+    {
+        decimal->point = 0;
+    }
+}
+
+/**
+ * @brief Load a number that numberParse() accepted into a decimal.
+ *
+ * @param[in] buf  The number's characters.
+ * @param[in] length  Number of characters in the number.
+ * @param[out] decimal  The number's digits.
+ */
+static void decimalLoad( const char * buf,
+                         size_t length,
+                         decimal_t * decimal )
+{
+    bool fraction = false;
+    bool expNegative = false;
+    int32_t exp = 0;
+    size_t i = 0;
+    uint8_t d;
+
+    decimal->count = 0;
+    decimal->point = 0;
+    decimal->negative = false;
+    decimal->truncated = false;
+
+    if( buf[ i ] == '-' )
+    {
+        decimal->negative = true;
+        i++;
+    }
+
+    for( ; ( i < length ) && ( buf[ i ] != 'e' ) && ( buf[ i ] != 'E' ); i++ )
+    {
+        if( buf[ i ] == '.' )
+        {
+            fraction = true;
+        }
+        else
+        {
+            d = ( uint8_t ) buf[ i ] - ( uint8_t ) '0';
+
+            /* The point is clamped like numberParse()'s exponent, the value is
+             * out of range long before either limit. */
+            if( ( decimal->count == 0 ) && ( d == 0U ) )
+            {
+                if( ( fraction == true ) && ( decimal->point > -MAX_EXPONENT_DIGITS_VALUE ) )
+                {
+                    decimal->point--;
+                }
+            }
+            else
+            {
+                if( decimal->count < ( int32_t ) JSON_NUMBER_MAX_DIGITS )
+                {
+                    decimal->digits[ decimal->count ] = d;
+                    decimal->count++;
+                }
+                else if( d > 0U )
+                {
+                    decimal->truncated = true;
+                }
+                else
+                {
+                    /* MISRA 15.7 */
+                }
+
+                if( ( fraction == false ) && ( decimal->point < MAX_EXPONENT_DIGITS_VALUE ) )
+                {
+                    decimal->point++;
+                }
+            }
+        }
+    }
+
+    if( i < length )
+    {
+        i++;
+
+        if( ( buf[ i ] == '-' ) || ( buf[ i ] == '+' ) )
+        {
+            expNegative = ( buf[ i ] == '-' );
+            i++;
+        }
+
+        for( ; i < length; i++ )
+        {
+            if( exp < MAX_EXPONENT_DIGITS_VALUE )
+            {
+                exp = ( exp * 10 ) + ( int32_t ) ( ( uint8_t ) buf[ i ] - ( uint8_t ) '0' );
+            }
+        }
+
+        decimal->point += ( expNegative == true ) ? -exp : exp;
+    }
+
+    decimalTrim( decimal );
+}
+
+/**
+ * @brief Store a digit computed by decimalLeftShift().
+ *
+ * @param[in,out] decimal  The decimal.
+ * @param[in] index  The digit's index, which may be past the spare digit.
+ * @param[in] d  The digit.
+ */
+static void decimalPut( decimal_t * decimal,
+                        int32_t index,
+                        uint8_t d )
+{
+    if( index <= ( int32_t ) JSON_NUMBER_MAX_DIGITS )
+    {
+        decimal->digits[ index ] = d;
+    }
+    else if( d > 0U )
+    {
+        decimal->truncated = true;
+    }
+    else
+    {
+        /* MISRA 15.7 */
+    }
+}
+
+/**
+ * @brief Multiply a decimal by 2^shift.
+ *
+ * @param[in,out] decimal  A non-zero decimal.
+ * @param[in] shift  1 to DECIMAL_MAX_SHIFT.
+ *
+ * The result has as many more digits as 2^shift has, or one less.  They
+ * are written from the last assuming as many, then moved down a place if
+ * there was one less.
+ */
+static void decimalLeftShift( decimal_t * decimal,
+                              uint32_t shift )
+{
+    /* 1233 / 4096 is log10( 2 ) to within 5e-6, exact enough for 2^60. */
+    int32_t delta = ( int32_t ) ( ( shift * 1233U ) >> 12 ) + 1;
+    int32_t end = decimal->count + delta;
+    int32_t r = decimal->count - 1;
+    int32_t w = end;
+    uint64_t n = 0U, quotient;
+
+    while( ( r >= 0 ) || ( n > 0U ) )
+    {
+        if( r >= 0 )
+        {
+            n += ( ( uint64_t ) decimal->digits[ r ] ) << shift;
+            r--;
+        }
+
+        quotient = n / 10U;
+        w--;
+        decimalPut( decimal, w, ( uint8_t ) ( n - ( quotient * 10U ) ) );
+        n = quotient;
+    }
+
+    if( end > ( ( int32_t ) JSON_NUMBER_MAX_DIGITS + 1 ) )
+    {
+        end = ( int32_t ) JSON_NUMBER_MAX_DIGITS + 1;
+    }
+
+    /* w is 0, or 1 when the result has one digit less. */
+    if( w > 0 )
+    {
+        ( void ) memmove( &decimal->digits[ 0 ], &decimal->digits[ w ], ( size_t ) ( end - w ) );
+        end -= w;
+    }
+
+    if( end > ( int32_t ) JSON_NUMBER_MAX_DIGITS )
+    {
+        if( decimal->digits[ JSON_NUMBER_MAX_DIGITS ] > 0U )
+        {
+            decimal->truncated = true;
+        }
+
+        end = ( int32_t ) JSON_NUMBER_MAX_DIGITS;
+    }
+
+    decimal->count = end;
+    decimal->point += delta - w;
+    decimalTrim( decimal );
+}
+
+/**
+ * @brief Divide a decimal by 2^shift.
+ *
+ * @param[in,out] decimal  A non-zero decimal.
+ * @param[in] shift  1 to DECIMAL_MAX_SHIFT.
+ *
+ * Long division from the first digit.  n stays below 10 * 2^shift so it
+ * fits in 64 bits.
+ */
+static void decimalRightShift( decimal_t * decimal,
+                               uint32_t shift )
+{
+    uint64_t mask = ( ( ( uint64_t ) 1U ) << shift ) - 1U;
+    uint64_t n = 0U;
+    int32_t r = 0, w = 0;
+    uint8_t d;
+
+    /* Read digits until the quotient is non-zero, the first digit isn't zero so this ends. */
+    while( ( n >> shift ) == 0U )
+    {
+        n *= 10U;
+
+        if( r < decimal->count )
+        {
+            n += decimal->digits[ r ];
+        }
+
+        r++;
+    }
+
+    decimal->point -= r - 1;
+
+    for( ; r < decimal->count; r++ )
+    {
+        decimal->digits[ w ] = ( uint8_t ) ( n >> shift );
+        w++;
+        n = ( ( n & mask ) * 10U ) + decimal->digits[ r ];
+    }
+
+    while( n > 0U )
+    {
+        d = ( uint8_t ) ( n >> shift );
+
+        if( w < ( int32_t ) JSON_NUMBER_MAX_DIGITS )
+        {
+            decimal->digits[ w ] = d;
+            w++;
+        }
+        else if( d > 0U )
+        {
+            decimal->truncated = true;
+        }
+        else
+        {
+            /* MISRA 15.7 */
+        }
+
+        n = ( n & mask ) * 10U;
+    }
+
+    decimal->count = w;
+    decimalTrim( decimal );
+}
+
+/**
+ * @brief Multiply a decimal by 2^shift.
+ *
+ * @param[in,out] decimal  The decimal.
+ * @param[in] shift  The power of two, negative to divide.
+ */
+static void decimalShift( decimal_t * decimal,
+                          int32_t shift )
+{
+    if( decimal->count > 0 )
+    {
+        for( ; shift > ( int32_t ) DECIMAL_MAX_SHIFT; shift -= ( int32_t ) DECIMAL_MAX_SHIFT )
+        {
+            decimalLeftShift( decimal, DECIMAL_MAX_SHIFT );
+        }
+
+        for( ; shift < -( int32_t ) DECIMAL_MAX_SHIFT; shift += ( int32_t ) DECIMAL_MAX_SHIFT )
+        {
+            decimalRightShift( decimal, DECIMAL_MAX_SHIFT );
+        }
+
+        if( shift > 0 )
+        {
+            decimalLeftShift( decimal, ( uint32_t ) shift );
+        }
+        else if( shift < 0 )
+        {
+            decimalRightShift( decimal, ( uint32_t ) -shift );
+        }
+        else
+        {
+            /* MISRA 15.7 */
+        }
+    }
+}
+
+/**
+ * @brief Round a decimal to an integer, ties to even.
+ *
+ * @param[in] decimal  A decimal below 2^( doubleFormat.mantissaBits + 2 ).
+ *
+ * @return The nearest integer.
+ */
+static uint64_t decimalRound( const decimal_t * decimal )
+{
+    uint64_t n = 0U;
+    int32_t i;
+    bool up = false;
+
+    for( i = 0; i < decimal->point; i++ )
+    {
+        n = ( n * 10U ) + ( ( i < decimal->count ) ? decimal->digits[ i ] : 0U );
+    }
+
+    if( ( decimal->point >= 0 ) && ( decimal->point < decimal->count ) )
+    {
+        /* An exact half, unless digits were dropped, goes to the even neighbour. */
+        if( ( decimal->digits[ decimal->point ] == 5U ) && ( ( decimal->point + 1 ) == decimal->count ) )
+        {
+            up = ( decimal->truncated == true ) || ( ( n & 1U ) == 1U );
+        }
+        else
+        {
+            up = ( decimal->digits[ decimal->point ] >= 5U );
+        }
+    }
+
+    return ( up == true ) ? ( n + 1U ) : n;
+}
+
+/**
+ * @brief Convert a decimal to the nearest IEEE 754 value.
+ *
+ * @param[in,out] decimal  The decimal, which is scaled in place.
+ * @param[in] format  The binary format.
+ * @param[out] bits  Receives the value's bits.
+ *
+ * @return true if the value is in the format's range;
+ * false if it overflows.
+ *
+ * The decimal is scaled by powers of two into [0.5, 1), and then by the
+ * mantissa's width so the rounded integer part is the mantissa.  Only
+ * shifts and one rounding are used, so the result is correctly rounded.
+ * This is the "simple decimal conversion" of Go's strconv package.
+ */
+static bool decimalToBits( decimal_t * decimal,
+                           const floatFormat_t * format,
+                           uint64_t * bits )
+{
+    /* Bits that scale 10^i below one, or at least 27 for larger i. */
+    static const uint8_t shifts[] = { 1U, 3U, 6U, 9U, 13U, 16U, 19U, 23U, 26U };
+    const int32_t shiftCnt = ( int32_t ) ( sizeof( shifts ) / sizeof( shifts[ 0 ] ) );
+    const int32_t maxExponent = ( int32_t ) ( ( 1U << format->exponentBits ) - 1U );
+    const uint64_t implicitOne = ( ( uint64_t ) 1U ) << format->mantissaBits;
+    int32_t exponent = 0, shift;
+    uint64_t mantissa = 0U;
+    bool ret = true;
+
+    if( ( decimal->count == 0 ) || ( decimal->point < DECIMAL_MIN_POINT ) )
+    {
+        exponent = format->bias;
+    }
+    else if( decimal->point > DECIMAL_MAX_POINT )
+    {
+        ret = false;
+    }
+    else
+    {
+        while( decimal->point > 0 )
+        {
+            shift = ( decimal->point >= shiftCnt ) ? 27 : ( int32_t ) shifts[ decimal->point ];
+            decimalShift( decimal, -shift );
+            exponent += shift;
+        }
+
+        while( ( decimal->point < 0 ) || ( ( decimal->point == 0 ) && ( decimal->digits[ 0 ] < 5U ) ) )
+        {
+            shift = ( -decimal->point >= shiftCnt ) ? 27 : ( int32_t ) shifts[ -decimal->point ];
+            decimalShift( decimal, shift );
+            exponent -= shift;
+        }
+
+        /* The value is now in [1, 2) * 2^exponent. */
+        exponent--;
+
+        /* Subnormal numbers have the smallest exponent and fewer bits. */
+        if( exponent < ( format->bias + 1 ) )
+        {
+            shift = format->bias + 1 - exponent;
+            decimalShift( decimal, -shift );
+            exponent += shift;
+        }
+
+        if( ( exponent - format->bias ) >= maxExponent )
+        {
+            ret = false;
+        }
+        else
+        {
+            decimalShift( decimal, ( int32_t ) format->mantissaBits + 1 );
+            mantissa = decimalRound( decimal );
+
+            /* Rounding up to the next power of two. */
+            if( mantissa == ( implicitOne << 1 ) )
+            {
+                mantissa >>= 1;
+                exponent++;
+                ret = ( ( exponent - format->bias ) < maxExponent );
+            }
+
+            if( ( mantissa & implicitOne ) == 0U )
+            {
+                exponent = format->bias;
+            }
+        }
+    }
+
+    *bits = ( mantissa & ( implicitOne - 1U ) ) |
+            ( ( ( uint64_t ) ( ( uint32_t ) ( exponent - format->bias ) & ( uint32_t ) maxExponent ) ) << format->mantissaBits ) |
+            ( ( decimal->negative == true ) ? ( ( ( uint64_t ) 1U ) << ( format->mantissaBits + format->exponentBits ) ) : 0U );
+
+    return ret;
+}
+
+/**
+ * @brief Decode a floating point number, see JSON_NumberDecode().
+ *
+ * When the mantissa and the power of ten are both exact in the target's
+ * precision one IEEE multiply or divide yields the correctly rounded
+ * result.  A float is computed in double because double has more than
+ * twice float's precision, so rounding the double result to float is
+ * still correct.  Other numbers are converted by decimalToBits(), which
+ * doesn't depend on the C library or its locale.
+ *
+ * @param[in] buf  The number's characters.
+ * @param[in] length  Number of characters in the number.
+ * @param[in] type  #JSONNumFloat or #JSONNumDouble.
+ * @param[out] outValue  Receives the value.
+ *
+ * @return #JSONSuccess, #JSONIllegalDocument or #JSONOutOfRange.
+ */
+static JSONStatus_t decodeReal( const char * buf,
+                                size_t length,
+                                JSONNumberType_t type,
+                                void * outValue )
+{
+    JSONStatus_t ret = JSONSuccess;
+    numberParts_t parts;
+    uint64_t maxMantissa;
+    int32_t maxExponent;
+    double value = 0.0;
+    float fvalue = 0.0F;
+    decimal_t decimal;
+    uint64_t bits;
+    uint32_t bits32;
+    bool inRange;
+
+    if( type == JSONNumFloat )
+    {
+        maxMantissa = FLOAT_MAX_EXACT_MANTISSA;
+        maxExponent = FLOAT_MAX_EXACT_EXPONENT;
+    }
+    else
+    {
+        maxMantissa = DOUBLE_MAX_EXACT_MANTISSA;
+        maxExponent = DOUBLE_MAX_EXACT_EXPONENT;
+    }
+
+    if( numberParse( buf, length, &parts ) == false )
+    {
+        ret = JSONIllegalDocument;
+    }
+    else if( parts.mantissa == 0U )
+    {
+        value = ( parts.negative == true ) ? -0.0 : 0.0;
+    }
+    else if( ( parts.truncated == false ) && ( parts.mantissa <= maxMantissa ) &&
+             ( parts.exponent >= -maxExponent ) && ( parts.exponent <= maxExponent ) )
+    {
+        value = ( double ) parts.mantissa;
+
+        if( parts.exponent < 0 )
+        {
+            value /= exactPowersOf10[ -parts.exponent ];
+        }
+        else
+        {
+            value *= exactPowersOf10[ parts.exponent ];
+        }
+
+        if( parts.negative == true )
+        {
+            value = -value;
+        }
+    }
+    else
+    {
+        decimalLoad( buf, length, &decimal );
+
+        if( type == JSONNumFloat )
+        {
+            inRange = decimalToBits( &decimal, &floatFormat, &bits );
+            bits32 = ( uint32_t ) bits;
+            ( void ) memcpy( &fvalue, &bits32, sizeof( fvalue ) );
+            value = ( double ) fvalue;
+        }
+        else
+        {
+            inRange = decimalToBits( &decimal, &doubleFormat, &bits );
+            ( void ) memcpy( &value, &bits, sizeof( value ) );
+        }
+
+        if( inRange == false )
+        {
+            ret = JSONOutOfRange;
+        }
+    }
+
+    if( ret == JSONSuccess )
+    {
+        if( type == JSONNumFloat )
+        {
+            if( ( value > FLT_MAX ) || ( value < -FLT_MAX ) )
+            {
+                ret = JSONOutOfRange;
+            }
+            else
+            {
+                fvalue = ( float ) value;
+                ( void ) memcpy( outValue, &fvalue, sizeof( fvalue ) );
+            }
+        }
+        else
+        {
+            ( void ) memcpy( outValue, &value, sizeof( value ) );
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * See core_json.h for docs.
+ */
+JSONStatus_t JSON_NumberDecode( const char * buf,
+                                size_t length,
+                                JSONNumberType_t type,
+                                void * outValue )
+{
+    JSONStatus_t ret;
+
+    if( ( buf == NULL ) || ( outValue == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else if( ( length == 0U ) || ( ( uint32_t ) type > ( uint32_t ) JSONNumDouble ) )
+    {
+        ret = JSONBadParameter;
+    }
+    else if( ( type == JSONNumFloat ) || ( type == JSONNumDouble ) )
+    {
+        ret = decodeReal( buf, length, type, outValue );
+    }
+    else
+    {
+        ret = decodeInteger( buf, length, type, outValue );
+    }
+
+    return ret;
+}
+
+/** @cond DO_NOT_DOCUMENT */
+
+/**
+ * @brief Read the four hex digits of a \u escape.
+ *
+ * @param[in] buf  The buffer holding the escape.
+ * @param[in] i  Index of the escape's backslash.
+ * @param[in] length  The size of the buffer.
+ * @param[out] outValue  The value of the hex digits.
+ *
+ * @return true if buf[i..i+6) is a \u escape;
+ * false otherwise.
+ */
+static bool readHexEscape( const char * buf,
+                           size_t i,
+                           size_t length,
+                           uint16_t * outValue )
+{
+    bool ret = false;
+    size_t j;
+    uint16_t value = 0;
+    uint8_t n = 0;
+
+    if( ( ( i + HEX_ESCAPE_LENGTH ) <= length ) && ( buf[ i ] == '\\' ) && ( buf[ i + 1U ] == 'u' ) )
+    {
+        for( j = i + 2U; ( j < ( i + HEX_ESCAPE_LENGTH ) ) && ( n != NOT_A_HEX_CHAR ); j++ )
+        {
+            n = hexToInt( buf[ j ] );
+            value = ( uint16_t ) ( ( value << 4U ) | n );
+        }
+
+        ret = ( n != NOT_A_HEX_CHAR );
+    }
+
+    *outValue = value;
+
+    return ret;
+}
+
+/**
+ * @brief Decode the escape sequence at buf[i] into UTF-8 bytes.
+ *
+ * @param[in] buf  The buffer holding the escape.
+ * @param[in,out] start  Index of the escape's backslash, advanced beyond it.
+ * @param[in] length  The size of the buffer.
+ * @param[out] utf8  Receives up to 4 bytes.
+ *
+ * @return the number of bytes output, or 0 if the escape is invalid.
+ *
+ * @note As with skipEscape(), \u0000 and lone surrogates are disallowed and
+ * a backslash followed by a control character is the control character.
+ */
+static size_t decodeEscape( const char * buf,
+                            size_t * start,
+                            size_t length,
+                            uint8_t * utf8 )
+{
+    size_t i = *start, n = 0;
+    uint16_t high, low;
+    uint32_t codePoint = 0;
+    char c = ( ( i + 1U ) < length ) ? buf[ i + 1U ] : '\0';
+
+    switch( c )
+    {
+        case '"':
+        case '\\':
+        case '/':
+            utf8[ 0 ] = ( uint8_t ) c;
+            n = 1;
+            break;
+
+        case 'b':
+            utf8[ 0 ] = ( uint8_t ) '\b';
+            n = 1;
+            break;
+
+        case 'f':
+            utf8[ 0 ] = ( uint8_t ) '\f';
+            n = 1;
+            break;
+
+        case 'n':
+            utf8[ 0 ] = ( uint8_t ) '\n';
+            n = 1;
+            break;
+
+        case 'r':
+            utf8[ 0 ] = ( uint8_t ) '\r';
+            n = 1;
+            break;
+
+        case 't':
+            utf8[ 0 ] = ( uint8_t ) '\t';
+            n = 1;
+            break;
+
+        case 'u':
+
+            if( readHexEscape( buf, i, length, &high ) == true )
+            {
+                if( isHighSurrogate( high ) )
+                {
+                    if( ( readHexEscape( buf, i + HEX_ESCAPE_LENGTH, length, &low ) == true ) &&
+                        isLowSurrogate( low ) )
+                    {
+                        codePoint = 0x10000U + ( ( ( uint32_t ) high - 0xD800U ) << 10U ) +
+                                    ( ( uint32_t ) low - 0xDC00U );
+                        i += HEX_ESCAPE_LENGTH;
+                    }
+                }
+                else if( !isLowSurrogate( high ) )
+                {
+                    codePoint = high;
+                }
+                else
+                {
+                    /* premature low surrogate */
+                }
+            }
+
+            if( codePoint < 0x80U )
+            {
+                utf8[ 0 ] = ( uint8_t ) codePoint;
+                n = ( codePoint > 0U ) ? 1U : 0U;
+            }
+            else if( codePoint < 0x800U )
+            {
+                utf8[ 0 ] = ( uint8_t ) ( 0xC0U | ( codePoint >> 6U ) );
+                utf8[ 1 ] = ( uint8_t ) ( 0x80U | ( codePoint & 0x3FU ) );
+                n = 2;
+            }
+            else if( codePoint < 0x10000U )
+            {
+                utf8[ 0 ] = ( uint8_t ) ( 0xE0U | ( codePoint >> 12U ) );
+                utf8[ 1 ] = ( uint8_t ) ( 0x80U | ( ( codePoint >> 6U ) & 0x3FU ) );
+                utf8[ 2 ] = ( uint8_t ) ( 0x80U | ( codePoint & 0x3FU ) );
+                n = 3;
+            }
+            else
+            {
+                utf8[ 0 ] = ( uint8_t ) ( 0xF0U | ( codePoint >> 18U ) );
+                utf8[ 1 ] = ( uint8_t ) ( 0x80U | ( ( codePoint >> 12U ) & 0x3FU ) );
+                utf8[ 2 ] = ( uint8_t ) ( 0x80U | ( ( codePoint >> 6U ) & 0x3FU ) );
+                utf8[ 3 ] = ( uint8_t ) ( 0x80U | ( codePoint & 0x3FU ) );
+                n = 4;
+            }
+
+            /* The escape's remaining characters are skipped below */
+            i += HEX_ESCAPE_LENGTH - 2U;
+            break;
+
+        default:
+
+            if( ( c != '\0' ) && iscntrl_( c ) )
+            {
+                utf8[ 0 ] = ( uint8_t ) c;
+                n = 1;
+            }
+
+            break;
+    }
+
+    *start = i + 2U;
+
+    return n;
+}
+
+/** @endcond */
+
+/**
+ * See core_json.h for docs.
+ *
+ * The output never gets ahead of the input, so out may be buf.
+ */
+JSONStatus_t JSON_StringUnescape( const char * buf,
+                                  size_t length,
+                                  char * out,
+                                  size_t outLength,
+                                  size_t * outUsed )
+{
+    JSONStatus_t ret = JSONSuccess;
+    size_t i = 0, o = 0, n, k;
+    uint8_t utf8[ 4 ];
+
+    if( ( buf == NULL ) || ( out == NULL ) )
+    {
+        ret = JSONNullParameter;
+    }
+    else if( outLength == 0U )
+    {
+        ret = JSONBadParameter;
+    }
+    else
+    {
+        while( ( ret == JSONSuccess ) && ( i < length ) )
+        {
+            if( buf[ i ] != '\\' )
+            {
+                if( ( o + 1U ) < outLength )
+                {
+                    out[ o ] = buf[ i ];
+                    o++;
+                    i++;
+                }
+                else
+                {
+                    ret = JSONTokenTooLong;
+                }
+            }
+            else
+            {
+                n = decodeEscape( buf, &i, length, utf8 );
+
+                if( n == 0U )
+                {
+                    ret = JSONIllegalDocument;
+                }
+                else if( ( o + n ) < outLength )
+                {
+                    for( k = 0; k < n; k++ )
+                    {
+                        out[ o + k ] = ( char ) utf8[ k ];
+                    }
+
+                    o += n;
+                }
+                else
+                {
+                    ret = JSONTokenTooLong;
+                }
+            }
+        }
+
+        out[ o ] = '\0';
+    }
+
+    if( outUsed != NULL )
+    {
+        *outUsed = o;
+    }
+
+    return ret;
+}
@@ -22,9 +22,18 @@
 **       an IniLib enumtype that defines the first enumeration as 'start'
 **       with a value of 0. The 'CFG_' parameter enum definitions follow
 **       'start' so their values begin at 1. The 'CFG_' parameters are used
-**       as an index into the config data storage array IniTbl->CfgData[]
+**       as an index into the config data storage array CfgData[]
 **       and ('CFG_' - 1) is used to index into IniTbl->JsonParams[] because
 **       CJSON assumes [0] is a valid entry.
+**    2. A lazy table's parameters are decoded by ValidJsonObjCfg() the 
+**       first time they are retrieved, by any task while it holds the 
+**       table's LazyMutex. See DecodeParam().
+**    3. CfgData[] and its ParamValid[] flags live in two banks. Each getter
+**       reads the published bank IniTbl->Cfg once and INITBL_Reload() loads
+**       the other bank before publishing it with a single pointer store. 
+**       JsonParams[] is only used by the task loading a file, its Updated
+**       flags are never read by a getter. Readers hold a bank with its 
+**       CfgBank[] index, see PublishedBank().
 **
 **  References:
 **    1. OpenSatKit Object-based Application Developer's Guide
@@ -36,6 +45,7 @@
 ** Include Files:
 */
 
+#include <stdio.h>
 #include <string.h>
 #include "initbl.h"
 
@@ -45,8 +55,43 @@
 /************************************/
 
 static bool BuildJsonTblObjArray (INITBL_Class_t* IniTbl);
+static void BuildParamHash(INITBL_Class_t* IniTbl);
+static bool BuildSnapshot(const INITBL_Class_t* IniTbl, INITBL_CfgBank_t* Bank);
+static bool CompactJsonValues(INITBL_Class_t* IniTbl, const char* JsonBuf);
+static bool Construct(INITBL_Class_t* IniTbl, const char* IniTblFile, INILIB_CfgEnum_t* CfgEnum,
+                      INITBL_Decode_t Decode, INITBL_LazyStore_t* LazyStore);
+static bool CreateLazyMutex(INITBL_Class_t* IniTbl);
+static bool DecodeParam(const INITBL_Class_t* IniTbl, INITBL_CfgBank_t* Bank, uint16 JsonObjIndex);
+static bool GetTaskIndex(uint32* TaskIndex);
+static uint32 HashParamName(const char* Name, uint32 Seed);
 static bool LoadJsonData(size_t JsonFileLen, void* UserDataPtr);
-static bool ValidJsonObjCfg(const INITBL_Class_t* IniTbl, uint16 JsonObjIndex, JSONTypes_t Type);
+static bool LoadJsonLayer(size_t JsonFileLen, void* UserDataPtr);
+static bool LoadParamLoc(const INITBL_Class_t* IniTbl, INITBL_CfgBank_t* Bank, uint16 JsonObjIndex);
+static bool LocateJsonData(size_t JsonFileLen, void* UserDataPtr);
+static uint8 PublishedBank(const INITBL_Class_t* IniTbl);
+static void ReleaseJsonBuf(INITBL_Class_t* IniTbl);
+static void StoreArrayCnt(const CJSON_Obj_t* JsonParam, INITBL_CfgData_t* CfgData);
+static void TargetCfgBank(INITBL_Class_t* IniTbl, INITBL_CfgBank_t* Bank);
+static bool ValidJsonObjCfg(const INITBL_Class_t* IniTbl, INITBL_CfgBank_t* Cfg, uint16 JsonObjIndex,
+                            INITBL_ParamType_t ParamType);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+/* Indexed by INITBL_ParamType_t */
+static const char* ParamTypeStr[INITBL_PARAM_TYPE_CNT] =
+{
+   INILIB_TYPE_INT,
+   INILIB_TYPE_FLT,
+   INILIB_TYPE_STR,
+   INILIB_TYPE_BOOL,
+   INILIB_TYPE_INT64,
+   INILIB_TYPE_DBL,
+   INILIB_TYPE_INT_ARRAY,
+   INILIB_TYPE_FLT_ARRAY
+};
 
 
 /******************************************************************************
@@ -60,15 +105,115 @@ bool INITBL_Constructor(INITBL_Class_t *IniTbl, const char *IniTblFile,
                        INILIB_CfgEnum_t *CfgEnum)
 {
    
-   bool RetStatus = false;
+   return Construct(IniTbl, IniTblFile, CfgEnum, INITBL_DECODE_EAGER, NULL);
+   
+} /* End INITBL_Constructor() */
+
+
+/******************************************************************************
+** Function: INITBL_LazyConstructor
+**
+*/
+bool INITBL_LazyConstructor(INITBL_Class_t *IniTbl, const char *IniTblFile,
+                            INILIB_CfgEnum_t *CfgEnum, INITBL_LazyStore_t *LazyStore,
+                            bool Compact)
+{
+   
+   return Construct(IniTbl, IniTblFile, CfgEnum, Compact ? INITBL_DECODE_COMPACT : INITBL_DECODE_LAZY,
+                    LazyStore);
+   
+} /* End INITBL_LazyConstructor() */
+
+
+/******************************************************************************
+** Function: INITBL_LayeredConstructor
+**
+** Notes:
+**    1. Layers are loaded from the highest priority file to the lowest and
+**       each layer only decodes the parameters that higher layers didn't
+**       define. Each file is traversed once to locate every parameter, see
+**       LoadJsonLayer().
+**    2. The locations are only needed while a layer loads so they are kept
+**       on the stack rather than in the table.
+**
+*/
+bool INITBL_LayeredConstructor(INITBL_Class_t *IniTbl, const char *IniTblFile[], uint16 FileCnt,
+                               INILIB_CfgEnum_t *CfgEnum)
+{
+   
+   bool   RetStatus = false;
+   size_t ObjLoadCnt = 0;
+   size_t i;
+   int    Layer;
+   CJSON_ObjLoc_t JsonLoc[INITBL_MAX_CFG_ITEMS+1];
    
    CFE_PSP_MemSet(IniTbl, 0, sizeof(INITBL_Class_t));
-   IniTbl->CfgEnum = *CfgEnum;
+   IniTbl->CfgEnum  = *CfgEnum;
+   IniTbl->Decode   = INITBL_DECODE_EAGER;
+   IniTbl->Cfg      = &IniTbl->CfgBank[0];
+   IniTbl->LoadBank = &IniTbl->CfgBank[0];
  
- 
-   if (BuildJsonTblObjArray (IniTbl))
+   if (FileCnt == 0 || FileCnt > INITBL_MAX_LAYERS)
+   {
+      CFE_EVS_SendEvent(INITBL_CONFIG_DEF_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "JSON INITBL definition error. Layer file count %d is not in range 1 to %d",
+                        FileCnt, INITBL_MAX_LAYERS);
+   }
+   else if (BuildJsonTblObjArray (IniTbl))
    {
-      RetStatus = CJSON_ProcessFileAlt(IniTblFile, IniTbl->JsonBuf, INITBL_MAX_JSON_FILE_CHAR, LoadJsonData, IniTbl);
+      
+      BuildParamHash(IniTbl);
+      
+      IniTbl->JsonLoc = JsonLoc;
+      
+      RetStatus = true;
+      for (Layer=(FileCnt-1); RetStatus && Layer >= 0; Layer--)
+      {
+         IniTbl->LoadLayer = Layer + 1;
+         RetStatus = CJSON_ProcessFileLocate(IniTblFile[Layer], NULL, INITBL_MAX_JSON_FILE_CHAR,
+                                             IniTbl->JsonParams, JsonLoc, IniTbl->JsonParamCnt,
+                                             LoadJsonLayer, IniTbl);
+      }
+      
+      IniTbl->JsonLoc = NULL;
+      
+      if (RetStatus)
+      {
+      
+         for (i=0; i < IniTbl->JsonParamCnt; i++)
+         {
+            if (IniTbl->JsonLayer[i] != 0)
+            {
+               ObjLoadCnt++;
+            }
+            else
+            {
+               CFE_EVS_SendEvent(INITBL_LOAD_JSON_ERR_EID, CFE_EVS_EventType_ERROR, 
+                                 "JSON initialization files do not define %s",
+                                 IniTbl->JsonParams[i].Query.Key);
+            }
+         }
+         
+         RetStatus = (ObjLoadCnt == IniTbl->JsonParamCnt);
+         
+         if (RetStatus)
+         {
+            if (IniTbl->CfgEnum.GetOffset != NULL)
+            {
+               BuildSnapshot(IniTbl, IniTbl->LoadBank);
+            }
+            CFE_EVS_SendEvent(INITBL_LOAD_JSON_EID, CFE_EVS_EventType_INFORMATION, 
+                              "JSON initialization files successfully processed with %d parameters from %d layers",
+                              (unsigned int)IniTbl->JsonParamCnt, FileCnt);
+         }
+         else
+         {
+            CFE_EVS_SendEvent(INITBL_LOAD_JSON_ERR_EID, CFE_EVS_EventType_ERROR, 
+                              "Error processing JSON initialization files. %d of %d parameters processed",
+                              (unsigned int)ObjLoadCnt, (unsigned int)IniTbl->JsonParamCnt);  
+         }
+      
+      } /* End if all layers processed */
    }
    else 
    {
@@ -79,7 +224,118 @@ bool INITBL_Constructor(INITBL_Class_t *IniTbl, const char *IniTblFile,
    
    return RetStatus;
    
-} /* End INITBL_Constructor() */
+} /* End INITBL_LayeredConstructor() */
+
+
+/******************************************************************************
+** Function: INITBL_AcquireCfg
+**
+** Notes:
+**    1. The published bank is read again after the reader's hold is 
+**       stored. If a reload published the other bank in between, the hold
+**       may be on the bank the next reload overwrites so the hold is moved
+**       to the new published bank. See TBLMGR_AcquireTbl().
+**    2. No events are sent because readers call this every processing 
+**       cycle.
+**
+*/
+bool INITBL_AcquireCfg(INITBL_Class_t *IniTbl, uint8 ReaderId)
+{
+   
+   bool  RetStatus = false;
+   uint8 Bank;
+   
+   if (ReaderId < IniTbl->ReaderCnt)
+   {
+      
+      if (IniTbl->ReaderBank[ReaderId] == INITBL_CFG_NO_BANK)
+      {
+         do
+         {
+            Bank = PublishedBank(IniTbl);
+            IniTbl->ReaderBank[ReaderId] = Bank;
+         } while (Bank != PublishedBank(IniTbl));
+      }
+      
+      RetStatus = true;
+   }
+
+   return RetStatus;
+   
+} /* INITBL_AcquireCfg() */
+
+
+/******************************************************************************
+** Function: INITBL_GetBoolConfig
+**
+** Notes:
+**    1. See INITBL_GetIntConfig().
+**
+*/
+bool INITBL_GetBoolConfig(const INITBL_Class_t *IniTbl, uint16 Param)
+{
+   
+   bool RetValue = false;
+   uint16 JsonObjIndex = (Param-1);
+   INITBL_CfgBank_t *Cfg = IniTbl->Cfg;
+   
+   if (ValidJsonObjCfg(IniTbl, Cfg, JsonObjIndex, INITBL_PARAM_BOOL))
+   {
+      RetValue = Cfg->CfgData[Param].Bool;
+   }
+
+   return RetValue;
+   
+} /* INITBL_GetBoolConfig() */
+
+
+/******************************************************************************
+** Function: INITBL_GetDblConfig
+**
+** Notes:
+**    1. See INITBL_GetFltConfig().
+**
+*/
+double INITBL_GetDblConfig(const INITBL_Class_t *IniTbl, uint16 Param)
+{
+   
+   double RetValue = 0.0;
+   uint16 JsonObjIndex = (Param-1);
+   INITBL_CfgBank_t *Cfg = IniTbl->Cfg;
+   
+   if (ValidJsonObjCfg(IniTbl, Cfg, JsonObjIndex, INITBL_PARAM_DBL))
+   {
+      RetValue = Cfg->CfgData[Param].Dbl;
+   }
+
+   return RetValue;
+   
+} /* INITBL_GetDblConfig() */
+
+
+/******************************************************************************
+** Function: INITBL_GetFltArrayConfig
+**
+** Notes:
+**    1. If the parameter is out of range or of the wrong type, NULL is
+**       returned and an event message is sent.
+**
+*/
+const INITBL_FltArray_t* INITBL_GetFltArrayConfig(const INITBL_Class_t *IniTbl, uint16 Param)
+{
+   
+   const INITBL_FltArray_t* RetArrayPtr = NULL;
+   uint16 JsonObjIndex = (Param-1);
+   INITBL_CfgBank_t *Cfg = IniTbl->Cfg;
+   
+   if (ValidJsonObjCfg(IniTbl, Cfg, JsonObjIndex, INITBL_PARAM_FLT_ARRAY))
+   {
+      RetArrayPtr = &Cfg->CfgData[Param].FltArray;
+   }
+
+   return RetArrayPtr;
+   
+} /* INITBL_GetFltArrayConfig() */
 
 
 /******************************************************************************
@@ -99,10 +355,11 @@ float INITBL_GetFltConfig(const INITBL_Class_t *IniTbl, uint16 Param)
    
    float RetValue = 0.0;
    uint16 JsonObjIndex = (Param-1);
+   INITBL_CfgBank_t *Cfg = IniTbl->Cfg;
 
-   if (ValidJsonObjCfg(IniTbl, JsonObjIndex, JSONNumber))
+   if (ValidJsonObjCfg(IniTbl, Cfg, JsonObjIndex, INITBL_PARAM_FLT))
    {
-      RetValue = IniTbl->CfgData[Param].Flt;
+      RetValue = Cfg->CfgData[Param].Flt;
    }
 
    return RetValue;
@@ -110,6 +367,55 @@ float INITBL_GetFltConfig(const INITBL_Class_t *IniTbl, uint16 Param)
 } /* INITBL_GetFltConfig() */
 
 
+/******************************************************************************
+** Function: INITBL_GetInt64Config
+**
+** Notes:
+**    1. See INITBL_GetIntConfig().
+**
+*/
+int64 INITBL_GetInt64Config(const INITBL_Class_t *IniTbl, uint16 Param)
+{
+   
+   int64 RetValue = 0;
+   uint16 JsonObjIndex = (Param-1);
+   INITBL_CfgBank_t *Cfg = IniTbl->Cfg;
+   
+   if (ValidJsonObjCfg(IniTbl, Cfg, JsonObjIndex, INITBL_PARAM_INT64))
+   {
+      RetValue = Cfg->CfgData[Param].Int64;
+   }
+
+   return RetValue;
+   
+} /* INITBL_GetInt64Config() */
+
+
+/******************************************************************************
+** Function: INITBL_GetIntArrayConfig
+**
+** Notes:
+**    1. If the parameter is out of range or of the wrong type, NULL is
+**       returned and an event message is sent.
+**
+*/
+const INITBL_IntArray_t* INITBL_GetIntArrayConfig(const INITBL_Class_t *IniTbl, uint16 Param)
+{
+   
+   const INITBL_IntArray_t* RetArrayPtr = NULL;
+   uint16 JsonObjIndex = (Param-1);
+   INITBL_CfgBank_t *Cfg = IniTbl->Cfg;
+   
+   if (ValidJsonObjCfg(IniTbl, Cfg, JsonObjIndex, INITBL_PARAM_INT_ARRAY))
+   {
+      RetArrayPtr = &Cfg->CfgData[Param].IntArray;
+   }
+
+   return RetArrayPtr;
+   
+} /* INITBL_GetIntArrayConfig() */
+
+
 /******************************************************************************
 ** Function: INITBL_GetIntConfig
 **
@@ -127,10 +433,11 @@ uint32 INITBL_GetIntConfig(const INITBL_Class_t *IniTbl, uint16 Param)
    
    uint32 RetValue = 0;
    uint16 JsonObjIndex = (Param-1);
+   INITBL_CfgBank_t *Cfg = IniTbl->Cfg;
    
-   if (ValidJsonObjCfg(IniTbl, JsonObjIndex, JSONNumber))
+   if (ValidJsonObjCfg(IniTbl, Cfg, JsonObjIndex, INITBL_PARAM_INT))
    {
-      RetValue = IniTbl->CfgData[Param].Int;
+      RetValue = Cfg->CfgData[Param].Int;
    }
 
    return RetValue;
@@ -138,6 +445,76 @@ uint32 INITBL_GetIntConfig(const INITBL_Class_t *IniTbl, uint16 Param)
 } /* INITBL_GetIntConfig() */
 
 
+/******************************************************************************
+** Function: INITBL_GetParam
+**
+** Notes:
+**    1. See BuildParamHash() for the hash's structure.
+**
+*/
+uint16 INITBL_GetParam(const INITBL_Class_t *IniTbl, const char *Name)
+{
+   
+   uint16 Param = 0;
+   uint16 Candidate;
+   uint32 Bucket;
+   
+   if (IniTbl->JsonParamCnt > 0)
+   {
+      
+      Bucket    = HashParamName(Name, 0) % IniTbl->JsonParamCnt;
+      Candidate = IniTbl->ParamHash[HashParamName(Name, IniTbl->ParamHashDisp[Bucket]) % (2*IniTbl->JsonParamCnt)];
+      
+      if (Candidate != 0 && strcmp((IniTbl->CfgEnum.GetStr)(Candidate), Name) == 0)
+      {
+         Param = Candidate;
+      }
+   }
+   
+   return Param;
+   
+} /* INITBL_GetParam() */
+
+
+/******************************************************************************
+** Function: INITBL_GetSnapshot
+**
+** Notes:
+**    1. A lazy table's snapshot is populated on the first call while the
+**       table's LazyMutex is held, see DecodeParam(). 
+**
+*/
+const void* INITBL_GetSnapshot(const INITBL_Class_t *IniTbl)
+{
+   
+   const void       *RetSnapshot = NULL;
+   INITBL_CfgBank_t *Cfg         = IniTbl->Cfg;
+   
+   if (!Cfg->SnapshotValid && IniTbl->Decode != INITBL_DECODE_EAGER)
+   {
+      OS_MutSemTake(IniTbl->LazyMutex);
+      if (!Cfg->SnapshotValid)
+      {
+         BuildSnapshot(IniTbl, Cfg);
+      }
+      OS_MutSemGive(IniTbl->LazyMutex);
+   }
+   
+   if (Cfg->SnapshotValid)
+   {
+      RetSnapshot = Cfg->Snapshot;
+   }
+   else
+   {
+      CFE_EVS_SendEvent(INITBL_CFG_PARAM_ERR_EID, CFE_EVS_EventType_ERROR, 
+                        "INITBL configuration snapshot is not available");
+   }
+   
+   return RetSnapshot;
+   
+} /* INITBL_GetSnapshot() */
+
+
 /******************************************************************************
 ** Function: INITBL_GetStrConfig
 **
@@ -155,10 +532,11 @@ const char* INITBL_GetStrConfig(const INITBL_Class_t *IniTbl, uint16 Param)
    
    const char* RetStrPtr = NULL;
    uint16      JsonObjIndex = (Param-1);
+   INITBL_CfgBank_t *Cfg = IniTbl->Cfg;
    
-   if (ValidJsonObjCfg(IniTbl, JsonObjIndex, JSONString))
+   if (ValidJsonObjCfg(IniTbl, Cfg, JsonObjIndex, INITBL_PARAM_STR))
    {
-      RetStrPtr = IniTbl->CfgData[Param].Str;
+      RetStrPtr = Cfg->CfgData[Param].Str;
    }
 
    return RetStrPtr;
@@ -167,126 +545,789 @@ const char* INITBL_GetStrConfig(const INITBL_Class_t *IniTbl, uint16 Param)
 
 
 /******************************************************************************
-** Function: BuildJsonTblObjArray
+** Function: INITBL_RegisterReader
 **
 ** Notes:
-**   1. This uses the INILIB parameter definitions to create an array of 
-**      CJSON_Obj_t that can be used to process the JSON ini file.
+**    1. Not reentrant with itself so readers are registered during app
+**       initialization.
 **
 */
-static bool BuildJsonTblObjArray (INITBL_Class_t *IniTbl)
+uint8 INITBL_RegisterReader(INITBL_Class_t *IniTbl)
 {
-
-   bool RetStatus = true;
-   int  Param, i;
-   const char *CfgStrPtr;
-   const char *CfgTypePtr;
    
+   uint8 ReaderId = INITBL_MAX_CFG_READERS;
    
-   IniTbl->JsonParamCnt = 0;
-
-   /* 
-   ** IniTbl->CfgEnum.Start is defined as 0 so the first array index is unused.
-   ** 'i' starts at 0 and is used to index IniTbl->JsonParams[] because the CJSON
-   ** assumes [0] is a valid entry. See file prologue for more details. 
-   */
-   if (IniTbl->CfgEnum.End <= (INITBL_MAX_CFG_ITEMS+1))
+   if (IniTbl->ReaderCnt < INITBL_MAX_CFG_READERS)
    {
-  
-      IniTbl->JsonParamCnt = IniTbl->CfgEnum.End - 1;
-      
-      for ( Param=(IniTbl->CfgEnum.Start+1),i=0; Param < IniTbl->CfgEnum.End; Param++,i++)
-      {
-   
-         CfgStrPtr  = (IniTbl->CfgEnum.GetStr)(Param);
-         CfgTypePtr = (IniTbl->CfgEnum.GetType)(Param);
-         
-         CJSON_Obj_t *JsonParam = &IniTbl->JsonParams[i];
-         
-         if (strcmp(CfgTypePtr, INILIB_TYPE_INT) == 0)
-         {
-      
-            JsonParam->TblData      = &IniTbl->CfgData[Param].Int;
-            JsonParam->TblDataLen   = sizeof(uint32);
-            JsonParam->Updated      = false;
-            JsonParam->Type         = JSONNumber;
-            JsonParam->TypeFlt      = false;
-            strncpy(JsonParam->Query.Key, INITBL_JSON_CONFIG_OBJ_PREFIX, CJSON_MAX_KEY_LEN);
-            strncat(JsonParam->Query.Key, CfgStrPtr, CJSON_MAX_KEY_LEN);
-            JsonParam->Query.KeyLen = strlen(JsonParam->Query.Key);
-         
-         } /* End if integer */
-         else if (strcmp(CfgTypePtr, INILIB_TYPE_FLT) == 0)
-         {
-            JsonParam->TblData      = &IniTbl->CfgData[Param].Flt;
-            JsonParam->TblDataLen   = sizeof(float);
-            JsonParam->Updated      = false;
-            JsonParam->Type         = JSONNumber;
-            JsonParam->TypeFlt      = true;
-            strncpy(JsonParam->Query.Key, INITBL_JSON_CONFIG_OBJ_PREFIX, CJSON_MAX_KEY_LEN);
-            strncat(JsonParam->Query.Key, CfgStrPtr, CJSON_MAX_KEY_LEN);
-            JsonParam->Query.KeyLen = strlen(JsonParam->Query.Key);
-         } /* End if float */
-         else if (strcmp(CfgTypePtr, INILIB_TYPE_STR) == 0)
-         {
-            JsonParam->TblData      = &IniTbl->CfgData[Param].Str;
-            JsonParam->TblDataLen   = INITBL_MAX_CFG_STR_LEN;
-            JsonParam->Updated      = false;
-            JsonParam->Type         = JSONString;
-            JsonParam->TypeFlt      = false;
-            strncpy(JsonParam->Query.Key, INITBL_JSON_CONFIG_OBJ_PREFIX, CJSON_MAX_KEY_LEN);
-            strncat(JsonParam->Query.Key, CfgStrPtr, CJSON_MAX_KEY_LEN);
-            JsonParam->Query.KeyLen = strlen(JsonParam->Query.Key);
-
-         }  /* End if string */
-         else 
-         {
-            RetStatus = false;
-            CFE_EVS_SendEvent(INITBL_CFG_PARAM_ERR_EID, CFE_EVS_EventType_ERROR,
-                               "Invalid Configuration parameter type %s", CfgTypePtr);
-         }
-
-      } /* End Param loop */      
-   } /* End if valid number of paramaters */
+      ReaderId = IniTbl->ReaderCnt;
+      IniTbl->ReaderBank[ReaderId] = INITBL_CFG_NO_BANK;
+      IniTbl->ReaderCnt++;
+   }
    else
    {
-      
-      RetStatus = false;
-      CFE_EVS_SendEvent(INITBL_CFG_PARAM_ERR_EID, CFE_EVS_EventType_ERROR,
-                        "Number of configuration parameters %d is greater than IniTbl max %d",
-                        IniTbl->CfgEnum.End, (INITBL_MAX_CFG_ITEMS+1));
-                      
-   } /* End if invalid number of paramaters */     
+      CFE_EVS_SendEvent(INITBL_RELOAD_ERR_EID, CFE_EVS_EventType_ERROR, 
+                        "INITBL reader not registered. Maximum of %d readers already registered",
+                        INITBL_MAX_CFG_READERS);
+   }
    
+   return ReaderId;
    
-   return RetStatus;
-
-} /* BuildJsonTblObjArray() */
-
+} /* INITBL_RegisterReader() */
 
 
 /******************************************************************************
-** Function: LoadJsonData
+** Function: INITBL_RegisterReloadCallback
 **
-** Notes:
-**  1. This is a callback function from CJSON. All of the initialization
-**     configuration parameters should be defined and it is considered and
-**     error if this is not the case.
 */
-static bool LoadJsonData(size_t JsonFileLen, void *UserDataPtr)
+bool INITBL_RegisterReloadCallback(INITBL_Class_t *IniTbl, INITBL_ParamChanged_t ParamChanged,
+                                   void *UserDataPtr)
 {
-
-   bool            RetStatus = false;
-   size_t          ObjLoadCnt;
-   INITBL_Class_t* IniTbl = (INITBL_Class_t*)UserDataPtr; 
-
-
-   IniTbl->JsonFileLen = JsonFileLen;
    
-   ObjLoadCnt = CJSON_LoadObjArray(IniTbl->JsonParams, IniTbl->JsonParamCnt, IniTbl->JsonBuf, IniTbl->JsonFileLen);
-
-   if (ObjLoadCnt == IniTbl->JsonParamCnt)
+   bool RetStatus = false;
+   
+   if (IniTbl->ReloadCallbackCnt < INITBL_MAX_RELOAD_CALLBACKS)
+   {
+      IniTbl->ReloadCallback[IniTbl->ReloadCallbackCnt].ParamChanged = ParamChanged;
+      IniTbl->ReloadCallback[IniTbl->ReloadCallbackCnt].UserDataPtr  = UserDataPtr;
+      IniTbl->ReloadCallbackCnt++;
+      RetStatus = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent(INITBL_RELOAD_ERR_EID, CFE_EVS_EventType_ERROR, 
+                        "INITBL reload callback not registered. Maximum of %d callbacks already registered",
+                        INITBL_MAX_RELOAD_CALLBACKS);
+   }
+   
+   return RetStatus;
+   
+} /* INITBL_RegisterReloadCallback() */
+
+
+/******************************************************************************
+** Function: INITBL_ReleaseCfg
+**
+*/
+void INITBL_ReleaseCfg(INITBL_Class_t *IniTbl, uint8 ReaderId)
+{
+   
+   if (ReaderId < IniTbl->ReaderCnt)
+   {
+      IniTbl->ReaderBank[ReaderId] = INITBL_CFG_NO_BANK;
+   }
+
+} /* INITBL_ReleaseCfg() */
+
+
+/******************************************************************************
+** Function: INITBL_Reload
+**
+** Notes:
+**    1. JsonParams[] are retargeted to the unpublished bank so the load 
+**       uses the same CJSON_ProcessFileObjArray() path as construction. 
+**       Only Shadow's CfgData[] and ParamValid[] are written so getters 
+**       using the published bank aren't affected by the load.
+**    2. Both banks are zeroed before they are loaded so a parameter's 
+**       CfgData[] entries can be compared with memcmp().
+**    3. Readers only hold the published bank so a reader that isn't 
+**       holding the unpublished bank now can't hold it until after it is
+**       published. See INITBL_AcquireCfg().
+**
+*/
+bool INITBL_Reload(INITBL_Class_t *IniTbl, const char *IniFile)
+{
+   
+   bool   RetStatus = false;
+   bool   Loaded    = (IniTbl->Decode == INITBL_DECODE_EAGER && IniTbl->JsonParamCnt > 0);
+   bool   Held      = false;
+   bool   Changed[INITBL_MAX_CFG_ITEMS+1];
+   uint16 ChangedCnt = 0;
+   uint16 i;
+   int    Param;
+   uint8  ShadowBank = (PublishedBank(IniTbl) + 1) % INITBL_CFG_BANKS;
+   INITBL_CfgBank_t *Published = IniTbl->Cfg;
+   INITBL_CfgBank_t *Shadow    = &IniTbl->CfgBank[ShadowBank];
+   
+   for (i=0; i < IniTbl->JsonParamCnt; i++)
+   {
+      Loaded &= Published->ParamValid[i];
+   }
+   
+   for (i=0; i < IniTbl->ReaderCnt; i++)
+   {
+      Held |= (IniTbl->ReaderBank[i] == ShadowBank);
+   }
+   
+   if (!Loaded)
+   {
+      CFE_EVS_SendEvent(INITBL_RELOAD_ERR_EID, CFE_EVS_EventType_ERROR, 
+                        "INITBL reload of %s rejected. Only a constructed table with eagerly decoded parameters can be reloaded",
+                        IniFile);
+   }
+   else if (Held)
+   {
+      CFE_EVS_SendEvent(INITBL_RELOAD_ERR_EID, CFE_EVS_EventType_ERROR, 
+                        "INITBL reload of %s rejected. A reader still holds the previous configuration",
+                        IniFile);
+   }
+   else
+   {
+   
+      CFE_PSP_MemSet(Shadow, 0, sizeof(INITBL_CfgBank_t));
+      TargetCfgBank(IniTbl, Shadow);
+      
+      RetStatus = CJSON_ProcessFileObjArray(IniFile, NULL, INITBL_MAX_JSON_FILE_CHAR,
+                                            IniTbl->JsonParams, IniTbl->JsonParamCnt, LoadJsonData, IniTbl);
+      if (RetStatus)
+      {
+      
+         for (Param=(IniTbl->CfgEnum.Start+1); Param < IniTbl->CfgEnum.End; Param++)
+         {
+            Changed[Param] = (memcmp(&Published->CfgData[Param], &Shadow->CfgData[Param], 
+                                     sizeof(INITBL_CfgData_t)) != 0);
+            if (Changed[Param]) ChangedCnt++;
+         }
+      
+         /* Shadow was completely written by the calls above so this single store publishes it */
+         IniTbl->Cfg = Shadow;
+         IniTbl->ReloadCnt++;
+         
+         CFE_EVS_SendEvent(INITBL_RELOAD_EID, CFE_EVS_EventType_INFORMATION, 
+                           "INITBL reloaded %s. %d of %d parameters changed",
+                           IniFile, ChangedCnt, (unsigned int)IniTbl->JsonParamCnt);
+         
+         for (Param=(IniTbl->CfgEnum.Start+1); Param < IniTbl->CfgEnum.End; Param++)
+         {
+            for (i=0; Changed[Param] && i < IniTbl->ReloadCallbackCnt; i++)
+            {
+               (IniTbl->ReloadCallback[i].ParamChanged)(IniTbl->ReloadCallback[i].UserDataPtr, Param);
+            }
+         }
+         
+      } /* End if reload valid */
+      else
+      {
+         
+         TargetCfgBank(IniTbl, Published);
+         
+         CFE_EVS_SendEvent(INITBL_RELOAD_ERR_EID, CFE_EVS_EventType_ERROR, 
+                           "INITBL reload of %s failed. The current configuration is unchanged",
+                           IniFile);
+      }
+   
+   } /* End if table can be reloaded */
+   
+   return RetStatus;
+   
+} /* INITBL_Reload() */
+
+
+/******************************************************************************
+** Function: INITBL_ReloadCmd
+**
+** Notes:
+**    1. This function must comply with the CMDMGR_CmdFuncPtr_t definition
+**
+*/
+bool INITBL_ReloadCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   bool RetStatus = false;
+   INITBL_Class_t *IniTbl = (INITBL_Class_t *) ObjDataPtr;
+   const INITBL_ReloadCmdMsg_Payload_t *ReloadCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, INITBL_ReloadCmdMsg_t);
+   
+   /* Errors reported by utility so no need for else clause */
+   if (FileUtil_VerifyFileForRead(ReloadCmd->Filename))
+   {
+      RetStatus = INITBL_Reload(IniTbl, ReloadCmd->Filename);
+   }
+   
+   return RetStatus;
+   
+} /* INITBL_ReloadCmd() */
+
+
+/******************************************************************************
+** Function: BuildJsonTblObjArray
+**
+** Notes:
+**   1. This uses the INILIB parameter definitions to create an array of 
+**      CJSON_Obj_t that can be used to process the JSON ini file.
+**   2. Each parameter's type string is resolved to its ParamType[] once
+**      here so the getters and BuildSnapshot() don't compare strings.
+**
+*/
+static bool BuildJsonTblObjArray (INITBL_Class_t *IniTbl)
+{
+
+   bool RetStatus = true;
+   int  Param, i, Type;
+   const char *CfgStrPtr;
+   const char *CfgTypePtr;
+   char QueryKey[CJSON_MAX_KEY_LEN+INITBL_MAX_CFG_STR_LEN];
+   
+   
+   IniTbl->JsonParamCnt = 0;
+
+   /* 
+   ** IniTbl->CfgEnum.Start is defined as 0 so the first array index is unused.
+   ** 'i' starts at 0 and is used to index IniTbl->JsonParams[] because the CJSON
+   ** assumes [0] is a valid entry. See file prologue for more details. 
+   */
+   if (IniTbl->CfgEnum.End <= (INITBL_MAX_CFG_ITEMS+1))
+   {
+  
+      IniTbl->JsonParamCnt = IniTbl->CfgEnum.End - 1;
+      
+      for ( Param=(IniTbl->CfgEnum.Start+1),i=0; Param < IniTbl->CfgEnum.End; Param++,i++)
+      {
+   
+         CfgStrPtr  = (IniTbl->CfgEnum.GetStr)(Param);
+         CfgTypePtr = (IniTbl->CfgEnum.GetType)(Param);
+         
+         CJSON_Obj_t *JsonParam = &IniTbl->JsonParams[i];
+         
+         strncpy(QueryKey, INITBL_JSON_CONFIG_OBJ_PREFIX, sizeof(QueryKey)-1);
+         QueryKey[sizeof(QueryKey)-1] = '\0';
+         strncat(QueryKey, CfgStrPtr, sizeof(QueryKey)-strlen(QueryKey)-1);
+         
+         Type = 0;
+         while (Type < INITBL_PARAM_TYPE_CNT && strcmp(CfgTypePtr, ParamTypeStr[Type]) != 0)
+         {
+            Type++;
+         }
+         IniTbl->ParamType[i] = (uint8)Type;
+         
+         switch (Type)
+         {
+            case INITBL_PARAM_INT:
+               CJSON_NumObjConstructor(JsonParam, QueryKey, JSONNumUint32,
+                                       &IniTbl->LoadBank->CfgData[Param].Int, sizeof(uint32));
+               break;
+            case INITBL_PARAM_FLT:
+               CJSON_FltObjConstructor(JsonParam, QueryKey, JSONNumber,
+                                       &IniTbl->LoadBank->CfgData[Param].Flt, sizeof(float));
+               break;
+            case INITBL_PARAM_STR:
+               CJSON_ObjConstructor(JsonParam, QueryKey, JSONString,
+                                    &IniTbl->LoadBank->CfgData[Param].Str, INITBL_MAX_CFG_STR_LEN);
+               break;
+            case INITBL_PARAM_BOOL:
+               CJSON_BoolObjConstructor(JsonParam, QueryKey,
+                                        &IniTbl->LoadBank->CfgData[Param].Bool, sizeof(bool));
+               break;
+            case INITBL_PARAM_INT64:
+               CJSON_NumObjConstructor(JsonParam, QueryKey, JSONNumInt64,
+                                       &IniTbl->LoadBank->CfgData[Param].Int64, sizeof(int64));
+               break;
+            case INITBL_PARAM_DBL:
+               CJSON_NumObjConstructor(JsonParam, QueryKey, JSONNumDouble,
+                                       &IniTbl->LoadBank->CfgData[Param].Dbl, sizeof(double));
+               break;
+            case INITBL_PARAM_INT_ARRAY:
+               CJSON_ArrayObjConstructor(JsonParam, QueryKey, JSONNumUint32,
+                                         IniTbl->LoadBank->CfgData[Param].IntArray.Value, 
+                                         sizeof(IniTbl->LoadBank->CfgData[Param].IntArray.Value));
+               break;
+            case INITBL_PARAM_FLT_ARRAY:
+               CJSON_ArrayObjConstructor(JsonParam, QueryKey, JSONNumFloat,
+                                         IniTbl->LoadBank->CfgData[Param].FltArray.Value, 
+                                         sizeof(IniTbl->LoadBank->CfgData[Param].FltArray.Value));
+               break;
+            default:
+               RetStatus = false;
+               CFE_EVS_SendEvent(INITBL_CFG_PARAM_ERR_EID, CFE_EVS_EventType_ERROR,
+                                 "Invalid Configuration parameter type %s", CfgTypePtr);
+               break;
+         } /* End type switch */
+
+      } /* End Param loop */      
+   } /* End if valid number of paramaters */
+   else
+   {
+      
+      RetStatus = false;
+      CFE_EVS_SendEvent(INITBL_CFG_PARAM_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Number of configuration parameters %d is greater than IniTbl max %d",
+                        IniTbl->CfgEnum.End, (INITBL_MAX_CFG_ITEMS+1));
+                      
+   } /* End if invalid number of paramaters */     
+   
+   
+   return RetStatus;
+
+} /* BuildJsonTblObjArray() */
+
+
+/******************************************************************************
+** Function: BuildParamHash
+**
+** Notes:
+**   1. Builds a two level "hash and displace" perfect hash of the parameter
+**      names. A name's unseeded hash selects one of JsonParamCnt buckets and
+**      the name is rehashed with its bucket's displacement seed to select
+**      one of 2*JsonParamCnt slots. 
+**   2. Buckets are placed largest first and each bucket's seed is the first
+**      one that moves all of its names into empty slots. With half of the
+**      slots empty a seed is found after a few attempts.
+**   3. A failure only affects INITBL_GetParam(), which compares the name of
+**      the parameter it finds so it can't return the wrong parameter.
+**
+*/
+static void BuildParamHash(INITBL_Class_t *IniTbl)
+{
+
+   bool    RetStatus = true;
+   bool    Placed;
+   size_t  ParamCnt  = IniTbl->JsonParamCnt;
+   size_t  SlotCnt   = 2*ParamCnt;
+   size_t  i, j;
+   uint16  BucketSize, MaxBucketSize = 0;
+   uint32  Bucket, Disp;
+   uint32  ParamBucket[INITBL_MAX_CFG_ITEMS];
+   uint16  BucketCnt[INITBL_MAX_CFG_ITEMS];
+   uint32  Slot[INITBL_MAX_CFG_ITEMS];
+   
+   memset(IniTbl->ParamHash, 0, sizeof(IniTbl->ParamHash));
+   memset(BucketCnt, 0, sizeof(BucketCnt));
+   
+   for (i=0; i < ParamCnt; i++)
+   {
+      ParamBucket[i] = HashParamName((IniTbl->CfgEnum.GetStr)(i+1), 0) % ParamCnt;
+      BucketCnt[ParamBucket[i]]++;
+      if (BucketCnt[ParamBucket[i]] > MaxBucketSize)
+      {
+         MaxBucketSize = BucketCnt[ParamBucket[i]];
+      }
+   }
+   
+   for (BucketSize = MaxBucketSize; RetStatus && BucketSize > 0; BucketSize--)
+   {
+      for (Bucket=0; RetStatus && Bucket < ParamCnt; Bucket++)
+      {
+         
+         if (BucketCnt[Bucket] != BucketSize)
+         {
+            /* Placed with a different bucket size */
+         }
+         else
+         {
+         
+            Placed = false;
+            
+            for (Disp=1; !Placed && Disp <= INITBL_PARAM_HASH_MAX_DISP; Disp++)
+            {
+               
+               Placed = true;
+               
+               /* Tentatively fill the bucket's slots, they are cleared if a name collides */
+               for (i=0; Placed && i < ParamCnt; i++)
+               {
+                  if (ParamBucket[i] == Bucket)
+                  {
+                     Slot[i] = HashParamName((IniTbl->CfgEnum.GetStr)(i+1), Disp) % SlotCnt;
+                     if (IniTbl->ParamHash[Slot[i]] == 0)
+                     {
+                        IniTbl->ParamHash[Slot[i]] = i+1;
+                     }
+                     else
+                     {
+                        Placed = false;
+                        for (j=0; j < i; j++)
+                        {
+                           if (ParamBucket[j] == Bucket)
+                           {
+                              IniTbl->ParamHash[Slot[j]] = 0;
+                           }
+                        }
+                     }
+                  }
+               } /* End param loop */
+               
+               if (Placed)
+               {
+                  IniTbl->ParamHashDisp[Bucket] = Disp;
+               }
+               
+            } /* End displacement loop */
+            
+            if (!Placed)
+            {
+               RetStatus = false;
+               CFE_EVS_SendEvent(INITBL_PARAM_HASH_ERR_EID, CFE_EVS_EventType_ERROR,
+                                 "INITBL parameter name hash could not be built for %d parameters",
+                                 (unsigned int)ParamCnt);
+            }
+         
+         } /* End if bucket of current size */
+      } /* End bucket loop */
+   } /* End bucket size loop */
+   
+} /* BuildParamHash() */
+
+
+/******************************************************************************
+** Function: BuildSnapshot
+**
+** Notes:
+**   1. Populates Bank's INITBL_<TypeName>Struct snapshot using the member 
+**      offsets recorded by DEFINE_ENUM(). Parameters are written in the 
+**      member's type so each member is aligned. String and array members
+**      are pointers to Bank's storage.
+**   2. Bank must be the bank JsonParams[] decode into. A lazy table's 
+**      parameters are decoded as needed so the caller must hold the 
+**      table's LazyMutex.
+**
+*/
+static bool BuildSnapshot(const INITBL_Class_t *IniTbl, INITBL_CfgBank_t *Bank)
+{
+
+   bool   RetStatus = false;
+   int    Param;
+   uint16 JsonObjIndex;
+   uint8  *Snapshot = (uint8*)Bank->Snapshot;
+   const  char *StrPtr;
+   INITBL_IntArray_t *IntArrayPtr;
+   INITBL_FltArray_t *FltArrayPtr;
+   
+   if (IniTbl->CfgEnum.GetOffset == NULL || IniTbl->CfgEnum.StructSize > sizeof(Bank->Snapshot))
+   {
+      CFE_EVS_SendEvent(INITBL_CFG_PARAM_ERR_EID, CFE_EVS_EventType_ERROR, 
+                        "INITBL snapshot requires a DEFINE_ENUM() configuration struct of at most %d bytes",
+                        (unsigned int)sizeof(Bank->Snapshot));
+   }
+   else
+   {
+      
+      RetStatus = true;
+      
+      for (Param=(IniTbl->CfgEnum.Start+1); RetStatus && Param < IniTbl->CfgEnum.End; Param++)
+      {
+   
+         JsonObjIndex = (Param-1);
+         uint8 *Member = &Snapshot[(IniTbl->CfgEnum.GetOffset)(Param)];
+         
+         if (Bank->ParamValid[JsonObjIndex] || LoadParamLoc(IniTbl, Bank, JsonObjIndex))
+         {
+            switch (IniTbl->ParamType[JsonObjIndex])
+            {
+               case INITBL_PARAM_INT:
+                  memcpy(Member, &Bank->CfgData[Param].Int, sizeof(uint32));
+                  break;
+               case INITBL_PARAM_FLT:
+                  memcpy(Member, &Bank->CfgData[Param].Flt, sizeof(float));
+                  break;
+               case INITBL_PARAM_BOOL:
+                  memcpy(Member, &Bank->CfgData[Param].Bool, sizeof(bool));
+                  break;
+               case INITBL_PARAM_INT64:
+                  memcpy(Member, &Bank->CfgData[Param].Int64, sizeof(int64));
+                  break;
+               case INITBL_PARAM_DBL:
+                  memcpy(Member, &Bank->CfgData[Param].Dbl, sizeof(double));
+                  break;
+               case INITBL_PARAM_INT_ARRAY:
+                  IntArrayPtr = &Bank->CfgData[Param].IntArray;
+                  memcpy(Member, &IntArrayPtr, sizeof(IntArrayPtr));
+                  break;
+               case INITBL_PARAM_FLT_ARRAY:
+                  FltArrayPtr = &Bank->CfgData[Param].FltArray;
+                  memcpy(Member, &FltArrayPtr, sizeof(FltArrayPtr));
+                  break;
+               default:
+                  StrPtr = Bank->CfgData[Param].Str;
+                  memcpy(Member, &StrPtr, sizeof(StrPtr));
+                  break;
+            }
+         }
+         else
+         {
+            RetStatus = false;
+            CFE_EVS_SendEvent(INITBL_CFG_PARAM_ERR_EID, CFE_EVS_EventType_ERROR, 
+                              "INITBL snapshot error. Parameter %s could not be decoded",
+                              (IniTbl->CfgEnum.GetStr)(Param));
+         }
+         
+      } /* End Param loop */
+   }
+   
+   Bank->SnapshotValid = RetStatus;
+   
+   return RetStatus;
+   
+} /* BuildSnapshot() */
+
+
+/******************************************************************************
+** Function: CompactJsonValues
+**
+** Notes:
+**   1. Copies each located value from JsonBuf to the front of the lazy 
+**      store's JsonValues[] and updates its location so the values can be
+**      decoded after JsonBuf is returned to the CJSON buffer pool.
+**   2. Returns false with an event message if the values don't fit in 
+**      JsonValues[].
+**
+*/
+static bool CompactJsonValues(INITBL_Class_t *IniTbl, const char *JsonBuf)
+{
+
+   bool    RetStatus = true;
+   size_t  i;
+   uint32  Pos = 0;
+   CJSON_ObjLoc_t *JsonLoc;
+   
+   for (i=0; RetStatus && i < IniTbl->JsonParamCnt; i++)
+   {
+      
+      JsonLoc = &IniTbl->JsonLoc[i];
+      
+      if (JsonLoc->ValueLen > (sizeof(IniTbl->Lazy->JsonValues) - Pos))
+      {
+         RetStatus = false;
+         CFE_EVS_SendEvent(INITBL_LOAD_JSON_ERR_EID, CFE_EVS_EventType_ERROR, 
+                           "JSON initialization file values exceed the lazy table maximum of %d characters at %s",
+                           INITBL_MAX_LAZY_JSON_CHAR, IniTbl->JsonParams[i].Query.Key);
+      }
+      else
+      {
+         memcpy(&IniTbl->Lazy->JsonValues[Pos], &JsonBuf[JsonLoc->Value], JsonLoc->ValueLen);
+         JsonLoc->Value = Pos;
+         Pos += JsonLoc->ValueLen;
+      }
+      
+   } /* End param loop */
+   
+   IniTbl->JsonRetainedLen = Pos;
+   IniTbl->LazyJson        = IniTbl->Lazy->JsonValues;
+   
+   return RetStatus;
+   
+} /* End CompactJsonValues() */
+
+
+/******************************************************************************
+** Function: Construct
+**
+** Notes:
+**   1. Eager decoding loads every parameter while the file is validated.
+**      Lazy decoding only locates them, see DecodeParam().
+**   2. Eager and compacted tables let CJSON borrow the file's buffer for 
+**      the load, LocateJsonData() copies a compacted table's values out of
+**      it. An uncompacted lazy table keeps the buffer so it borrows it
+**      itself.
+**
+*/
+static bool Construct(INITBL_Class_t *IniTbl, const char *IniTblFile, INILIB_CfgEnum_t *CfgEnum,
+                      INITBL_Decode_t Decode, INITBL_LazyStore_t *LazyStore)
+{
+   
+   bool   RetStatus = false;
+   size_t BufLen = INITBL_MAX_JSON_FILE_CHAR;
+   
+   CFE_PSP_MemSet(IniTbl, 0, sizeof(INITBL_Class_t));
+   IniTbl->CfgEnum  = *CfgEnum;
+   IniTbl->Decode   = Decode;
+   IniTbl->Cfg      = &IniTbl->CfgBank[0];
+   IniTbl->LoadBank = &IniTbl->CfgBank[0];
+ 
+   if (BuildJsonTblObjArray (IniTbl))
+   {
+      
+      BuildParamHash(IniTbl);
+      
+      if (Decode == INITBL_DECODE_EAGER)
+      {
+         RetStatus = CJSON_ProcessFileObjArray(IniTblFile, NULL, INITBL_MAX_JSON_FILE_CHAR,
+                                               IniTbl->JsonParams, IniTbl->JsonParamCnt, LoadJsonData, IniTbl);
+      }
+      else if (LazyStore == NULL)
+      {
+         CFE_EVS_SendEvent(INITBL_CONFIG_DEF_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "JSON INITBL definition error. A lazy table requires an INITBL_LazyStore_t");
+      }
+      else if (CreateLazyMutex(IniTbl))
+      {
+         
+         IniTbl->Lazy    = LazyStore;
+         IniTbl->JsonLoc = LazyStore->JsonLoc;
+         
+         if (Decode == INITBL_DECODE_LAZY)
+         {
+            IniTbl->JsonBuf = CJSON_AcquireFileBuf(IniTblFile, BufLen, &BufLen, CJSON_BUF_POOL_TIMEOUT);
+         }
+         
+         if (Decode == INITBL_DECODE_COMPACT || IniTbl->JsonBuf != NULL)
+         {
+            RetStatus = CJSON_ProcessFileLocate(IniTblFile, IniTbl->JsonBuf, BufLen,
+                                                IniTbl->JsonParams, IniTbl->JsonLoc, IniTbl->JsonParamCnt,
+                                                LocateJsonData, IniTbl);
+            if (!RetStatus)
+            {
+               ReleaseJsonBuf(IniTbl);
+            }
+         }
+      }
+   }
+   else 
+   {
+      CFE_EVS_SendEvent(INITBL_CONFIG_DEF_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "JSON INITBL definition error. JSON config file contains % d which is greater than frame maximum defined at %d",
+                        IniTbl->CfgEnum.End, INITBL_MAX_CFG_ITEMS);
+   }
+   
+   return RetStatus;
+   
+} /* End Construct() */
+
+
+/******************************************************************************
+** Function: CreateLazyMutex
+**
+** Notes:
+**   1. OSAL names must be unique so each name has the constructing task's
+**      index and the first free number. A task that constructs more than
+**      INITBL_LAZY_MUTEX_NAMES lazy tables gets an event message.
+**
+*/
+static bool CreateLazyMutex(INITBL_Class_t *IniTbl)
+{
+
+   int32  SysStatus = OS_ERROR;
+   uint32 TaskIndex = 0;
+   uint16 i;
+   char   MutexName[OS_MAX_API_NAME];
+   
+   GetTaskIndex(&TaskIndex);
+   
+   for (i=0; SysStatus != OS_SUCCESS && i < INITBL_LAZY_MUTEX_NAMES; i++)
+   {
+      sprintf(MutexName, "INITBL_%u_%u", (unsigned int)(TaskIndex % 1000), (unsigned int)i);
+      SysStatus = OS_MutSemCreate(&IniTbl->LazyMutex, MutexName, 0);
+   }
+   
+   if (SysStatus != OS_SUCCESS)
    {
+      CFE_EVS_SendEvent(INITBL_CONFIG_DEF_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "JSON INITBL lazy table mutex creation failed. Status = %d",
+                        (int)SysStatus);
+   }
+   
+   return (SysStatus == OS_SUCCESS);
+   
+} /* End CreateLazyMutex() */
+
+
+/******************************************************************************
+** Function: DecodeParam
+**
+** Notes:
+**   1. Decodes a lazy table's located parameter into Bank the first time it
+**      is retrieved. Getters take a const table and the decoded value is
+**      written through the table's bank pointer, see LoadParamLoc().
+**   2. Returns false for eager tables because their parameters were all
+**      decoded during construction.
+**   3. Decoding holds LazyMutex so tasks that retrieve the same parameter
+**      at the same time decode it once. ParamValid[] is set after the value
+**      is written so later retrievals read it without the mutex.
+**
+*/
+static bool DecodeParam(const INITBL_Class_t *IniTbl, INITBL_CfgBank_t *Bank, uint16 JsonObjIndex)
+{
+
+   bool RetStatus = false;
+   
+   if (IniTbl->Decode != INITBL_DECODE_EAGER)
+   {
+      OS_MutSemTake(IniTbl->LazyMutex);
+      RetStatus = (Bank->ParamValid[JsonObjIndex] || LoadParamLoc(IniTbl, Bank, JsonObjIndex));
+      OS_MutSemGive(IniTbl->LazyMutex);
+   }
+   
+   return RetStatus;
+   
+} /* End DecodeParam() */
+
+
+/******************************************************************************
+** Function: GetTaskIndex
+**
+** Notes:
+**   1. Returns false if the calling task's index isn't available.
+**
+*/
+static bool GetTaskIndex(uint32 *TaskIndex)
+{
+
+   CFE_ES_TaskId_t  TaskId;
+   
+   return (CFE_ES_GetTaskID(&TaskId) == CFE_SUCCESS &&
+           CFE_ES_TaskID_ToIndex(TaskId, TaskIndex) == CFE_SUCCESS);
+   
+} /* End GetTaskIndex() */
+
+
+/******************************************************************************
+** Function: HashParamName
+**
+** Notes:
+**   1. FNV-1a hash of a terminated name with Seed folded into the offset
+**      basis so each seed gives an independent hash.
+**
+*/
+static uint32 HashParamName(const char *Name, uint32 Seed)
+{
+
+   uint32 Hash = 0x811C9DC5 ^ (Seed * 0x9E3779B9);
+   
+   while (*Name != '\0')
+   {
+      Hash = (Hash ^ (uint8)*Name) * 0x01000193;
+      Name++;
+   }
+   
+   return Hash;
+   
+} /* End HashParamName() */
+
+
+/******************************************************************************
+** Function: LoadJsonData
+**
+** Notes:
+**  1. This is a callback function from CJSON. All of the initialization
+**     configuration parameters should be defined and it is considered and
+**     error if this is not the case.
+**  2. CJSON loads the parameters while it validates the file so this only
+**     verifies every parameter was loaded.
+*/
+static bool LoadJsonData(size_t JsonFileLen, void *UserDataPtr)
+{
+
+   bool            RetStatus = false;
+   size_t          ObjLoadCnt = 0;
+   size_t          i;
+   INITBL_Class_t* IniTbl = (INITBL_Class_t*)UserDataPtr; 
+
+
+   IniTbl->JsonFileLen = JsonFileLen;
+   
+   for (i=0; i < IniTbl->JsonParamCnt; i++)
+   {
+      if (IniTbl->JsonParams[i].Updated)
+      {
+         StoreArrayCnt(&IniTbl->JsonParams[i], &IniTbl->LoadBank->CfgData[i+1]);
+         IniTbl->LoadBank->ParamValid[i] = true;
+         ObjLoadCnt++;
+      }
+   }
+
+   if (ObjLoadCnt == IniTbl->JsonParamCnt)
+   {
+      if (IniTbl->CfgEnum.GetOffset != NULL)
+      {
+         BuildSnapshot(IniTbl, IniTbl->LoadBank);
+      }
       RetStatus = true;
       CFE_EVS_SendEvent(INITBL_LOAD_JSON_EID, CFE_EVS_EventType_INFORMATION, 
                         "JSON initialization file successfully processed with %d parameters",
@@ -305,37 +1346,275 @@ static bool LoadJsonData(size_t JsonFileLen, void *UserDataPtr)
 
 
 /******************************************************************************
-** Function: ValidJsonObjCfg
+** Function: LoadJsonLayer
 **
+** Notes:
+**  1. This is a callback function from CJSON for one INITBL_LayeredConstructor()
+**     file. CJSON located the parameters while it validated the file and 
+**     only the parameters that a higher priority layer didn't define are 
+**     decoded. A layer doesn't need to define every parameter.
+**  2. A value that can't be decoded is an error rather than being replaced
+**     by a lower priority layer's value.
+**  3. CJSON borrowed the file's buffer, see CJSON_GetFileBuf().
 */
-static bool ValidJsonObjCfg(const INITBL_Class_t *IniTbl, uint16 JsonObjIndex, JSONTypes_t Type)
+static bool LoadJsonLayer(size_t JsonFileLen, void *UserDataPtr)
 {
+
+   bool            RetStatus = true;
+   size_t          i;
+   INITBL_Class_t* IniTbl  = (INITBL_Class_t*)UserDataPtr; 
+   const char*     JsonBuf = CJSON_GetFileBuf();
+
+
+   IniTbl->JsonFileLen = JsonFileLen;
    
-   bool RetStatus = false;
-   
-   
-   CFE_EVS_SendEvent(INITBL_CFG_PARAM_EID, CFE_EVS_EventType_DEBUG,
-                     "ValidJsonObjCfg %d: Type = %s, Key %s with type %s\n", 
-                     JsonObjIndex, CJSON_ObjTypeStr(Type), 
-                     IniTbl->JsonParams[JsonObjIndex].Query.Key, 
-                     CJSON_ObjTypeStr(IniTbl->JsonParams[JsonObjIndex].Type));      
-   
-   if ( JsonObjIndex >= IniTbl->CfgEnum.Start && JsonObjIndex < IniTbl->CfgEnum.End) 
+   for (i=0; i < IniTbl->JsonParamCnt; i++)
    {
-   
-      if (IniTbl->JsonParams[JsonObjIndex].Updated)
+      if (IniTbl->JsonLayer[i] == 0 && IniTbl->JsonLoc[i].Located)
       {
-         if (IniTbl->JsonParams[JsonObjIndex].Type == Type)
+         IniTbl->JsonLayer[i] = IniTbl->LoadLayer;
+         if (CJSON_LoadObjLoc(&IniTbl->JsonParams[i], JsonBuf, &IniTbl->JsonLoc[i]))
          {
-            RetStatus = true;
+            StoreArrayCnt(&IniTbl->JsonParams[i], &IniTbl->LoadBank->CfgData[i+1]);
+            IniTbl->LoadBank->ParamValid[i] = true;
          }
          else
          {
-            CFE_EVS_SendEvent(INITBL_CFG_PARAM_ERR_EID, CFE_EVS_EventType_ERROR, 
-                              "Attempt to retrieve parameter of type %s that was loaded as type %s",
-                              CJSON_ObjTypeStr(Type), CJSON_ObjTypeStr(IniTbl->JsonParams[JsonObjIndex].Type));      
+            RetStatus = false;
          }
       }
+   }
+
+   if (!RetStatus)
+   {
+      CFE_EVS_SendEvent(INITBL_LOAD_JSON_ERR_EID, CFE_EVS_EventType_ERROR, 
+                        "Error decoding JSON initialization file layer %d",
+                        IniTbl->LoadLayer);  
+   }
+   
+   return RetStatus;
+   
+} /* End LoadJsonLayer() */
+
+
+/******************************************************************************
+** Function: LoadParamLoc
+**
+** Notes:
+**   1. Decodes a lazy table's located parameter into Bank using a copy of
+**      its JsonParams[] object, the table itself isn't written. The caller
+**      holds LazyMutex, see DecodeParam().
+**   2. Returns false for eager tables.
+**
+*/
+static bool LoadParamLoc(const INITBL_Class_t *IniTbl, INITBL_CfgBank_t *Bank, uint16 JsonObjIndex)
+{
+
+   bool        RetStatus = false;
+   CJSON_Obj_t JsonParam;
+   
+   if (IniTbl->Decode != INITBL_DECODE_EAGER)
+   {
+      JsonParam = IniTbl->JsonParams[JsonObjIndex];
+      if (CJSON_LoadObjLoc(&JsonParam, IniTbl->LazyJson, &IniTbl->JsonLoc[JsonObjIndex]))
+      {
+         StoreArrayCnt(&JsonParam, &Bank->CfgData[JsonObjIndex+1]);
+         Bank->ParamValid[JsonObjIndex] = true;
+         RetStatus = true;
+      }
+   }
+   
+   return RetStatus;
+   
+} /* End LoadParamLoc() */
+
+
+/******************************************************************************
+** Function: LocateJsonData
+**
+** Notes:
+**  1. This is the lazy decoding version of LoadJsonData(). CJSON located
+**     the parameters while it validated the file so this only verifies 
+**     every parameter was located. A compacted table's values are copied 
+**     from the buffer CJSON borrowed to the lazy store, otherwise they are
+**     decoded from the kept JsonBuf.
+*/
+static bool LocateJsonData(size_t JsonFileLen, void *UserDataPtr)
+{
+
+   bool            RetStatus = false;
+   size_t          ObjLocCnt = 0;
+   size_t          i;
+   INITBL_Class_t* IniTbl = (INITBL_Class_t*)UserDataPtr; 
+
+
+   IniTbl->JsonFileLen = JsonFileLen;
+   
+   for (i=0; i < IniTbl->JsonParamCnt; i++)
+   {
+      if (IniTbl->JsonLoc[i].Located)
+      {
+         ObjLocCnt++;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(INITBL_LOAD_JSON_ERR_EID, CFE_EVS_EventType_ERROR, 
+                           "JSON initialization file does not define %s",
+                           IniTbl->JsonParams[i].Query.Key);
+      }
+   }
+
+   if (ObjLocCnt == IniTbl->JsonParamCnt)
+   {
+      if (IniTbl->Decode == INITBL_DECODE_LAZY)
+      {
+         IniTbl->LazyJson        = IniTbl->JsonBuf;
+         IniTbl->JsonRetainedLen = JsonFileLen;
+         RetStatus = true;
+      }
+      else
+      {
+         RetStatus = CompactJsonValues(IniTbl, CJSON_GetFileBuf());
+      }
+      
+      if (RetStatus)
+      {
+         CFE_EVS_SendEvent(INITBL_LOAD_JSON_EID, CFE_EVS_EventType_INFORMATION, 
+                           "JSON initialization file successfully processed with %d parameters. %d of %d characters retained",
+                           (unsigned int)IniTbl->JsonParamCnt, (unsigned int)IniTbl->JsonRetainedLen, 
+                           (unsigned int)JsonFileLen);
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent(INITBL_LOAD_JSON_ERR_EID, CFE_EVS_EventType_ERROR, 
+                        "Error processing JSON initialization file. %d of %d parameters located",
+                        (unsigned int)ObjLocCnt, (unsigned int)IniTbl->JsonParamCnt);  
+   }
+   
+   return RetStatus;
+   
+} /* End LocateJsonData() */
+
+
+/******************************************************************************
+** Function: PublishedBank
+**
+** Notes:
+**   1. Returns the CfgBank[] index of the published bank. IniTbl->Cfg is 
+**      read once.
+**
+*/
+static uint8 PublishedBank(const INITBL_Class_t *IniTbl)
+{
+
+   return (IniTbl->Cfg == &IniTbl->CfgBank[0]) ? 0 : 1;
+   
+} /* End PublishedBank() */
+
+
+/******************************************************************************
+** Function: ReleaseJsonBuf
+**
+** Notes:
+**   1. Returns the table's borrowed JSON buffer to the CJSON buffer pool.
+**      Only an uncompacted lazy table borrows a buffer itself.
+**
+*/
+static void ReleaseJsonBuf(INITBL_Class_t *IniTbl)
+{
+
+   if (IniTbl->JsonBuf != NULL)
+   {
+      CJSON_ReleaseBuf(IniTbl->JsonBuf);
+      IniTbl->JsonBuf = NULL;
+   }
+   
+} /* End ReleaseJsonBuf() */
+
+
+/******************************************************************************
+** Function: StoreArrayCnt
+**
+** Notes:
+**   1. CJSON records a loaded array's element count in its object so it is
+**      copied to the array's CfgData storage.
+**
+*/
+static void StoreArrayCnt(const CJSON_Obj_t *JsonParam, INITBL_CfgData_t *CfgData)
+{
+
+   if (JsonParam->Type == JSONArray)
+   {
+      if (JsonParam->NumType == JSONNumFloat)
+      {
+         CfgData->FltArray.Cnt = (uint16)JsonParam->ArrayCnt;
+      }
+      else
+      {
+         CfgData->IntArray.Cnt = (uint16)JsonParam->ArrayCnt;
+      }
+   }
+   
+} /* End StoreArrayCnt() */
+
+
+/******************************************************************************
+** Function: TargetCfgBank
+**
+** Notes:
+**   1. Moves each JsonParams[] TblData pointer to the same CfgData[] entry
+**      in Bank and makes Bank the bank loaded by the next file.
+**
+*/
+static void TargetCfgBank(INITBL_Class_t *IniTbl, INITBL_CfgBank_t *Bank)
+{
+
+   size_t i;
+   size_t Offset;
+   
+   for (i=0; i < IniTbl->JsonParamCnt; i++)
+   {
+      Offset = (uint8*)IniTbl->JsonParams[i].TblData - (uint8*)IniTbl->LoadBank;
+      IniTbl->JsonParams[i].TblData = (uint8*)Bank + Offset;
+   }
+   
+   IniTbl->LoadBank = Bank;
+   
+} /* End TargetCfgBank() */
+
+
+/******************************************************************************
+** Function: ValidJsonObjCfg
+**
+** Notes:
+**   1. Called by every getter so the only event messages are for errors.
+**      ParamType[] was resolved by BuildJsonTblObjArray().
+**   2. Cfg is the bank the getter read from IniTbl->Cfg. The parameter's
+**      validity and value are both read from it so a reload publishing 
+**      the other bank during the call can't mix the banks.
+**
+*/
+static bool ValidJsonObjCfg(const INITBL_Class_t *IniTbl, INITBL_CfgBank_t *Cfg, uint16 JsonObjIndex,
+                            INITBL_ParamType_t ParamType)
+{
+   
+   bool RetStatus = false;
+   
+   
+   if (JsonObjIndex < IniTbl->JsonParamCnt) 
+   {
+   
+      if (IniTbl->ParamType[JsonObjIndex] != ParamType)
+      {
+         CFE_EVS_SendEvent(INITBL_CFG_PARAM_ERR_EID, CFE_EVS_EventType_ERROR, 
+                           "Attempt to retrieve parameter of type %s that was loaded as type %s",
+                           ParamTypeStr[ParamType], ParamTypeStr[IniTbl->ParamType[JsonObjIndex]]);      
+      }
+      else if (Cfg->ParamValid[JsonObjIndex] || DecodeParam(IniTbl, Cfg, JsonObjIndex))
+      {
+         RetStatus = true;
+      }
       else
       {
          CFE_EVS_SendEvent(INITBL_CFG_PARAM_ERR_EID, CFE_EVS_EventType_ERROR, 
@@ -346,7 +1625,7 @@ static bool ValidJsonObjCfg(const INITBL_Class_t *IniTbl, uint16 JsonObjIndex, J
    else
    {
       CFE_EVS_SendEvent(INITBL_CFG_PARAM_ERR_EID, CFE_EVS_EventType_ERROR, "Attempt to retrieve invalid parameter %d that is not in valid range: %d < param < %d",
-                        JsonObjIndex, IniTbl->CfgEnum.Start, IniTbl->CfgEnum.End);
+                        (uint16)(JsonObjIndex+1), IniTbl->CfgEnum.Start, IniTbl->CfgEnum.End);
    }
    
    return RetStatus;
@@ -30,6 +30,7 @@
 
 #include "osk_c_fw_cfg.h"
 #include "osk_c_fw_ver.h"
+#include "cjson.h"
 
 /*
 ** Exported Functions
@@ -38,14 +39,35 @@
 /******************************************************************************
 ** Entry function
 **
+** Notes:
+**   1. Libraries don't register with EVS so failures are reported with
+**      OS_printf() and a failure status is returned so ES doesn't start
+**      apps that depend on a partially initialized library.
+**
 */
 uint32 OSK_C_FW_LibInit(void)
 {
 
-   OS_printf("OSK C Application Framework Library Initialized. Version %d.%d.%d\n",
-             OSK_C_FW_MAJOR_VER, OSK_C_FW_MINOR_VER, OSK_C_FW_LOCAL_REV);
+   uint32 RetStatus = OSK_C_FW_CFS_ERROR;
+   
+   if (CJSON_LibInit())
+   {
+   
+      OS_printf("OSK C Application Framework Library Initialized. Version %d.%d.%d\n",
+                OSK_C_FW_MAJOR_VER, OSK_C_FW_MINOR_VER, OSK_C_FW_LOCAL_REV);
+      
+      RetStatus = OS_SUCCESS;
+   
+   }
+   else
+   {
+   
+      OS_printf("OSK C Application Framework Library initialization failed. CJSON_LibInit() "
+                "couldn't create its search cursor or buffer pool semaphores\n");
+   
+   }
    
-   return OS_SUCCESS;
+   return RetStatus;
 
 } /* End OSK_C_FW_LibInit() */
 
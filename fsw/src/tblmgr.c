@@ -33,10 +33,18 @@
 #include <string.h>
 #include "cfe.h"
 #include "fileutil.h"
+#include "crc.h"
 #include "tblmgr.h"
 #include "cmdmgr.h"
 
 
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TBLMGR_FILE_CRC_BUF_LEN  256   /* Bytes read per OS_read() when computing a file's CRC */
+
+
 /*******************************/
 /** Local Function Prototypes **/
 /*******************************/
@@ -44,6 +52,64 @@
 static bool LoadTblStub(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename);
 static bool DumpTblStub(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename);
 
+static void BinHdrDecode(TBLMGR_BinHdr_t* BinHdr, const uint8* Buf);
+static void BinHdrEncode(uint8* Buf, const TBLMGR_BinHdr_t* BinHdr);
+static uint16 BinHostFlags(void);
+static bool DumpBinFile(const char* Filename, uint32 SchemaId, uint32 SchemaVer, const uint32* SourceCrc,
+                        const void* TblData, size_t TblDataLen, uint16 EventType);
+static bool FileCrc(const char* Filename, uint32* Crc);
+static bool LoadBinFile(const char* Filename, uint32 SchemaId, uint32 SchemaVer, const uint32* SourceCrc,
+                        void* TblData, size_t TblDataLen, uint16 EventType);
+
+static void CommitLoadCopy(TBLMGR_Tbl_t* Tbl);
+static void LoadDefTbl(TBLMGR_Class_t* TblMgr, uint8 TblId, const char* TblFilename);
+static bool PrepareLoadCopy(TBLMGR_Tbl_t* Tbl);
+static bool ReadBinHdr(osal_id_t FileHandle, TBLMGR_BinHdr_t* BinHdr);
+
+
+/******************************************************************************
+** Function: TBLMGR_AcquireTbl
+**
+** Notes:
+**  1. ActiveCopy is read again after the reader's hold is stored. If a load
+**     was committed in between, the hold may be on the copy the next load
+**     overwrites so the hold is moved to the new active copy. Loads are
+**     commanded so the loop rarely runs more than once.
+**  2. No events are sent because readers call this every processing cycle.
+*/
+const void* TBLMGR_AcquireTbl(TBLMGR_Class_t* TblMgr, uint8 TblId, uint8 ReaderId)
+{
+
+   const void*    TblPtr = NULL;
+   TBLMGR_Tbl_t*  Tbl;
+   uint8          Copy;
+   
+   if (TblId < TblMgr->NextAvailableId)
+   {
+      
+      Tbl = &(TblMgr->Tbl[TblId]);
+      if (Tbl->DblBuf && ReaderId < Tbl->ReaderCnt)
+      {
+         
+         Copy = Tbl->ReaderCopy[ReaderId];
+         if (Copy == TBLMGR_DBL_BUF_NO_COPY)
+         {
+            do
+            {
+               Copy = Tbl->ActiveCopy;
+               Tbl->ReaderCopy[ReaderId] = Copy;
+            } while (Copy != Tbl->ActiveCopy);
+         }
+         
+         TblPtr = Tbl->Copy[Copy];
+         
+      } /* End if valid reader */
+   }
+   
+   return TblPtr;
+   
+} /* End TBLMGR_AcquireTbl() */
+
 
 /******************************************************************************
 ** Function: TBLMGR_Constructor
@@ -68,6 +134,19 @@ void TBLMGR_Constructor(TBLMGR_Class_t* TblMgr)
 } /* End TBLMGR_Constructor() */
 
 
+/******************************************************************************
+** Function: TBLMGR_DumpBinTbl
+**
+*/
+bool TBLMGR_DumpBinTbl(const char* Filename, uint32 SchemaId, uint32 SchemaVer,
+                       const void* TblData, size_t TblDataLen)
+{
+
+   return DumpBinFile(Filename, SchemaId, SchemaVer, NULL, TblData, TblDataLen, CFE_EVS_EventType_ERROR);
+   
+} /* End TBLMGR_DumpBinTbl() */
+
+
 /******************************************************************************
 ** Function: TBLMGR_DumpTblCmd
 **
@@ -136,6 +215,18 @@ const TBLMGR_Tbl_t* TBLMGR_GetLastTblStatus(TBLMGR_Class_t* TblMgr)
 } /* End TBLMGR_GetLastTblStatus() */
 
 
+/******************************************************************************
+** Function: TBLMGR_GetLoadTbl
+**
+*/
+void* TBLMGR_GetLoadTbl(const TBLMGR_Tbl_t* Tbl)
+{
+
+   return Tbl->DblBuf ? Tbl->Copy[Tbl->LoadCopy] : NULL;
+   
+} /* End TBLMGR_GetLoadTbl() */
+
+
 /******************************************************************************
 ** Function: TBLMGR_GetTblStatus
 **
@@ -156,6 +247,74 @@ const TBLMGR_Tbl_t* TBLMGR_GetTblStatus(TBLMGR_Class_t* TblMgr, uint8 TblId)
 } /* End TBLMGR_GetTblStatus() */
 
 
+/******************************************************************************
+** Function: TBLMGR_LoadBinTbl
+**
+*/
+bool TBLMGR_LoadBinTbl(const char* Filename, uint32 SchemaId, uint32 SchemaVer,
+                       void* TblData, size_t TblDataLen)
+{
+
+   return LoadBinFile(Filename, SchemaId, SchemaVer, NULL, TblData, TblDataLen, CFE_EVS_EventType_ERROR);
+   
+} /* End TBLMGR_LoadBinTbl() */
+
+
+/******************************************************************************
+** Function: TBLMGR_LoadCachedTbl
+**
+** Notes:
+**  1. A source file that can't be read is passed to ParseTblFunc so it 
+**     reports the error.
+**  2. Cache misses and cache write failures are reported as information
+**     events because the table is still loaded from its source file.
+*/
+bool TBLMGR_LoadCachedTbl(const char* Filename, uint32 SchemaId, uint32 SchemaVer,
+                          void* TblData, size_t TblDataLen,
+                          TBLMGR_ParseTblFuncPtr_t ParseTblFunc, void* UserDataPtr)
+{
+
+   bool    RetStatus = false;
+   uint32  SourceCrc;
+   char    CacheFilename[OS_MAX_PATH_LEN];
+   
+   if ((strlen(Filename) + strlen(TBLMGR_BIN_CACHE_EXT)) < OS_MAX_PATH_LEN &&
+       FileCrc(Filename, &SourceCrc))
+   {
+   
+      strcpy(CacheFilename, Filename);
+      strcat(CacheFilename, TBLMGR_BIN_CACHE_EXT);
+      
+      if (LoadBinFile(CacheFilename, SchemaId, SchemaVer, &SourceCrc, TblData, TblDataLen, 
+                      CFE_EVS_EventType_INFORMATION))
+      {
+         RetStatus = true;
+         CFE_EVS_SendEvent(TBLMGR_BIN_CACHE_EID, CFE_EVS_EventType_DEBUG,
+                           "Loaded %s from binary cache %s", Filename, CacheFilename);
+      }
+      else
+      {
+      
+         RetStatus = ParseTblFunc(Filename, UserDataPtr);
+      
+         if (RetStatus)
+         {
+            DumpBinFile(CacheFilename, SchemaId, SchemaVer, &SourceCrc, TblData, TblDataLen,
+                        CFE_EVS_EventType_INFORMATION);
+         }
+      }
+      
+   } /* End if source file CRC */
+   else
+   {
+      RetStatus = ParseTblFunc(Filename, UserDataPtr);
+   }
+   
+   return RetStatus;
+   
+} /* End TBLMGR_LoadCachedTbl() */
+
+
 /******************************************************************************
 ** Function: TBLMGR_LoadTblCmd
 **
@@ -185,16 +344,22 @@ bool TBLMGR_LoadTblCmd(void* ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
       if (FileUtil_VerifyFileForRead(LoadTblCmd->Filename))
       {
 
-         if (DBG_TBLMGR) OS_printf("TBLMGR_LoadTblCmd() Before Tbl->LoadFuncPtr call\n");
          Tbl = &(TblMgr->Tbl[LoadTblCmd->Id]);
-         RetStatus = (Tbl->LoadFuncPtr) (Tbl, LoadTblCmd->Type, LoadTblCmd->Filename);
-         if (RetStatus)
+         /* Errors reported by PrepareLoadCopy() */
+         if (PrepareLoadCopy(Tbl))
          {
-            TblMgr->Tbl[LoadTblCmd->Id].LastActionStatus = TBLMGR_STATUS_VALID;
-            CFE_EVS_SendEvent(TBLMGR_LOAD_SUCCESS_EID, CFE_EVS_EventType_INFORMATION, 
-                              "Successfully %sd table %d using file %s",
-                              TBLMGR_LoadTypeStr(LoadTblCmd->Type),
-                              LoadTblCmd->Id, LoadTblCmd->Filename);
+         
+            if (DBG_TBLMGR) OS_printf("TBLMGR_LoadTblCmd() Before Tbl->LoadFuncPtr call\n");
+            RetStatus = (Tbl->LoadFuncPtr) (Tbl, LoadTblCmd->Type, LoadTblCmd->Filename);
+            if (RetStatus)
+            {
+               CommitLoadCopy(Tbl);
+               TblMgr->Tbl[LoadTblCmd->Id].LastActionStatus = TBLMGR_STATUS_VALID;
+               CFE_EVS_SendEvent(TBLMGR_LOAD_SUCCESS_EID, CFE_EVS_EventType_INFORMATION, 
+                                 "Successfully %sd table %d using file %s",
+                                 TBLMGR_LoadTypeStr(LoadTblCmd->Type),
+                                 LoadTblCmd->Id, LoadTblCmd->Filename);
+            }
          }
       }
    }
@@ -221,13 +386,15 @@ const char* TBLMGR_LoadTypeStr(int8 LoadType)
    {
       "replace",
       "update",
+      "binary replace",
       "undefined" 
    };
 
-   uint8 i = 2;
+   uint8 i = 3;
    
    if ( LoadType == TBLMGR_LOAD_TBL_REPLACE ||
-        LoadType == TBLMGR_LOAD_TBL_UPDATE)
+        LoadType == TBLMGR_LOAD_TBL_UPDATE  ||
+        LoadType == TBLMGR_LOAD_TBL_BINARY)
    {
    
       i = LoadType;
@@ -239,6 +406,55 @@ const char* TBLMGR_LoadTypeStr(int8 LoadType)
 } /* End TBLMGR_LoadTypeStr() */
 
 
+/******************************************************************************
+** Function: TBLMGR_RegisterDblBufTbl
+**
+** Register a double buffered table and optionally load a default table.
+** Returns table ID.
+*/
+uint8 TBLMGR_RegisterDblBufTbl(TBLMGR_Class_t* TblMgr, TBLMGR_LoadTblFuncPtr_t LoadFuncPtr, 
+                               TBLMGR_DumpTblFuncPtr_t DumpFuncPtr, void* TblCopyA, 
+                               void* TblCopyB, size_t TblLen, const char* TblFilename)
+{
+
+   uint8          TblId = TBLMGR_MAX_TBL_PER_APP;
+   TBLMGR_Tbl_t*  Tbl;
+
+   if (TblCopyA != NULL && TblCopyB != NULL && TblCopyA != TblCopyB)
+   {
+   
+      TblId = TBLMGR_RegisterTbl(TblMgr, LoadFuncPtr, DumpFuncPtr);
+   
+      if (TblId < TBLMGR_MAX_TBL_PER_APP)
+      {
+         
+         Tbl = &(TblMgr->Tbl[TblId]);
+         Tbl->DblBuf     = true;
+         Tbl->ActiveCopy = 0;
+         Tbl->LoadCopy   = 1;
+         Tbl->DataLen    = TblLen;
+         Tbl->Copy[0]    = TblCopyA;
+         Tbl->Copy[1]    = TblCopyB;
+         
+         if (TblFilename != NULL)
+         {
+            LoadDefTbl(TblMgr, TblId, TblFilename);
+         }
+         
+      } /* End if TblId valid */
+   }
+   else
+   {
+      TblMgr->LastActionTblId = TBLMGR_MAX_TBL_PER_APP;
+      CFE_EVS_SendEvent (TBLMGR_DBL_BUF_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "Double buffered table registration requires two different table copies");
+   }
+   
+   return TblId;
+   
+} /* End TBLMGR_RegisterDblBufTbl() */
+
+
 /******************************************************************************
 ** Function: TBLMGR_RegisterTbl
 **
@@ -296,28 +512,79 @@ uint8 TBLMGR_RegisterTblWithDef(TBLMGR_Class_t* TblMgr, TBLMGR_LoadTblFuncPtr_t
 {
 
    uint8 TblId = TBLMGR_RegisterTbl(TblMgr, LoadFuncPtr, DumpFuncPtr);
-   TBLMGR_LoadTblCmdMsg_t LoadTblCmd;
 
    if (DBG_TBLMGR) OS_printf("TBLMGR_RegisterTblWithDef() Entry\n");
 
    if (TblId < TBLMGR_MAX_TBL_PER_APP)
    {
-      strncpy (TblMgr->Tbl[TblId].Filename,TblFilename,OS_MAX_PATH_LEN);
-      TblMgr->Tbl[TblId].Filename[OS_MAX_PATH_LEN-1] = '\0';
-      
-      /* Use load table command function */
-      LoadTblCmd.Payload.Id = TblId;
-      LoadTblCmd.Payload.Type = TBLMGR_LOAD_TBL_REPLACE;
-      strncpy (LoadTblCmd.Payload.Filename,TblFilename,OS_MAX_PATH_LEN);
-      TBLMGR_LoadTblCmd(TblMgr, (CFE_MSG_Message_t *)&LoadTblCmd);
-      
-   } /* End if TblId valid */
+      LoadDefTbl(TblMgr, TblId, TblFilename);
+   }
    
    return TblId;
   
 } /* End TBLMGR_RegisterTblWithDef() */  
 
 
+/******************************************************************************
+** Function: TBLMGR_RegisterTblReader
+**
+** Notes:
+**  1. Not reentrant with itself so readers are registered during app
+**     initialization.
+*/
+uint8 TBLMGR_RegisterTblReader(TBLMGR_Class_t* TblMgr, uint8 TblId)
+{
+
+   uint8          ReaderId = TBLMGR_MAX_TBL_READERS;
+   TBLMGR_Tbl_t*  Tbl;
+   
+   if (TblId < TblMgr->NextAvailableId && TblMgr->Tbl[TblId].DblBuf)
+   {
+      
+      Tbl = &(TblMgr->Tbl[TblId]);
+      if (Tbl->ReaderCnt < TBLMGR_MAX_TBL_READERS)
+      {
+         ReaderId = Tbl->ReaderCnt;
+         Tbl->ReaderCopy[ReaderId] = TBLMGR_DBL_BUF_NO_COPY;
+         Tbl->ReaderCnt++;
+      }
+      else
+      {
+         CFE_EVS_SendEvent (TBLMGR_DBL_BUF_ERR_EID, CFE_EVS_EventType_ERROR,
+                            "Attempt to register a reader that would have exceeded the max %d readers for table %d",
+                            TBLMGR_MAX_TBL_READERS, TblId);
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent (TBLMGR_DBL_BUF_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "Table reader registration error. Table %d is not a registered double buffered table",
+                         TblId);
+   }
+   
+   return ReaderId;
+   
+} /* End TBLMGR_RegisterTblReader() */
+
+
+/******************************************************************************
+** Function: TBLMGR_ReleaseTbl
+**
+*/
+void TBLMGR_ReleaseTbl(TBLMGR_Class_t* TblMgr, uint8 TblId, uint8 ReaderId)
+{
+
+   if (TblId < TblMgr->NextAvailableId)
+   {
+      if (TblMgr->Tbl[TblId].DblBuf && ReaderId < TblMgr->Tbl[TblId].ReaderCnt)
+      {
+         TblMgr->Tbl[TblId].ReaderCopy[ReaderId] = TBLMGR_DBL_BUF_NO_COPY;
+      }
+   }
+   
+} /* End TBLMGR_ReleaseTbl() */
+
+
 /******************************************************************************
 ** Function: TBLMGR_ResetStatus
 **
@@ -330,6 +597,166 @@ void TBLMGR_ResetStatus(TBLMGR_Class_t* TblMgr)
 } /* End TBLMGR_ResetStatus() */
 
 
+/******************************************************************************
+** Function: BinHdrDecode
+**
+** Notes:
+**  1. Buf holds a TBLMGR_BIN_HDR_LEN byte big endian header.
+*/
+static void BinHdrDecode(TBLMGR_BinHdr_t* BinHdr, const uint8* Buf)
+{
+
+   BinHdr->Magic     = ((uint32)Buf[0]  << 24) | ((uint32)Buf[1]  << 16) | ((uint32)Buf[2]  << 8) | Buf[3];
+   BinHdr->FormatVer = (uint16)(((uint16)Buf[4] << 8) | Buf[5]);
+   BinHdr->Flags     = (uint16)(((uint16)Buf[6] << 8) | Buf[7]);
+   BinHdr->SchemaId  = ((uint32)Buf[8]  << 24) | ((uint32)Buf[9]  << 16) | ((uint32)Buf[10] << 8) | Buf[11];
+   BinHdr->SchemaVer = ((uint32)Buf[12] << 24) | ((uint32)Buf[13] << 16) | ((uint32)Buf[14] << 8) | Buf[15];
+   BinHdr->DataLen   = ((uint32)Buf[16] << 24) | ((uint32)Buf[17] << 16) | ((uint32)Buf[18] << 8) | Buf[19];
+   BinHdr->Crc       = ((uint32)Buf[20] << 24) | ((uint32)Buf[21] << 16) | ((uint32)Buf[22] << 8) | Buf[23];
+   BinHdr->SourceCrc = ((uint32)Buf[24] << 24) | ((uint32)Buf[25] << 16) | ((uint32)Buf[26] << 8) | Buf[27];
+
+} /* End BinHdrDecode() */
+
+
+/******************************************************************************
+** Function: BinHdrEncode
+**
+** Notes:
+**  1. Buf receives a TBLMGR_BIN_HDR_LEN byte big endian header.
+*/
+static void BinHdrEncode(uint8* Buf, const TBLMGR_BinHdr_t* BinHdr)
+{
+
+   const uint32 Field[] = { BinHdr->Magic, 
+                            ((uint32)BinHdr->FormatVer << 16) | BinHdr->Flags,
+                            BinHdr->SchemaId, BinHdr->SchemaVer, BinHdr->DataLen, BinHdr->Crc,
+                            BinHdr->SourceCrc };
+   uint16 i;
+   
+   for (i=0; i < (sizeof(Field)/sizeof(Field[0])); i++)
+   {
+      Buf[4*i]   = (uint8)(Field[i] >> 24);
+      Buf[4*i+1] = (uint8)(Field[i] >> 16);
+      Buf[4*i+2] = (uint8)(Field[i] >> 8);
+      Buf[4*i+3] = (uint8)(Field[i]);
+   }
+
+} /* End BinHdrEncode() */
+
+
+/******************************************************************************
+** Function: BinHostFlags
+**
+** Notes:
+**  1. Returns the binary table flags that describe this processor's table
+**     data.
+*/
+static uint16 BinHostFlags(void)
+{
+
+   const uint16 EndianProbe = 1;
+   
+   return (*((const uint8*)&EndianProbe) == 1) ? TBLMGR_BIN_FLAG_LITTLE_ENDIAN : 0;
+
+} /* End BinHostFlags() */
+
+
+/******************************************************************************
+** Function: CommitLoadCopy
+**
+** Notes:
+**  1. The single byte ActiveCopy store publishes the loaded copy. The old
+**     active copy is loaded next, see PrepareLoadCopy().
+**  2. Nothing is done for tables that aren't double buffered.
+*/
+static void CommitLoadCopy(TBLMGR_Tbl_t* Tbl)
+{
+
+   uint8 OldActiveCopy = Tbl->ActiveCopy;
+   
+   if (Tbl->DblBuf)
+   {
+      Tbl->ActiveCopy = Tbl->LoadCopy;
+      Tbl->LoadCopy   = OldActiveCopy;
+      Tbl->CommitCnt++;
+   }
+
+} /* End CommitLoadCopy() */
+
+
+/******************************************************************************
+** Function: DumpBinFile
+**
+** Notes:
+**  1. SourceCrc is NULL if the table isn't a cache of a source file.
+**  2. Errors are reported with EventType.
+*/
+static bool DumpBinFile(const char* Filename, uint32 SchemaId, uint32 SchemaVer, const uint32* SourceCrc,
+                        const void* TblData, size_t TblDataLen, uint16 EventType)
+{
+
+   bool             RetStatus = false;
+   osal_id_t        FileHandle;
+   int32            SysStatus;
+   int32            WriteStatus;
+   uint8            HdrBuf[TBLMGR_BIN_HDR_LEN];
+   TBLMGR_BinHdr_t  BinHdr;
+   os_err_name_t    OsErrStr;
+   
+   BinHdr.Magic     = TBLMGR_BIN_MAGIC;
+   BinHdr.FormatVer = TBLMGR_BIN_FORMAT_VER;
+   BinHdr.Flags     = BinHostFlags();
+   BinHdr.SchemaId  = SchemaId;
+   BinHdr.SchemaVer = SchemaVer;
+   BinHdr.DataLen   = (uint32)TblDataLen;
+   BinHdr.Crc       = CRC_32c(0, (const uint8*)TblData, TblDataLen);
+   BinHdr.SourceCrc = 0;
+   
+   if (SourceCrc != NULL)
+   {
+      BinHdr.Flags    |= TBLMGR_BIN_FLAG_SOURCE_CRC;
+      BinHdr.SourceCrc = *SourceCrc;
+   }
+   BinHdrEncode(HdrBuf, &BinHdr);
+   
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+   
+   if (SysStatus == OS_SUCCESS)
+   {
+   
+      WriteStatus = OS_write(FileHandle, HdrBuf, sizeof(HdrBuf));
+      if (WriteStatus == sizeof(HdrBuf))
+      {
+         WriteStatus = OS_write(FileHandle, TblData, TblDataLen);
+      }
+      
+      if (WriteStatus == (int32)TblDataLen)
+      {
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(TBLMGR_BIN_TBL_ERR_EID, EventType,
+                           "Binary table dump error writing file %s. Status = %d",
+                           Filename, WriteStatus);
+      }
+      
+      OS_close(FileHandle);
+      
+   } /* End if file created */
+   else
+   {
+      OS_GetErrorName(SysStatus, &OsErrStr);
+      CFE_EVS_SendEvent(TBLMGR_BIN_TBL_ERR_EID, EventType,
+                        "Binary table dump error creating file %s. Status = %s",
+                        Filename, OsErrStr);
+   }
+   
+   return RetStatus;
+   
+} /* End DumpBinFile() */
+
+
 /******************************************************************************
 ** Function: DumpTblStub 
 **
@@ -348,6 +775,171 @@ static bool DumpTblStub(TBLMGR_Tbl_t* Tbl, uint8 DumpType, const char* Filename)
 } /* End DumpTblStub() */
 
 
+/******************************************************************************
+** Function: FileCrc
+**
+** Notes:
+**  1. Computes the CRC_32c() of Filename's contents. Returns false if the
+**     file can't be read.
+*/
+static bool FileCrc(const char* Filename, uint32* Crc)
+{
+
+   bool       RetStatus = false;
+   osal_id_t  FileHandle;
+   int32      ReadStatus;
+   uint8      Buf[TBLMGR_FILE_CRC_BUF_LEN];
+   
+   *Crc = 0;
+   
+   if (OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY) == OS_SUCCESS)
+   {
+   
+      do
+      {
+         ReadStatus = OS_read(FileHandle, Buf, sizeof(Buf));
+         if (ReadStatus > 0)
+         {
+            *Crc = CRC_32c(*Crc, Buf, ReadStatus);
+         }
+      } while (ReadStatus > 0);
+      
+      RetStatus = (ReadStatus == 0);
+      OS_close(FileHandle);
+      
+   }
+   
+   return RetStatus;
+   
+} /* End FileCrc() */
+
+
+/******************************************************************************
+** Function: LoadBinFile
+**
+** Notes:
+**  1. If SourceCrc isn't NULL the file must be a cache of a source file
+**     with the same CRC.
+**  2. Errors are reported with EventType.
+*/
+static bool LoadBinFile(const char* Filename, uint32 SchemaId, uint32 SchemaVer, const uint32* SourceCrc,
+                        void* TblData, size_t TblDataLen, uint16 EventType)
+{
+
+   bool             RetStatus = false;
+   osal_id_t        FileHandle;
+   int32            SysStatus;
+   int32            ReadStatus;
+   uint8            ExtraByte;
+   uint32           Crc;
+   TBLMGR_BinHdr_t  BinHdr;
+   os_err_name_t    OsErrStr;
+   
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+   
+   if (SysStatus == OS_SUCCESS)
+   {
+   
+      if (!ReadBinHdr(FileHandle, &BinHdr))
+      {
+         CFE_EVS_SendEvent(TBLMGR_BIN_TBL_ERR_EID, EventType,
+                           "Binary table load error. %s is not a version %d or %d binary table file",
+                           Filename, TBLMGR_BIN_V1_FORMAT_VER, TBLMGR_BIN_FORMAT_VER);
+      }
+      else if ((BinHdr.Flags & TBLMGR_BIN_FLAG_LITTLE_ENDIAN) != BinHostFlags())
+      {
+         CFE_EVS_SendEvent(TBLMGR_BIN_TBL_ERR_EID, EventType,
+                           "Binary table load error. %s flags 0x%04X don't match the processor's 0x%04X",
+                           Filename, BinHdr.Flags, BinHostFlags());
+      }
+      else if (SourceCrc != NULL && 
+               (!(BinHdr.Flags & TBLMGR_BIN_FLAG_SOURCE_CRC) || BinHdr.SourceCrc != *SourceCrc))
+      {
+         CFE_EVS_SendEvent(TBLMGR_BIN_TBL_ERR_EID, EventType,
+                           "Binary table load error. %s was not created from a source file with CRC 0x%08X",
+                           Filename, (unsigned int)*SourceCrc);
+      }
+      else if (BinHdr.SchemaId != SchemaId || BinHdr.SchemaVer != SchemaVer)
+      {
+         CFE_EVS_SendEvent(TBLMGR_BIN_TBL_ERR_EID, EventType,
+                           "Binary table load error. %s schema %u version %u, expected schema %u version %u",
+                           Filename, (unsigned int)BinHdr.SchemaId, (unsigned int)BinHdr.SchemaVer,
+                           (unsigned int)SchemaId, (unsigned int)SchemaVer);
+      }
+      else if (BinHdr.DataLen != TblDataLen)
+      {
+         CFE_EVS_SendEvent(TBLMGR_BIN_TBL_ERR_EID, EventType,
+                           "Binary table load error. %s data length %u, expected %u",
+                           Filename, (unsigned int)BinHdr.DataLen, (unsigned int)TblDataLen);
+      }
+      else
+      {
+         
+         ReadStatus = OS_read(FileHandle, TblData, TblDataLen);
+         
+         if (ReadStatus == (int32)TblDataLen && OS_read(FileHandle, &ExtraByte, 1) == 0)
+         {
+            
+            Crc = CRC_32c(0, (const uint8*)TblData, TblDataLen);
+            if (Crc == BinHdr.Crc)
+            {
+               RetStatus = true;
+            }
+            else
+            {
+               CFE_EVS_SendEvent(TBLMGR_BIN_TBL_ERR_EID, EventType,
+                                 "Binary table load error. %s CRC 0x%08X doesn't match its header's 0x%08X",
+                                 Filename, (unsigned int)Crc, (unsigned int)BinHdr.Crc);
+            }
+         }
+         else
+         {
+            CFE_EVS_SendEvent(TBLMGR_BIN_TBL_ERR_EID, EventType,
+                              "Binary table load error. %s file length doesn't match its header's data length %u",
+                              Filename, (unsigned int)BinHdr.DataLen);
+         }
+      
+      } /* End if valid header */
+      
+      OS_close(FileHandle);
+   
+   } /* End if file opened */
+   else
+   {
+      OS_GetErrorName(SysStatus, &OsErrStr);
+      CFE_EVS_SendEvent(TBLMGR_BIN_TBL_ERR_EID, EventType,
+                        "Binary table load error opening file %s. Status = %s",
+                        Filename, OsErrStr);
+   }
+   
+   return RetStatus;
+   
+} /* End LoadBinFile() */
+
+
+/******************************************************************************
+** Function: LoadDefTbl
+**
+** Notes:
+**  1. Loads a newly registered table's default table using the load table
+**     command function.
+*/
+static void LoadDefTbl(TBLMGR_Class_t* TblMgr, uint8 TblId, const char* TblFilename)
+{
+
+   TBLMGR_LoadTblCmdMsg_t LoadTblCmd;
+
+   strncpy (TblMgr->Tbl[TblId].Filename,TblFilename,OS_MAX_PATH_LEN);
+   TblMgr->Tbl[TblId].Filename[OS_MAX_PATH_LEN-1] = '\0';
+   
+   LoadTblCmd.Payload.Id = TblId;
+   LoadTblCmd.Payload.Type = TBLMGR_LOAD_TBL_REPLACE;
+   strncpy (LoadTblCmd.Payload.Filename,TblFilename,OS_MAX_PATH_LEN);
+   TBLMGR_LoadTblCmd(TblMgr, (CFE_MSG_Message_t *)&LoadTblCmd);
+
+} /* End LoadDefTbl() */
+
+
 /******************************************************************************
 ** Function: LoadTblStub 
 **
@@ -366,4 +958,94 @@ static bool LoadTblStub(TBLMGR_Tbl_t* Tbl, uint8 LoadType, const char* Filename)
 } /* End LoadTblStub() */
 
 
+/******************************************************************************
+** Function: PrepareLoadCopy
+**
+** Notes:
+**  1. Returns true if a double buffered table's load copy isn't held by a
+**     reader. The load copy is then initialized with the active copy so 
+**     update loads and load functions that don't define every table entry
+**     start from the current table.
+**  2. Readers only acquire the active copy so a reader that isn't holding
+**     the load copy now can't hold it until after the next commit.
+**  3. Always returns true for tables that aren't double buffered.
+*/
+static bool PrepareLoadCopy(TBLMGR_Tbl_t* Tbl)
+{
+
+   bool   RetStatus = true;
+   uint8  i;
+   
+   if (Tbl->DblBuf)
+   {
+      
+      for (i=0; i < Tbl->ReaderCnt; i++)
+      {
+         if (Tbl->ReaderCopy[i] == Tbl->LoadCopy)
+         {
+            RetStatus = false;
+         }
+      }
+      
+      if (RetStatus)
+      {
+         memcpy(Tbl->Copy[Tbl->LoadCopy], Tbl->Copy[Tbl->ActiveCopy], Tbl->DataLen);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(TBLMGR_DBL_BUF_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Table %d load rejected. A reader still holds the previously active table copy",
+                           Tbl->Id);
+      }
+      
+   } /* End if double buffered */
+   
+   return RetStatus;
+
+} /* End PrepareLoadCopy() */
+
 
+/******************************************************************************
+** Function: ReadBinHdr
+**
+** Notes:
+**  1. Reads and decodes the header of a binary table file opened for 
+**     reading. Returns false if it isn't a version 1 or current binary
+**     table header.
+**  2. A version 1 header ends before SourceCrc so SourceCrc is zero and
+**     TBLMGR_BIN_FLAG_SOURCE_CRC is cleared.
+*/
+static bool ReadBinHdr(osal_id_t FileHandle, TBLMGR_BinHdr_t* BinHdr)
+{
+
+   bool   RetStatus = false;
+   uint8  HdrBuf[TBLMGR_BIN_HDR_LEN] = {0};
+   
+   if (OS_read(FileHandle, HdrBuf, TBLMGR_BIN_V1_HDR_LEN) == TBLMGR_BIN_V1_HDR_LEN)
+   {
+      
+      BinHdrDecode(BinHdr, HdrBuf);
+      
+      if (BinHdr->Magic == TBLMGR_BIN_MAGIC)
+      {
+         if (BinHdr->FormatVer == TBLMGR_BIN_FORMAT_VER)
+         {
+            if (OS_read(FileHandle, &HdrBuf[TBLMGR_BIN_V1_HDR_LEN], TBLMGR_BIN_HDR_LEN-TBLMGR_BIN_V1_HDR_LEN) ==
+                (TBLMGR_BIN_HDR_LEN-TBLMGR_BIN_V1_HDR_LEN))
+            {
+               BinHdrDecode(BinHdr, HdrBuf);
+               RetStatus = true;
+            }
+         }
+         else if (BinHdr->FormatVer == TBLMGR_BIN_V1_FORMAT_VER)
+         {
+            BinHdr->Flags &= (uint16)~TBLMGR_BIN_FLAG_SOURCE_CRC;
+            BinHdr->SourceCrc = 0;
+            RetStatus = true;
+         }
+      }
+   }
+   
+   return RetStatus;
+   
+} /* End ReadBinHdr() */
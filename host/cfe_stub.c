@@ -0,0 +1,384 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Host implementation of the cFE and OSAL functions declared by inc/cfe.h
+**
+**  Notes:
+**    1. See cfe_stub.h.
+**
+*/
+
+#define _POSIX_C_SOURCE 200112L
+
+/*
+** Include Files:
+*/
+
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "cfe_stub.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static uint32    EventCnt    = 0;
+static uint32    ErrEventCnt = 0;
+static osal_id_t NextSemId   = 1;
+
+
+/******************************************************************************
+** Function: CfeStub_GetErrEventCnt
+**
+*/
+uint32 CfeStub_GetErrEventCnt(void)
+{
+
+   return ErrEventCnt;
+
+} /* End CfeStub_GetErrEventCnt() */
+
+
+/******************************************************************************
+** Function: CfeStub_GetEventCnt
+**
+*/
+uint32 CfeStub_GetEventCnt(void)
+{
+
+   return EventCnt;
+
+} /* End CfeStub_GetEventCnt() */
+
+
+/******************************************************************************
+** Function: CFE_ES_GetTaskID
+**
+*/
+int32 CFE_ES_GetTaskID(CFE_ES_TaskId_t *TaskId)
+{
+
+   *TaskId = 0;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_ES_GetTaskID() */
+
+
+/******************************************************************************
+** Function: CFE_ES_PerfLogEntry
+**
+*/
+int32 CFE_ES_PerfLogEntry(uint32 Marker)
+{
+
+   (void)Marker;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_ES_PerfLogEntry() */
+
+
+/******************************************************************************
+** Function: CFE_ES_PerfLogExit
+**
+*/
+int32 CFE_ES_PerfLogExit(uint32 Marker)
+{
+
+   (void)Marker;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_ES_PerfLogExit() */
+
+
+/******************************************************************************
+** Function: CFE_ES_TaskID_ToIndex
+**
+*/
+int32 CFE_ES_TaskID_ToIndex(CFE_ES_TaskId_t TaskId, uint32 *Idx)
+{
+
+   *Idx = TaskId;
+
+   return CFE_SUCCESS;
+
+} /* End CFE_ES_TaskID_ToIndex() */
+
+
+/******************************************************************************
+** Function: CFE_EVS_SendEvent
+**
+*/
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+{
+
+   va_list Args;
+
+   EventCnt++;
+   
+   if (EventType >= CFE_EVS_EventType_ERROR)
+   {
+      ErrEventCnt++;
+      va_start(Args, Spec);
+      fprintf(stderr, "EVS %u/%u: ", EventID, EventType);
+      vfprintf(stderr, Spec, Args);
+      fprintf(stderr, "\n");
+      va_end(Args);
+   }
+
+   return CFE_SUCCESS;
+
+} /* End CFE_EVS_SendEvent() */
+
+
+/******************************************************************************
+** Function: CFE_PSP_MemSet
+**
+*/
+int32 CFE_PSP_MemSet(void *Dest, uint8 Value, uint32 Size)
+{
+
+   memset(Dest, Value, Size);
+
+   return CFE_SUCCESS;
+
+} /* End CFE_PSP_MemSet() */
+
+
+/******************************************************************************
+** Function: OS_BinSemCreate
+**
+*/
+int32 OS_BinSemCreate(osal_id_t *SemId, const char *SemName, uint32 SemInitialValue, uint32 Options)
+{
+
+   (void)SemName;
+   (void)SemInitialValue;
+   (void)Options;
+
+   *SemId = NextSemId++;
+
+   return OS_SUCCESS;
+
+} /* End OS_BinSemCreate() */
+
+
+/******************************************************************************
+** Function: OS_BinSemFlush
+**
+*/
+int32 OS_BinSemFlush(osal_id_t SemId)
+{
+
+   (void)SemId;
+
+   return OS_SUCCESS;
+
+} /* End OS_BinSemFlush() */
+
+
+/******************************************************************************
+** Function: OS_BinSemTimedWait
+**
+*/
+int32 OS_BinSemTimedWait(osal_id_t SemId, uint32 Msecs)
+{
+
+   (void)SemId;
+   (void)Msecs;
+
+   return OS_SEM_TIMEOUT;
+
+} /* End OS_BinSemTimedWait() */
+
+
+/******************************************************************************
+** Function: OS_close
+**
+*/
+int32 OS_close(osal_id_t FileDes)
+{
+
+   return (close((int)FileDes) == 0) ? OS_SUCCESS : OS_ERROR;
+
+} /* End OS_close() */
+
+
+/******************************************************************************
+** Function: OS_GetErrorName
+**
+*/
+int32 OS_GetErrorName(int32 ErrorNum, os_err_name_t *ErrName)
+{
+
+   snprintf(*ErrName, sizeof(*ErrName), "OS_ERROR(%d)", ErrorNum);
+
+   return OS_SUCCESS;
+
+} /* End OS_GetErrorName() */
+
+
+/******************************************************************************
+** Function: OS_MutSemCreate
+**
+*/
+int32 OS_MutSemCreate(osal_id_t *SemId, const char *SemName, uint32 Options)
+{
+
+   (void)SemName;
+   (void)Options;
+
+   *SemId = NextSemId++;
+
+   return OS_SUCCESS;
+
+} /* End OS_MutSemCreate() */
+
+
+/******************************************************************************
+** Function: OS_MutSemGive
+**
+*/
+int32 OS_MutSemGive(osal_id_t SemId)
+{
+
+   (void)SemId;
+
+   return OS_SUCCESS;
+
+} /* End OS_MutSemGive() */
+
+
+/******************************************************************************
+** Function: OS_MutSemTake
+**
+*/
+int32 OS_MutSemTake(osal_id_t SemId)
+{
+
+   (void)SemId;
+
+   return OS_SUCCESS;
+
+} /* End OS_MutSemTake() */
+
+
+/******************************************************************************
+** Function: OS_OpenCreate
+**
+*/
+int32 OS_OpenCreate(osal_id_t *FileDes, const char *Path, int32 Flags, int32 Access)
+{
+
+   int32 RetStatus = OS_ERROR;
+   int   PosixFlags;
+   int   Fd;
+
+   if (Access == OS_READ_ONLY)
+   {
+      PosixFlags = O_RDONLY;
+   }
+   else
+   {
+      PosixFlags = (Access == OS_WRITE_ONLY) ? O_WRONLY : O_RDWR;
+   }
+
+   if (Flags & OS_FILE_FLAG_CREATE)   PosixFlags |= O_CREAT;
+   if (Flags & OS_FILE_FLAG_TRUNCATE) PosixFlags |= O_TRUNC;
+
+   Fd = open(Path, PosixFlags, 0644);
+   if (Fd >= 0)
+   {
+      *FileDes  = (osal_id_t)Fd;
+      RetStatus = OS_SUCCESS;
+   }
+
+   return RetStatus;
+
+} /* End OS_OpenCreate() */
+
+
+/******************************************************************************
+** Function: OS_printf
+**
+*/
+void OS_printf(const char *Spec, ...)
+{
+
+   va_list Args;
+
+   va_start(Args, Spec);
+   vfprintf(stderr, Spec, Args);
+   va_end(Args);
+
+} /* End OS_printf() */
+
+
+/******************************************************************************
+** Function: OS_read
+**
+*/
+int32 OS_read(osal_id_t FileDes, void *Buffer, size_t Nbytes)
+{
+
+   ssize_t ReadLen = read((int)FileDes, Buffer, Nbytes);
+
+   return (ReadLen < 0) ? OS_ERROR : (int32)ReadLen;
+
+} /* End OS_read() */
+
+
+/******************************************************************************
+** Function: OS_stat
+**
+*/
+int32 OS_stat(const char *Path, os_fstat_t *FileStats)
+{
+
+   int32 RetStatus = OS_ERROR;
+   struct stat PosixStat;
+
+   if (stat(Path, &PosixStat) == 0)
+   {
+      FileStats->FileModeBits = (uint32)PosixStat.st_mode;
+      FileStats->FileTime     = (int32)PosixStat.st_mtime;
+      FileStats->FileSize     = (size_t)PosixStat.st_size;
+      RetStatus = OS_SUCCESS;
+   }
+
+   return RetStatus;
+
+} /* End OS_stat() */
+
+
+/******************************************************************************
+** Function: OS_write
+**
+*/
+int32 OS_write(osal_id_t FileDes, const void *Buffer, size_t Nbytes)
+{
+
+   ssize_t WriteLen = write((int)FileDes, Buffer, Nbytes);
+
+   return (WriteLen < 0) ? OS_ERROR : (int32)WriteLen;
+
+} /* End OS_write() */
@@ -0,0 +1,62 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Host implementation of the cFE and OSAL functions declared by inc/cfe.h
+**
+**  Notes:
+**    1. Files are accessed with POSIX calls. Semaphores always succeed and
+**       a binary semaphore wait always times out because host programs 
+**       using the stand-ins are single threaded.
+**    2. Performance log markers are ignored and every caller is task 0.
+**    3. Error and critical events are written to stderr and counted so a
+**       host program can fail when the code under test reports an error.
+**
+*/
+
+#ifndef _cfe_stub_
+#define _cfe_stub_
+
+/*
+** Include Files
+*/
+
+#include "cfe.h"
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+/******************************************************************************
+** Function: CfeStub_GetErrEventCnt
+**
+** Notes:
+**    1. Returns the number of error and critical events sent.
+**
+*/
+uint32 CfeStub_GetErrEventCnt(void);
+
+
+/******************************************************************************
+** Function: CfeStub_GetEventCnt
+**
+** Notes:
+**    1. Returns the number of events of every type sent.
+**
+*/
+uint32 CfeStub_GetEventCnt(void);
+
+
+#endif /* _cfe_stub_ */
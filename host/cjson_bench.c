@@ -0,0 +1,640 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Measure the throughput of the JSON parsing paths used to load tables
+**
+**  Notes:
+**    1. Usage: cjson_bench [--quick] [ini_file.json ...]
+**       Synthetic INITBL style documents that vary in size, nesting depth,
+**       key count and string/number mix are always measured. Each file
+**       argument is an INITBL JSON file that is replayed the same way.
+**    2. JSON_Validate, JSON_SearchConst, JSON_Iterate and
+**       CJSON_LoadObjArray are measured for each document. The searches
+**       and loads use "config.<key>" queries for up to BENCH_MAX_QUERIES
+**       scalar and number array parameters, spread evenly over the
+**       document's config object.
+**    3. One JSON object is written per line for each document and function
+**       so runs can be compared by scripts. A query is one call of
+**       JSON_Validate, one config member for JSON_Iterate and one
+**       parameter for the search and load. mb_per_s is the rate the
+**       document's characters are processed, each search query is a pass
+**       over the document. stack is the function's peak stack use in bytes.
+**    4. --quick runs each function for about 1ms instead of 200ms. It is
+**       used by ctest to check every function succeeds for every
+**       document. Returns 0 if no function failed and no error event was
+**       sent.
+**
+*/
+
+#define _POSIX_C_SOURCE 200112L
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "cjson.h"
+#include "cfe_stub.h"
+#include "stack_probe.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_DOC_MAX_LEN   (512*1024)
+#define BENCH_MAX_QUERIES   CJSON_MAX_STAGED_OBJ
+#define BENCH_CONFIG_KEY    "config"
+
+#define BENCH_QUICK_NS      (1000000ULL)     /* Time each function runs for with --quick */
+#define BENCH_FULL_NS       (200000000ULL)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   BENCH_VALIDATE = 0,
+   BENCH_SEARCH,
+   BENCH_ITERATE,
+   BENCH_LOAD_OBJ_ARRAY,
+   BENCH_FUNC_CNT
+
+} BenchFunc_t;
+
+typedef struct
+{
+
+   const char  *Name;
+   unsigned    KeyCnt;
+   unsigned    Depth;     /* Document nesting depth, at least 2 for the root and config objects */
+   unsigned    StrPct;    /* Percentage of config parameters that are strings */
+
+} SynthDoc_t;
+
+/*
+** Storage for a loaded parameter, sized for the largest INITBL value
+*/
+typedef union
+{
+
+   double  Num;
+   bool    Bool;
+   char    Str[INITBL_MAX_CFG_STR_LEN];
+   double  Array[INITBL_MAX_CFG_ARRAY_LEN];
+
+} Param_t;
+
+typedef struct
+{
+
+   char         Name[OS_MAX_PATH_LEN*2];
+   char         *Buf;
+   size_t       Len;
+   unsigned     Depth;
+   unsigned     KeyCnt;     /* Config object members */
+   unsigned     StrCnt;     /* Config object string members */
+   const char   *Config;    /* Config object, iterated by JSON_Iterate() */
+   size_t       ConfigLen;
+   size_t       QueryCnt;
+   char         Query[BENCH_MAX_QUERIES][CJSON_MAX_KEY_LEN+1];
+   CJSON_Obj_t  Obj[BENCH_MAX_QUERIES];
+   Param_t      Param[BENCH_MAX_QUERIES];
+
+} Doc_t;
+
+typedef struct
+{
+
+   const Doc_t  *Doc;
+   BenchFunc_t  Func;
+   size_t       QueryCnt;   /* Queries completed by the last run, 0 if it failed */
+
+} Run_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void Bench(const Doc_t* Doc, uint64_t MinNs);
+static void DepthVisitor(void* Context, const char* Buf, const JSONVisit_t* Visit);
+static size_t ExpectedQueryCnt(const Doc_t* Doc, BenchFunc_t Func);
+static bool LoadDoc(Doc_t* Doc);
+static void MakeSynthDoc(Doc_t* Doc, const SynthDoc_t* Synth);
+static uint64_t NowNs(void);
+static bool ReadDoc(Doc_t* Doc, const char* Filename);
+static void RunFunc(Run_t* Run);
+static void RunProbe(void* Context);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const char *FuncName[BENCH_FUNC_CNT] =
+{
+   "JSON_Validate",
+   "JSON_SearchConst",
+   "JSON_Iterate",
+   "CJSON_LoadObjArray"
+};
+
+static const SynthDoc_t SynthDoc[] =
+{
+   { "small",     16,  3,  25 },
+   { "medium",   256,  8,  50 },
+   { "large",   4096, 16,  25 },
+   { "deep",      64, JSON_MAX_DEPTH, 0 },
+   { "strings", 1024,  4, 100 }
+};
+
+static char     DocBuf[BENCH_DOC_MAX_LEN];
+static Doc_t    Doc;
+static unsigned FailCnt = 0;
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char *argv[])
+{
+
+   int      i;
+   size_t   s;
+   uint64_t MinNs = BENCH_FULL_NS;
+
+   CJSON_LibInit();
+
+   for (i=1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "--quick") == 0)
+      {
+         MinNs = BENCH_QUICK_NS;
+      }
+   }
+
+   for (s=0; s < (sizeof(SynthDoc)/sizeof(SynthDoc[0])); s++)
+   {
+      MakeSynthDoc(&Doc, &SynthDoc[s]);
+      if (LoadDoc(&Doc))
+      {
+         Bench(&Doc, MinNs);
+      }
+   }
+
+   for (i=1; i < argc; i++)
+   {
+      if (strcmp(argv[i], "--quick") != 0)
+      {
+         if (ReadDoc(&Doc, argv[i]) && LoadDoc(&Doc))
+         {
+            Bench(&Doc, MinNs);
+         }
+      }
+   }
+
+   if (CfeStub_GetErrEventCnt() > 0)
+   {
+      FailCnt++;
+      fprintf(stderr, "cjson_bench: %u error events were sent\n", CfeStub_GetErrEventCnt());
+   }
+
+   return (FailCnt == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: Bench
+**
+** Notes:
+**    1. Each function is run once to warm up, once more to check it and
+**       measure its stack, then in batches that double in size until MinNs
+**       has elapsed.
+**
+*/
+static void Bench(const Doc_t* Doc, uint64_t MinNs)
+{
+
+   BenchFunc_t Func;
+   Run_t       Run;
+   size_t      Stack;
+   uint64_t    Iter;
+   uint64_t    Batch;
+   uint64_t    i;
+   uint64_t    Queries;
+   uint64_t    StartNs;
+   uint64_t    ElapsedNs;
+
+   Run.Doc = Doc;
+
+   for (Func=BENCH_VALIDATE; Func < BENCH_FUNC_CNT; Func++)
+   {
+
+      Run.Func = Func;
+      RunFunc(&Run);
+      Stack = StackProbe_Run(RunProbe, &Run);
+
+      if (Run.QueryCnt != ExpectedQueryCnt(Doc, Func))
+      {
+         FailCnt++;
+         fprintf(stderr, "cjson_bench: %s completed %u of %u queries for %s\n", FuncName[Func],
+                 (unsigned)Run.QueryCnt, (unsigned)ExpectedQueryCnt(Doc, Func), Doc->Name);
+         continue;
+      }
+
+      Iter      = 0;
+      Queries   = 0;
+      Batch     = 1;
+      ElapsedNs = 0;
+      StartNs   = NowNs();
+      while (ElapsedNs < MinNs)
+      {
+         for (i=0; i < Batch; i++)
+         {
+            RunFunc(&Run);
+            Queries += Run.QueryCnt;
+         }
+         Iter += Batch;
+         Batch *= 2;
+         ElapsedNs = NowNs() - StartNs;
+      }
+
+      printf("{\"doc\":\"%s\",\"bytes\":%u,\"depth\":%u,\"keys\":%u,\"str_pct\":%u,"
+             "\"function\":\"%s\",\"iterations\":%llu,\"queries\":%llu,"
+             "\"mb_per_s\":%.1f,\"ns_per_query\":%.1f,\"stack\":%u}\n",
+             Doc->Name, (unsigned)Doc->Len, Doc->Depth, Doc->KeyCnt,
+             (Doc->KeyCnt > 0) ? (100*Doc->StrCnt)/Doc->KeyCnt : 0,
+             FuncName[Func], (unsigned long long)Iter, (unsigned long long)Queries,
+             ((double)Doc->Len*((Func == BENCH_SEARCH) ? Queries : Iter)*1000.0)/ElapsedNs, (double)ElapsedNs/Queries,
+             (unsigned)Stack);
+
+   } /* End function loop */
+
+   fflush(stdout);
+
+} /* End Bench() */
+
+
+/******************************************************************************
+** Function: DepthVisitor
+**
+*/
+static void DepthVisitor(void* Context, const char* Buf, const JSONVisit_t* Visit)
+{
+
+   Doc_t *Doc = (Doc_t*)Context;
+
+   (void)Buf;
+
+   if (Visit->depth > Doc->Depth)
+   {
+      Doc->Depth = Visit->depth;
+   }
+
+} /* End DepthVisitor() */
+
+
+/******************************************************************************
+** Function: ExpectedQueryCnt
+**
+*/
+static size_t ExpectedQueryCnt(const Doc_t* Doc, BenchFunc_t Func)
+{
+
+   size_t QueryCnt;
+
+   switch (Func)
+   {
+      case BENCH_VALIDATE:
+         QueryCnt = 1;
+         break;
+      case BENCH_ITERATE:
+         QueryCnt = Doc->KeyCnt;
+         break;
+      default:
+         QueryCnt = Doc->QueryCnt;
+         break;
+   }
+
+   return QueryCnt;
+
+} /* End ExpectedQueryCnt() */
+
+
+/******************************************************************************
+** Function: LoadDoc
+**
+** Notes:
+**    1. Validates the document, locates its config object and constructs
+**       a query and a CJSON object for each benchmarked parameter. Nested
+**       objects, nulls and arrays of non-numbers aren't INITBL parameters
+**       and aren't queried.
+**
+*/
+static bool LoadDoc(Doc_t* Doc)
+{
+
+   bool         RetStatus = false;
+   size_t       Start = 0;
+   size_t       Next  = 0;
+   size_t       Stride;
+   size_t       Member = 0;
+   JSONPair_t   Pair;
+   JSONTypes_t  ConfigType;
+
+   Doc->Depth    = 0;
+   Doc->KeyCnt   = 0;
+   Doc->StrCnt   = 0;
+   Doc->QueryCnt = 0;
+
+   if (JSON_ValidateVisit(Doc->Buf, Doc->Len, DepthVisitor, Doc) != JSONSuccess)
+   {
+      fprintf(stderr, "cjson_bench: %s isn't a valid JSON document\n", Doc->Name);
+   }
+   else if (JSON_SearchConst(Doc->Buf, Doc->Len, BENCH_CONFIG_KEY, strlen(BENCH_CONFIG_KEY),
+                             &Doc->Config, &Doc->ConfigLen, &ConfigType) != JSONSuccess ||
+            ConfigType != JSONObject)
+   {
+      fprintf(stderr, "cjson_bench: %s doesn't have a \"%s\" object\n", Doc->Name, BENCH_CONFIG_KEY);
+   }
+   else
+   {
+
+      while (JSON_Iterate(Doc->Config, Doc->ConfigLen, &Start, &Next, &Pair) == JSONSuccess)
+      {
+         Doc->KeyCnt++;
+         if (Pair.jsonType == JSONString)
+         {
+            Doc->StrCnt++;
+         }
+      }
+
+      /* Spread the queried parameters evenly over the config object */
+      Stride = (Doc->KeyCnt + BENCH_MAX_QUERIES - 1)/BENCH_MAX_QUERIES;
+      Start  = 0;
+      Next   = 0;
+      while (JSON_Iterate(Doc->Config, Doc->ConfigLen, &Start, &Next, &Pair) == JSONSuccess &&
+             Doc->QueryCnt < BENCH_MAX_QUERIES)
+      {
+
+         if ((Member++ % Stride) != 0 || Pair.keyLength > (CJSON_MAX_KEY_LEN - strlen(BENCH_CONFIG_KEY) - 1))
+         {
+            continue;
+         }
+
+         snprintf(Doc->Query[Doc->QueryCnt], sizeof(Doc->Query[0]), "%s.%.*s",
+                  BENCH_CONFIG_KEY, (int)Pair.keyLength, Pair.key);
+
+         switch (Pair.jsonType)
+         {
+            case JSONString:
+               CJSON_StrObjConstructor(&Doc->Obj[Doc->QueryCnt], Doc->Query[Doc->QueryCnt], CJSON_STR_COPY,
+                                       Doc->Param[Doc->QueryCnt].Str, sizeof(Doc->Param[0].Str));
+               Doc->QueryCnt++;
+               break;
+            case JSONNumber:
+               CJSON_NumObjConstructor(&Doc->Obj[Doc->QueryCnt], Doc->Query[Doc->QueryCnt], JSONNumDouble,
+                                       &Doc->Param[Doc->QueryCnt].Num, sizeof(Doc->Param[0].Num));
+               Doc->QueryCnt++;
+               break;
+            case JSONTrue:
+            case JSONFalse:
+               CJSON_BoolObjConstructor(&Doc->Obj[Doc->QueryCnt], Doc->Query[Doc->QueryCnt],
+                                        &Doc->Param[Doc->QueryCnt].Bool, sizeof(Doc->Param[0].Bool));
+               Doc->QueryCnt++;
+               break;
+            case JSONArray:
+               if (Pair.valueLength > 2 && memchr(Pair.value, '"', Pair.valueLength) == NULL &&
+                   memchr(Pair.value, '{', Pair.valueLength) == NULL)
+               {
+                  CJSON_ArrayObjConstructor(&Doc->Obj[Doc->QueryCnt], Doc->Query[Doc->QueryCnt], JSONNumDouble,
+                                            Doc->Param[Doc->QueryCnt].Array, sizeof(Doc->Param[0].Array));
+                  Doc->QueryCnt++;
+               }
+               break;
+            default:
+               break;
+         }
+
+      } /* End config member loop */
+
+      RetStatus = true;
+
+   } /* End if valid */
+
+   if (!RetStatus)
+   {
+      FailCnt++;
+   }
+
+   return RetStatus;
+
+} /* End LoadDoc() */
+
+
+/******************************************************************************
+** Function: MakeSynthDoc
+**
+** Notes:
+**    1. Creates an INITBL style document whose config object holds
+**       KeyCnt parameters. StrPct percent of them, spread evenly, are
+**       strings and a third of the rest are floats, the others integers. When
+**       Depth is more than 2 the config object also holds a "nest" member
+**       that nests objects down to Depth levels, which searches skip.
+**
+*/
+static void MakeSynthDoc(Doc_t* Doc, const SynthDoc_t* Synth)
+{
+
+   unsigned  i;
+   size_t    Len = 0;
+
+   snprintf(Doc->Name, sizeof(Doc->Name), "synthetic/%s", Synth->Name);
+
+   Len += snprintf(&DocBuf[Len], BENCH_DOC_MAX_LEN-Len, "{\n   \"title\": \"Synthetic %s\",\n   \"%s\": {\n",
+                   Synth->Name, BENCH_CONFIG_KEY);
+
+   if (Synth->Depth > 2)
+   {
+      Len += snprintf(&DocBuf[Len], BENCH_DOC_MAX_LEN-Len, "      \"nest\": ");
+      for (i=2; i < Synth->Depth; i++)
+      {
+         Len += snprintf(&DocBuf[Len], BENCH_DOC_MAX_LEN-Len, "{\"n%u\": ", i);
+      }
+      Len += snprintf(&DocBuf[Len], BENCH_DOC_MAX_LEN-Len, "1");
+      for (i=2; i < Synth->Depth; i++)
+      {
+         DocBuf[Len++] = '}';
+      }
+      Len += snprintf(&DocBuf[Len], BENCH_DOC_MAX_LEN-Len, ",\n");
+   }
+
+   for (i=0; i < Synth->KeyCnt; i++)
+   {
+      Len += snprintf(&DocBuf[Len], BENCH_DOC_MAX_LEN-Len, "      \"PARAM_%04u\": ", i);
+      if (((i*Synth->StrPct) % 100) + Synth->StrPct >= 100)
+      {
+         Len += snprintf(&DocBuf[Len], BENCH_DOC_MAX_LEN-Len, "\"/cf/app_%04u_tbl.json\"", i);
+      }
+      else if ((i % 3) == 1)
+      {
+         Len += snprintf(&DocBuf[Len], BENCH_DOC_MAX_LEN-Len, "%.3f", i*1.125 - 500.0);
+      }
+      else
+      {
+         Len += snprintf(&DocBuf[Len], BENCH_DOC_MAX_LEN-Len, "%u", i*7919);
+      }
+      Len += snprintf(&DocBuf[Len], BENCH_DOC_MAX_LEN-Len, (i+1 < Synth->KeyCnt) ? ",\n" : "\n");
+   }
+
+   Len += snprintf(&DocBuf[Len], BENCH_DOC_MAX_LEN-Len, "   }\n}\n");
+
+   Doc->Buf = DocBuf;
+   Doc->Len = Len;
+
+} /* End MakeSynthDoc() */
+
+
+/******************************************************************************
+** Function: NowNs
+**
+*/
+static uint64_t NowNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return (uint64_t)Now.tv_sec*1000000000ULL + (uint64_t)Now.tv_nsec;
+
+} /* End NowNs() */
+
+
+/******************************************************************************
+** Function: ReadDoc
+**
+*/
+static bool ReadDoc(Doc_t* Doc, const char* Filename)
+{
+
+   bool  RetStatus = false;
+   FILE  *File;
+
+   snprintf(Doc->Name, sizeof(Doc->Name), "%s", Filename);
+
+   File = fopen(Filename, "rb");
+   if (File == NULL)
+   {
+      fprintf(stderr, "cjson_bench: Couldn't open %s\n", Filename);
+   }
+   else
+   {
+      Doc->Buf = DocBuf;
+      Doc->Len = fread(DocBuf, 1, BENCH_DOC_MAX_LEN, File);
+      if (Doc->Len == BENCH_DOC_MAX_LEN)
+      {
+         fprintf(stderr, "cjson_bench: %s is longer than %d characters\n", Filename, BENCH_DOC_MAX_LEN);
+      }
+      else
+      {
+         RetStatus = true;
+      }
+      fclose(File);
+   }
+
+   if (!RetStatus)
+   {
+      FailCnt++;
+   }
+
+   return RetStatus;
+
+} /* End ReadDoc() */
+
+
+/******************************************************************************
+** Function: RunFunc
+**
+*/
+static void RunFunc(Run_t* Run)
+{
+
+   const Doc_t  *Doc = Run->Doc;
+   size_t       i;
+   size_t       Start = 0;
+   size_t       Next  = 0;
+   JSONPair_t   Pair;
+   const char   *Value;
+   size_t       ValueLen;
+   JSONTypes_t  ValueType;
+
+   Run->QueryCnt = 0;
+
+   switch (Run->Func)
+   {
+      case BENCH_VALIDATE:
+         if (JSON_Validate(Doc->Buf, Doc->Len) == JSONSuccess)
+         {
+            Run->QueryCnt = 1;
+         }
+         break;
+
+      case BENCH_SEARCH:
+         for (i=0; i < Doc->QueryCnt; i++)
+         {
+            if (JSON_SearchConst(Doc->Buf, Doc->Len, Doc->Query[i], strlen(Doc->Query[i]),
+                                 &Value, &ValueLen, &ValueType) == JSONSuccess)
+            {
+               Run->QueryCnt++;
+            }
+         }
+         break;
+
+      case BENCH_ITERATE:
+         while (JSON_Iterate(Doc->Config, Doc->ConfigLen, &Start, &Next, &Pair) == JSONSuccess)
+         {
+            Run->QueryCnt++;
+         }
+         break;
+
+      default:
+         /* The objects are only written by the load so the const document can be shared */
+         Run->QueryCnt = CJSON_LoadObjArray((CJSON_Obj_t*)Doc->Obj, Doc->QueryCnt, Doc->Buf, Doc->Len);
+         break;
+   }
+
+} /* End RunFunc() */
+
+
+/******************************************************************************
+** Function: RunProbe
+**
+*/
+static void RunProbe(void* Context)
+{
+
+   RunFunc((Run_t*)Context);
+
+} /* End RunProbe() */
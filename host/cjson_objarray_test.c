@@ -0,0 +1,187 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Test CJSON_LoadObjArray() against one CJSON_LoadObj() per object
+**
+**  Notes:
+**    1. The objects span more than one CJSON_MAX_STAGED_OBJ traversal and
+**       include nested and indexed keys, keys that aren't in the document,
+**       keys that are prefixes of other keys, a duplicate key and a value
+**       of the wrong type.
+**    2. Each object must be loaded with the same value and Updated flag and
+**       the same number of events must be sent.
+**    3. Returns 0 if every check passed.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cjson.h"
+#include "cfe_stub.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define KEY_CNT     100
+#define ENTRY_CNT   20
+#define OBJ_MAX     (KEY_CNT+ENTRY_CNT+16)
+#define DOC_MAX_LEN 8192
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void AddObj(const char* QueryKey);
+static size_t MakeDoc(char* Doc);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static CJSON_Obj_t ArrayObj[OBJ_MAX];
+static CJSON_Obj_t SingleObj[OBJ_MAX];
+static uint32 ArrayValue[OBJ_MAX];
+static uint32 SingleValue[OBJ_MAX];
+static size_t ObjCnt = 0;
+static unsigned FailCnt = 0;
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(void)
+{
+
+   static const char* MissKey[] =
+   {
+      "config.k100", "config.k1x", "config.k", "tbl.entry[20].mid",
+      "tbl.entry.mid", "none.x", "tbl.entry[3]", "bad", "dup"
+   };
+   char   Doc[DOC_MAX_LEN];
+   char   QueryKey[CJSON_MAX_KEY_LEN];
+   size_t DocLen, i;
+   size_t ArrayCnt, SingleCnt = 0;
+   uint32 ArrayEventCnt, SingleEventCnt;
+
+   CJSON_LibInit();
+
+   DocLen = MakeDoc(Doc);
+
+   for (i=0; i < KEY_CNT; i++)
+   {
+      sprintf(QueryKey, "config.k%u", (unsigned)((i*37) % KEY_CNT));
+      AddObj(QueryKey);
+   }
+   for (i=0; i < ENTRY_CNT; i++)
+   {
+      sprintf(QueryKey, "tbl.entry[%u].mid", (unsigned)(ENTRY_CNT-1-i));
+      AddObj(QueryKey);
+   }
+   for (i=0; i < (sizeof(MissKey)/sizeof(MissKey[0])); i++)
+   {
+      AddObj(MissKey[i]);
+   }
+   AddObj("config.k5");
+
+   ArrayEventCnt = CfeStub_GetEventCnt();
+   ArrayCnt = CJSON_LoadObjArray(ArrayObj, ObjCnt, Doc, DocLen);
+   ArrayEventCnt = CfeStub_GetEventCnt() - ArrayEventCnt;
+
+   SingleEventCnt = CfeStub_GetEventCnt();
+   for (i=0; i < ObjCnt; i++)
+   {
+      SingleCnt += CJSON_LoadObj(&SingleObj[i], Doc, DocLen);
+   }
+   SingleEventCnt = CfeStub_GetEventCnt() - SingleEventCnt;
+
+   for (i=0; i < ObjCnt; i++)
+   {
+      if (ArrayObj[i].Updated != SingleObj[i].Updated || ArrayValue[i] != SingleValue[i])
+      {
+         FailCnt++;
+         printf("FAIL %s loaded %d value %u, expected %d value %u\n", ArrayObj[i].Query.Key,
+                ArrayObj[i].Updated, (unsigned)ArrayValue[i], SingleObj[i].Updated, (unsigned)SingleValue[i]);
+      }
+   }
+
+   if (ArrayCnt != SingleCnt || ArrayEventCnt != SingleEventCnt)
+   {
+      FailCnt++;
+      printf("FAIL loaded %u objects with %u events, expected %u objects with %u events\n",
+             (unsigned)ArrayCnt, (unsigned)ArrayEventCnt, (unsigned)SingleCnt, (unsigned)SingleEventCnt);
+   }
+
+   printf("cjson_objarray_test: objects=%u loaded=%u failures=%u\n", (unsigned)ObjCnt, (unsigned)ArrayCnt, FailCnt);
+
+   return (FailCnt == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: AddObj
+**
+*/
+static void AddObj(const char* QueryKey)
+{
+
+   CJSON_NumObjConstructor(&ArrayObj[ObjCnt], QueryKey, JSONNumUint32, &ArrayValue[ObjCnt], sizeof(uint32));
+   CJSON_NumObjConstructor(&SingleObj[ObjCnt], QueryKey, JSONNumUint32, &SingleValue[ObjCnt], sizeof(uint32));
+   ObjCnt++;
+
+} /* End AddObj() */
+
+
+/******************************************************************************
+** Function: MakeDoc
+**
+** Notes:
+**    1. "dup" appears twice, the first occurrence must be loaded.
+**
+*/
+static size_t MakeDoc(char* Doc)
+{
+
+   size_t Len;
+   uint32 i;
+
+   Len = sprintf(Doc, "{\"dup\": 1, \"config\": {");
+   for (i=0; i < KEY_CNT; i++)
+   {
+      Len += sprintf(&Doc[Len], "%s\"k%u\": %u", (i > 0) ? ", " : "", (unsigned)i, (unsigned)(i*3));
+   }
+
+   Len += sprintf(&Doc[Len], "}, \"tbl\": {\"entry\": [");
+   for (i=0; i < ENTRY_CNT; i++)
+   {
+      Len += sprintf(&Doc[Len], "%s{\"name\": \"n%u\", \"mid\": %u}", (i > 0) ? ", " : "",
+                     (unsigned)i, (unsigned)(0x1800+i));
+   }
+
+   Len += sprintf(&Doc[Len], "]}, \"bad\": \"text\", \"dup\": 2}");
+
+   return Len;
+
+} /* End MakeDoc() */
@@ -0,0 +1,347 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Test core_json's nesting depth limits and measure the stack its
+**    traversals use as documents get deeper.
+**
+**  Notes:
+**    1. Each depth limit is checked at the limit, which must be accepted,
+**       and one level deeper, which must be reported as
+**       JSONMaxDepthExceeded.
+**    2. The traversals keep their nesting state in fixed or caller owned
+**       arrays rather than recursing so their stack use must not grow
+**       with the document's depth. Each measurement is printed so child
+**       task stack sizes can be checked against it.
+**    3. Returns 0 if every check passed.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core_json.h"
+#include "stack_probe.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define DOC_MAX_DEPTH     4096
+#define DOC_MAX_LEN       (6*DOC_MAX_DEPTH+2)
+#define STACK_GROWTH_MAX  128   /* Bytes a traversal's stack use may vary between depths */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   TRAVERSE_VALIDATE = 0,
+   TRAVERSE_VALIDATE_NESTED,
+   TRAVERSE_VALIDATE_VISIT,
+   TRAVERSE_VALIDATE_VISIT_NESTED,
+   TRAVERSE_SEARCH
+
+} Traverse_t;
+
+typedef struct
+{
+
+   Traverse_t    Traverse;
+   size_t        MaxDepth;     /* Caller owned nesting depth, 0 for fixed traversals */
+   JSONStatus_t  Status;
+   uint16_t      VisitDepth;   /* Deepest value reported to Visitor() */
+
+} Run_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void CheckLimit(const char* Name, Traverse_t Traverse, size_t MaxDepth, size_t Limit);
+static void CheckStack(const char* Name, Traverse_t Traverse, const size_t* Depth, size_t DepthCnt);
+static void MakeDoc(size_t Depth);
+static JSONStatus_t TraverseDoc(Run_t* Run);
+static void TraverseProbe(void* Context);
+static void Visitor(void* Context, const char* Buf, const JSONVisit_t* Visit);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static char     Doc[DOC_MAX_LEN];
+static size_t   DocLen;
+static uint8_t  Nesting[JSON_NESTING_LEN(DOC_MAX_DEPTH)];
+static size_t   NestingStart[DOC_MAX_DEPTH];
+static uint32_t NestingCount[DOC_MAX_DEPTH];
+static unsigned FailCnt;
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(void)
+{
+
+   /* A search only skips a nested collection in documents at least 2 levels deep */
+   static const size_t FixedDepth[]  = { 2, JSON_MAX_DEPTH/2, JSON_MAX_DEPTH };
+   static const size_t NestedDepth[] = { 8, 64, 512, DOC_MAX_DEPTH };
+
+   CheckLimit("JSON_Validate", TRAVERSE_VALIDATE, 0, JSON_MAX_DEPTH);
+   CheckLimit("JSON_ValidateVisit", TRAVERSE_VALIDATE_VISIT, 0, JSON_MAX_DEPTH);
+   CheckLimit("JSON_ValidateNested", TRAVERSE_VALIDATE_NESTED, 8, 8);
+   CheckLimit("JSON_ValidateNested", TRAVERSE_VALIDATE_NESTED, 40, 40);
+   CheckLimit("JSON_ValidateNested", TRAVERSE_VALIDATE_NESTED, DOC_MAX_DEPTH, DOC_MAX_DEPTH);
+   CheckLimit("JSON_ValidateVisitNested", TRAVERSE_VALIDATE_VISIT_NESTED, 1, 1);
+   CheckLimit("JSON_ValidateVisitNested", TRAVERSE_VALIDATE_VISIT_NESTED, 100, 100);
+   CheckLimit("JSON_ValidateVisitNested", TRAVERSE_VALIDATE_VISIT_NESTED, DOC_MAX_DEPTH-1, DOC_MAX_DEPTH-1);
+
+   CheckStack("JSON_Validate", TRAVERSE_VALIDATE, FixedDepth, 3);
+   CheckStack("JSON_ValidateVisit", TRAVERSE_VALIDATE_VISIT, FixedDepth, 3);
+   CheckStack("JSON_SearchConst", TRAVERSE_SEARCH, FixedDepth, 3);
+   CheckStack("JSON_ValidateNested", TRAVERSE_VALIDATE_NESTED, NestedDepth, 4);
+   CheckStack("JSON_ValidateVisitNested", TRAVERSE_VALIDATE_VISIT_NESTED, NestedDepth, 4);
+
+   printf("core_json_depth_test: json_max_depth=%d failures=%u\n", JSON_MAX_DEPTH, FailCnt);
+
+   return (FailCnt == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: CheckLimit
+**
+** Notes:
+**    1. Limit levels must validate and Limit+1 levels must exceed the
+**       depth. MaxDepth sizes the caller owned nesting state.
+**
+*/
+static void CheckLimit(const char* Name, Traverse_t Traverse, size_t MaxDepth, size_t Limit)
+{
+
+   Run_t Run;
+
+   Run.Traverse = Traverse;
+   Run.MaxDepth = MaxDepth;
+
+   MakeDoc(Limit);
+   if (TraverseDoc(&Run) != JSONSuccess)
+   {
+      FailCnt++;
+      printf("FAIL %s rejected %u levels with status %d, the limit is %u\n",
+             Name, (unsigned)Limit, Run.Status, (unsigned)Limit);
+   }
+   else if ((Traverse == TRAVERSE_VALIDATE_VISIT || Traverse == TRAVERSE_VALIDATE_VISIT_NESTED) &&
+            Run.VisitDepth != Limit)
+   {
+      FailCnt++;
+      printf("FAIL %s reported a deepest value at depth %u for %u levels\n",
+             Name, (unsigned)Run.VisitDepth, (unsigned)Limit);
+   }
+
+   MakeDoc(Limit + 1);
+   if (TraverseDoc(&Run) != JSONMaxDepthExceeded)
+   {
+      FailCnt++;
+      printf("FAIL %s returned status %d for %u levels, the limit is %u\n",
+             Name, Run.Status, (unsigned)(Limit + 1), (unsigned)Limit);
+   }
+
+} /* End CheckLimit() */
+
+
+/******************************************************************************
+** Function: CheckStack
+**
+** Notes:
+**    1. Measures a traversal of a document at each depth. The traversal's
+**       nesting state is sized to the document for caller owned nesting.
+**
+*/
+static void CheckStack(const char* Name, Traverse_t Traverse, const size_t* Depth, size_t DepthCnt)
+{
+
+   size_t  i;
+   size_t  Stack;
+   size_t  MinStack = SIZE_MAX;
+   size_t  MaxStack = 0;
+   Run_t   Run;
+
+   for (i=0; i < DepthCnt; i++)
+   {
+
+      Run.Traverse = Traverse;
+      Run.MaxDepth = Depth[i];
+      MakeDoc(Depth[i]);
+
+      Stack = StackProbe_Run(TraverseProbe, &Run);
+      printf("core_json_depth_test: function=%s depth=%u status=%d stack=%u\n",
+             Name, (unsigned)Depth[i], Run.Status, (unsigned)Stack);
+
+      if (Stack == 0)
+      {
+         FailCnt++;
+         printf("FAIL %s stack couldn't be measured\n", Name);
+      }
+      if (Run.Status != JSONSuccess && !(Traverse == TRAVERSE_SEARCH && Run.Status == JSONNotFound))
+      {
+         FailCnt++;
+         printf("FAIL %s returned status %d for %u levels\n", Name, Run.Status, (unsigned)Depth[i]);
+      }
+
+      if (Stack < MinStack) MinStack = Stack;
+      if (Stack > MaxStack) MaxStack = Stack;
+
+   } /* End depth loop */
+
+   if ((MaxStack - MinStack) > STACK_GROWTH_MAX)
+   {
+      FailCnt++;
+      printf("FAIL %s stack grew from %u to %u bytes with depth\n",
+             Name, (unsigned)MinStack, (unsigned)MaxStack);
+   }
+
+} /* End CheckStack() */
+
+
+/******************************************************************************
+** Function: MakeDoc
+**
+** Notes:
+**    1. Nests Depth alternating arrays and objects around a number, for
+**       example [{"k":[1]}] for a depth of 3.
+**
+*/
+static void MakeDoc(size_t Depth)
+{
+
+   size_t i;
+
+   DocLen = 0;
+
+   for (i=0; i < Depth; i++)
+   {
+      if ((i % 2) == 0)
+      {
+         Doc[DocLen++] = '[';
+      }
+      else
+      {
+         memcpy(&Doc[DocLen], "{\"k\":", 5);
+         DocLen += 5;
+      }
+   }
+
+   Doc[DocLen++] = '1';
+
+   for (i=Depth; i > 0; i--)
+   {
+      Doc[DocLen++] = ((i-1) % 2 == 0) ? ']' : '}';
+   }
+
+} /* End MakeDoc() */
+
+
+/******************************************************************************
+** Function: TraverseDoc
+**
+** Notes:
+**    1. The search looks for an array element that isn't in the document
+**       so the whole document is skipped.
+**
+*/
+static JSONStatus_t TraverseDoc(Run_t* Run)
+{
+
+   JSONNesting_t  VisitNesting;
+   const char     *Value;
+   size_t         ValueLen;
+   JSONTypes_t    ValueType;
+
+   Run->VisitDepth = 0;
+
+   switch (Run->Traverse)
+   {
+      case TRAVERSE_VALIDATE:
+         Run->Status = JSON_Validate(Doc, DocLen);
+         break;
+
+      case TRAVERSE_VALIDATE_NESTED:
+         Run->Status = JSON_ValidateNested(Doc, DocLen, Nesting, JSON_NESTING_LEN(Run->MaxDepth));
+         break;
+
+      case TRAVERSE_VALIDATE_VISIT:
+         Run->Status = JSON_ValidateVisit(Doc, DocLen, Visitor, Run);
+         break;
+
+      case TRAVERSE_VALIDATE_VISIT_NESTED:
+         VisitNesting.start    = NestingStart;
+         VisitNesting.count    = NestingCount;
+         VisitNesting.maxDepth = Run->MaxDepth;
+         Run->Status = JSON_ValidateVisitNested(Doc, DocLen, Visitor, Run, &VisitNesting);
+         break;
+
+      default:
+         Run->Status = JSON_SearchConst(Doc, DocLen, "[1]", 3, &Value, &ValueLen, &ValueType);
+         break;
+   }
+
+   return Run->Status;
+
+} /* End TraverseDoc() */
+
+
+/******************************************************************************
+** Function: TraverseProbe
+**
+*/
+static void TraverseProbe(void* Context)
+{
+
+   TraverseDoc((Run_t*)Context);
+
+} /* End TraverseProbe() */
+
+
+/******************************************************************************
+** Function: Visitor
+**
+*/
+static void Visitor(void* Context, const char* Buf, const JSONVisit_t* Visit)
+{
+
+   Run_t *Run = (Run_t*)Context;
+
+   (void)Buf;
+
+   if (Visit->depth > Run->VisitDepth)
+   {
+      Run->VisitDepth = Visit->depth;
+   }
+
+} /* End Visitor() */
@@ -0,0 +1,268 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Test JSON_NumberDecode()'s float and double conversions
+**
+**  Notes:
+**    1. The host's strtod() and strtof() in the "C" locale are the
+**       reference, glibc's are correctly rounded.
+**    2. Hard cases near halfway points, subnormals and the overflow limit
+**       are followed by random numbers of every length up to twice
+**       NUMBER_MAX_LEN digits.
+**    3. The checks are repeated in a locale with a decimal comma when the
+**       host has one, JSON_NumberDecode() must not depend on the locale.
+**    4. Returns 0 if every check passed.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <locale.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core_json.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define NUMBER_MAX_LEN  120
+#define RANDOM_CNT      200000
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void CheckAll(void);
+static void CheckNumber(const char* Number);
+static void MakeNumber(char* Number, uint32_t* Seed);
+static uint32_t NextRandom(uint32_t* Seed);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const char* HardNumber[] =
+{
+   "0.1", "-2.5e-3", "1e23", "8.98846567431158e307", "1.7976931348623157e308",
+   "1.7976931348623158e308", "1.7976931348623159e308", "2.2250738585072011e-308",
+   "2.2250738585072012e-308", "4.9406564584124654e-324", "2.4703282292062327e-324",
+   "2.4703282292062328e-324", "1e-400", "9007199254740993", "9007199254740993.0000000001",
+   "9007199254740992.9999999999", "123456789012345678901234567890",
+   "3.4028234663852886e38", "3.4028235677973366e38", "1.1754943508222875e-38",
+   "1.4012984643248171e-45", "7.006492321624085e-46", "7.006492321624086e-46",
+   "16777217", "16777216.000000001", "0.000000000000000000000000000000000001",
+   "4.35679195e-19", "2.2250738585072012e-308", "1.00000005960464477539062499",
+   "1.000000059604644775390625", "1.00000005960464477539062501", "6.103515625e-05",
+   "179769313486231580793728971405303415079934132710037826936173778980444968292764750946649017977587207096330286416692887910946555547851940402630657488671505820681908902000708383676273854845817711531764475730270069855571366959622842914819860834936475292719074168444365510704342711559699508093042880177904174497792",
+   "2.47032822920623272088284396434110686182529901307162382212792841250337753635104375932649918180817996189898282347722858865463328355177969898199387398005390939063150356595155702263922908583924491051844359318028499365361525003193704576782492193656236698636584807570015857692699037063119282795585513329278343384093519780155312465972635795746227664652728272200563740064854999770965994704540208281662262378573934507363390079677619305775067401763246736009689513405355374585166611342237666786041621596804619144672918403005300575308490487653917113865916462395249126236538818796362393732804238910186723484976682350898633885879256283027559956575244555072551893136908362547791869486679949683240497058210285131854513962138377228261454376934125320985913276672363281255e-324",
+   "1e310", "-1e310", "3.5e38"
+};
+
+static unsigned FailCnt;
+static unsigned CheckCnt;
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(void)
+{
+
+   /* Locales that write 0,5 for 0.5, the first the host has is used */
+   static const char* CommaLocale[] = { "de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8" };
+   size_t i;
+   bool   Comma = false;
+
+   CheckAll();
+
+   for (i=0; (i < (sizeof(CommaLocale)/sizeof(CommaLocale[0]))) && !Comma; i++)
+   {
+      Comma = (setlocale(LC_NUMERIC, CommaLocale[i]) != NULL);
+   }
+
+   if (Comma)
+   {
+      CheckAll();
+   }
+
+   printf("core_json_number_test: comma_locale=%d checks=%u failures=%u\n", Comma, CheckCnt, FailCnt);
+
+   return (FailCnt == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: CheckAll
+**
+*/
+static void CheckAll(void)
+{
+
+   char     Number[2*NUMBER_MAX_LEN+16];
+   uint32_t Seed = 1;
+   size_t   i;
+
+   for (i=0; i < (sizeof(HardNumber)/sizeof(HardNumber[0])); i++)
+   {
+      CheckNumber(HardNumber[i]);
+   }
+
+   for (i=0; i < RANDOM_CNT; i++)
+   {
+      MakeNumber(Number, &Seed);
+      CheckNumber(Number);
+   }
+
+} /* End CheckAll() */
+
+
+/******************************************************************************
+** Function: CheckNumber
+**
+** Notes:
+**    1. The reference is converted in the "C" locale whatever the current
+**       one is. Values the reference rounds to infinity must be reported
+**       as JSONOutOfRange.
+**
+*/
+static void CheckNumber(const char* Number)
+{
+
+   char         Locale[64];
+   double       RefDouble, Double;
+   float        RefFloat, Float;
+   JSONStatus_t DoubleStatus, FloatStatus;
+
+   strncpy(Locale, setlocale(LC_NUMERIC, NULL), sizeof(Locale)-1);
+   Locale[sizeof(Locale)-1] = '\0';
+   setlocale(LC_NUMERIC, "C");
+   RefDouble = strtod(Number, NULL);
+   RefFloat  = strtof(Number, NULL);
+   setlocale(LC_NUMERIC, Locale);
+
+   DoubleStatus = JSON_NumberDecode(Number, strlen(Number), JSONNumDouble, &Double);
+   FloatStatus  = JSON_NumberDecode(Number, strlen(Number), JSONNumFloat, &Float);
+
+   CheckCnt += 2;
+
+   if ((RefDouble > 1e308 || RefDouble < -1e308) && (RefDouble*0.5 == RefDouble))
+   {
+      if (DoubleStatus != JSONOutOfRange)
+      {
+         FailCnt++;
+         printf("FAIL double %s status %d, expected out of range\n", Number, DoubleStatus);
+      }
+   }
+   else if (DoubleStatus != JSONSuccess || memcmp(&Double, &RefDouble, sizeof(Double)) != 0)
+   {
+      FailCnt++;
+      printf("FAIL double %s status %d value %.17g, expected %.17g\n", Number, DoubleStatus, Double, RefDouble);
+   }
+
+   if ((RefFloat > 3e38F || RefFloat < -3e38F) && (RefFloat*0.5F == RefFloat))
+   {
+      if (FloatStatus != JSONOutOfRange)
+      {
+         FailCnt++;
+         printf("FAIL float %s status %d, expected out of range\n", Number, FloatStatus);
+      }
+   }
+   else if (FloatStatus != JSONSuccess || memcmp(&Float, &RefFloat, sizeof(Float)) != 0)
+   {
+      FailCnt++;
+      printf("FAIL float %s status %d value %.9g, expected %.9g\n", Number, FloatStatus, Float, RefFloat);
+   }
+
+} /* End CheckNumber() */
+
+
+/******************************************************************************
+** Function: MakeNumber
+**
+** Notes:
+**    1. Digits are mostly taken from a few values so long numbers often
+**       fall on or near halfway points, 5 followed by zeroes and a last
+**       digit of 1 being the hardest.
+**
+*/
+static void MakeNumber(char* Number, uint32_t* Seed)
+{
+
+   static const char Digit[] = "0123456789500001";
+   uint32_t IntLen   = NextRandom(Seed) % 25;
+   uint32_t FracLen  = NextRandom(Seed) % (2*NUMBER_MAX_LEN);
+   int      Exponent = (int)(NextRandom(Seed) % 700) - 350;
+   size_t   Len = 0;
+   uint32_t i;
+
+   if (NextRandom(Seed) & 1)
+   {
+      Number[Len++] = '-';
+   }
+
+   Number[Len++] = (char)('1' + NextRandom(Seed) % 9);
+   for (i=0; i < IntLen; i++)
+   {
+      Number[Len++] = Digit[NextRandom(Seed) % (sizeof(Digit)-1)];
+   }
+
+   if (FracLen > 0)
+   {
+      Number[Len++] = '.';
+      for (i=0; i < FracLen; i++)
+      {
+         Number[Len++] = Digit[NextRandom(Seed) % (sizeof(Digit)-1)];
+      }
+   }
+
+   /* Keep the decimal exponent near the formats' ranges most of the time */
+   if (NextRandom(Seed) % 4)
+   {
+      Exponent = (int)(NextRandom(Seed) % 90) - 55;
+   }
+
+   sprintf(&Number[Len], "e%d", Exponent - (int)IntLen);
+
+} /* End MakeNumber() */
+
+
+/******************************************************************************
+** Function: NextRandom
+**
+** Notes:
+**    1. xorshift32 so runs are repeatable on every host.
+**
+*/
+static uint32_t NextRandom(uint32_t* Seed)
+{
+
+   *Seed ^= *Seed << 13;
+   *Seed ^= *Seed >> 17;
+   *Seed ^= *Seed << 5;
+
+   return *Seed;
+
+} /* End NextRandom() */
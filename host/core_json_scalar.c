@@ -0,0 +1,51 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Build core_json.c with JSON_DISABLE_SIMD under different function
+**    names so the byte-at-a-time parser can be linked into the same 
+**    program as the vector parser. See core_json_simd_test.c.
+**
+**  Notes:
+**    1. Every exported core_json function must be renamed. A function 
+**       that is added to core_json.c without a rename here is reported
+**       as a duplicate symbol when core_json_simd_test is linked.
+**
+*/
+
+#define JSON_DISABLE_SIMD
+
+#define JSON_CursorInit            Scalar_JSON_CursorInit
+#define JSON_IndexBuild            Scalar_JSON_IndexBuild
+#define JSON_IndexSearch           Scalar_JSON_IndexSearch
+#define JSON_IndexSearchCompiled   Scalar_JSON_IndexSearchCompiled
+#define JSON_Iterate               Scalar_JSON_Iterate
+#define JSON_NumberDecode          Scalar_JSON_NumberDecode
+#define JSON_QueryCompile          Scalar_JSON_QueryCompile
+#define JSON_SearchCompiled        Scalar_JSON_SearchCompiled
+#define JSON_SearchConst           Scalar_JSON_SearchConst
+#define JSON_SearchCursor          Scalar_JSON_SearchCursor
+#define JSON_SearchEach            Scalar_JSON_SearchEach
+#define JSON_SearchEachCompiled    Scalar_JSON_SearchEachCompiled
+#define JSON_SearchT               Scalar_JSON_SearchT
+#define JSON_StreamFinish          Scalar_JSON_StreamFinish
+#define JSON_StreamInit            Scalar_JSON_StreamInit
+#define JSON_StreamParse           Scalar_JSON_StreamParse
+#define JSON_StringUnescape        Scalar_JSON_StringUnescape
+#define JSON_Validate              Scalar_JSON_Validate
+#define JSON_ValidateNested        Scalar_JSON_ValidateNested
+#define JSON_ValidateVisit         Scalar_JSON_ValidateVisit
+#define JSON_ValidateVisitNested   Scalar_JSON_ValidateVisitNested
+
+#include "../fsw/src/core_json.c"
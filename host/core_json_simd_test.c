@@ -0,0 +1,517 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Differential test of core_json's vector scanning. Generated documents
+**    are parsed by core_json.c and by core_json_scalar.c, the same source
+**    built with JSON_DISABLE_SIMD, and every status, value location and
+**    visit must match.
+**
+**  Notes:
+**    1. Usage: core_json_simd_test [documents] [seed]
+**    2. Whitespace runs and strings are often longer than 16 bytes and
+**       documents are mutated and truncated at random positions so the
+**       vector loops stop at every offset within a 16 byte block and at
+**       the end of the buffer.
+**    3. Returns 0 if every document matched.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core_json.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define DOC_MAX_LEN      8192
+#define DOC_FILL_LEN     6000  /* Values become numbers beyond this length */
+#define DOC_MAX_DEPTH    40    /* Exceeds JSON_MAX_DEPTH so depth errors are compared */
+#define DEF_DOC_CNT      200000
+#define ITERATE_MAX_CNT  1000
+
+#if !defined( JSON_DISABLE_SIMD ) && defined( __GNUC__ ) && defined( __SSE2__ ) && \
+    ( defined( __x86_64__ ) || defined( __i386__ ) )
+   #define VECTOR_PATH "SSE2"
+#elif !defined( JSON_DISABLE_SIMD ) && defined( __GNUC__ ) && defined( __ARM_NEON ) && defined( __aarch64__ )
+   #define VECTOR_PATH "NEON"
+#else
+   #define VECTOR_PATH "none"
+#endif
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/*
+** Everything one parser reports for a document
+*/
+
+typedef struct
+{
+
+   JSONStatus_t  Validate;
+   JSONStatus_t  Visit;
+   unsigned long VisitHash;
+   JSONStatus_t  Search[8];
+   size_t        SearchValue[8];
+   size_t        SearchLen[8];
+   JSONTypes_t   SearchType[8];
+   JSONStatus_t  Iterate;
+   unsigned long IterateHash;
+
+} Result_t;
+
+
+/************************************/
+/** Scalar core_json.c Definitions **/
+/************************************/
+
+JSONStatus_t Scalar_JSON_Validate(const char * buf, size_t max);
+JSONStatus_t Scalar_JSON_ValidateVisit(const char * buf, size_t max, JSONVisitor_t visitor, void * context);
+JSONStatus_t Scalar_JSON_SearchConst(const char * buf, size_t max, const char * query, size_t queryLength,
+                                     const char ** outValue, size_t * outValueLength, JSONTypes_t * outType);
+JSONStatus_t Scalar_JSON_Iterate(const char * buf, size_t max, size_t * start, size_t * next,
+                                 JSONPair_t * outPair);
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void AddChar(char Char);
+static void AddStr(const char* Str);
+static void AddString(void);
+static void AddValue(unsigned Depth);
+static void AddWhitespace(void);
+static void GenerateDoc(void);
+static void Parse(Result_t* Result, bool Scalar);
+static void PrintDoc(void);
+static unsigned Rand(unsigned Range);
+static void Visitor(void* Context, const char* Buf, const JSONVisit_t* Visit);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static char     Doc[DOC_MAX_LEN];
+static size_t   DocLen;
+static uint32_t RandState = 1;
+
+static const char* Query[8] =
+{
+   "k0", "k1.k0", "k2[1]", "[0]", "[2].k1", "k1.k2.k3", "\\u00e9", "k3[0][1].k0"
+};
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char* argv[])
+{
+
+   unsigned long DocCnt = DEF_DOC_CNT;
+   unsigned long i;
+   unsigned long MismatchCnt = 0;
+   unsigned long ValidCnt = 0;
+   Result_t      Vector, Scalar;
+
+   if (argc > 1) DocCnt = strtoul(argv[1], NULL, 0);
+   if (argc > 2) RandState = (uint32_t)strtoul(argv[2], NULL, 0) | 1;
+
+   for (i=0; i < DocCnt; i++)
+   {
+
+      GenerateDoc();
+
+      Parse(&Vector, false);
+      Parse(&Scalar, true);
+
+      if (Vector.Validate == JSONSuccess)
+      {
+         ValidCnt++;
+      }
+
+      if (memcmp(&Vector, &Scalar, sizeof(Result_t)) != 0)
+      {
+         MismatchCnt++;
+         if (MismatchCnt <= 10)
+         {
+            printf("Mismatch for document %lu: Validate %d/%d, Visit %d/%d, Iterate %d/%d\n", i,
+                   Vector.Validate, Scalar.Validate, Vector.Visit, Scalar.Visit,
+                   Vector.Iterate, Scalar.Iterate);
+            PrintDoc();
+         }
+      }
+
+   } /* End document loop */
+
+   printf("core_json_simd_test: vector=%s documents=%lu valid=%lu mismatches=%lu\n",
+          VECTOR_PATH, DocCnt, ValidCnt, MismatchCnt);
+
+   return (MismatchCnt == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: AddChar
+**
+*/
+static void AddChar(char Char)
+{
+
+   if (DocLen < DOC_MAX_LEN)
+   {
+      Doc[DocLen++] = Char;
+   }
+
+} /* End AddChar() */
+
+
+/******************************************************************************
+** Function: AddStr
+**
+*/
+static void AddStr(const char* Str)
+{
+
+   while (*Str != '\0')
+   {
+      AddChar(*Str++);
+   }
+
+} /* End AddStr() */
+
+
+/******************************************************************************
+** Function: AddString
+**
+** Notes:
+**    1. Mostly plain characters with escapes, multi-byte UTF-8 and the
+**       occasional invalid byte or missing closing quote.
+**
+*/
+static void AddString(void)
+{
+
+   static const char* Special[] =
+   {
+      "\\\"", "\\\\", "\\n", "\\u00e9", "\\uD83D\\uDE00", "\xC3\xA9", "\xE6\xBC\xA2",
+      "\xF0\x9F\x98\x80", "\\q", "\x01", "\x80", "\xFF", "\xC3", "\\u12", "\x7F"
+   };
+
+   unsigned Len = Rand(4) == 0 ? Rand(64) : Rand(12);
+   unsigned i;
+
+   AddChar('"');
+   for (i=0; i < Len; i++)
+   {
+      if (Rand(20) == 0)
+      {
+         /* Invalid sequences are less likely than the valid ones */
+         AddStr(Special[Rand(Rand(4) == 0 ? 15 : 8)]);
+      }
+      else
+      {
+         AddChar((char)(' ' + Rand(95)));
+         if (Doc[DocLen-1] == '"' || Doc[DocLen-1] == '\\')
+         {
+            Doc[DocLen-1] = 'x';
+         }
+      }
+   }
+   if (Rand(50) != 0)
+   {
+      AddChar('"');
+   }
+
+} /* End AddString() */
+
+
+/******************************************************************************
+** Function: AddValue
+**
+*/
+static void AddValue(unsigned Depth)
+{
+
+   static const char* Scalar[] =
+   {
+      "0", "-12", "3.25", "6.02e23", "-0.5E-3", "true", "false", "null", "01", "1.", "tru"
+   };
+   static const char* Key[] =
+   {
+      "\"k0\"", "\"k1\"", "\"k2\"", "\"k3\"", "\"\\u00e9\"", "\"k 0\""
+   };
+
+   unsigned Kind = Rand(10);
+   unsigned Cnt, i;
+
+   if (DocLen > DOC_FILL_LEN || Depth >= DOC_MAX_DEPTH)
+   {
+      Kind = 9;
+   }
+
+   AddWhitespace();
+
+   if (Kind <= 3)
+   {
+
+      AddChar(Kind == 3 ? '[' : '{');
+      Cnt = Rand(5);
+      for (i=0; i < Cnt; i++)
+      {
+         if (i > 0)
+         {
+            AddChar(',');
+         }
+         if (Kind < 3)
+         {
+            AddWhitespace();
+            AddStr(Key[Rand(6)]);
+            AddWhitespace();
+            AddChar(':');
+         }
+         AddValue(Depth + 1);
+      }
+      AddWhitespace();
+      AddChar(Kind == 3 ? ']' : '}');
+
+   }
+   else if (Kind < 7)
+   {
+      AddString();
+   }
+   else
+   {
+      AddStr(Scalar[Rand(Rand(8) == 0 ? 11 : 8)]);
+   }
+
+   AddWhitespace();
+
+} /* End AddValue() */
+
+
+/******************************************************************************
+** Function: AddWhitespace
+**
+*/
+static void AddWhitespace(void)
+{
+
+   static const char Space[] = " \t\n\r";
+   unsigned Len = Rand(3) == 0 ? Rand(40) : Rand(2);
+
+   while (Len-- > 0)
+   {
+      AddChar(Space[Rand(Rand(4) == 0 ? 4 : 1)]);
+   }
+
+} /* End AddWhitespace() */
+
+
+/******************************************************************************
+** Function: GenerateDoc
+**
+** Notes:
+**    1. A quarter of the documents have bytes replaced with characters that
+**       change the document's structure and a fifth are truncated.
+**
+*/
+static void GenerateDoc(void)
+{
+
+   static const char Mutation[] = "[]{},:\"\\ 1\n";
+   unsigned Cnt;
+
+   DocLen = 0;
+   AddValue(0);
+
+   if (Rand(4) == 0 && DocLen > 0)
+   {
+      Cnt = 1 + Rand(3);
+      while (Cnt-- > 0)
+      {
+         Doc[Rand((unsigned)DocLen)] = Mutation[Rand(sizeof(Mutation) - 1)];
+      }
+   }
+
+   if (Rand(5) == 0 && DocLen > 1)
+   {
+      DocLen = 1 + Rand((unsigned)DocLen - 1);
+   }
+
+   if (DocLen == 0)
+   {
+      AddChar('1');
+   }
+
+} /* End GenerateDoc() */
+
+
+/******************************************************************************
+** Function: Parse
+**
+** Notes:
+**    1. Value locations are recorded as offsets so the two parsers' results
+**       can be compared with memcmp().
+**
+*/
+static void Parse(Result_t* Result, bool Scalar)
+{
+
+   const char  *Value;
+   size_t      i, Start = 0, Next = 0;
+   JSONPair_t  Pair;
+
+   memset(Result, 0, sizeof(Result_t));
+
+   if (Scalar)
+   {
+      Result->Validate = Scalar_JSON_Validate(Doc, DocLen);
+      Result->Visit    = Scalar_JSON_ValidateVisit(Doc, DocLen, Visitor, &Result->VisitHash);
+   }
+   else
+   {
+      Result->Validate = JSON_Validate(Doc, DocLen);
+      Result->Visit    = JSON_ValidateVisit(Doc, DocLen, Visitor, &Result->VisitHash);
+   }
+
+   for (i=0; i < 8; i++)
+   {
+
+      Value = NULL;
+
+      if (Scalar)
+      {
+         Result->Search[i] = Scalar_JSON_SearchConst(Doc, DocLen, Query[i], strlen(Query[i]),
+                                                     &Value, &Result->SearchLen[i], &Result->SearchType[i]);
+      }
+      else
+      {
+         Result->Search[i] = JSON_SearchConst(Doc, DocLen, Query[i], strlen(Query[i]),
+                                              &Value, &Result->SearchLen[i], &Result->SearchType[i]);
+      }
+
+      if (Result->Search[i] == JSONSuccess)
+      {
+         Result->SearchValue[i] = (size_t)(Value - Doc);
+      }
+      else
+      {
+         Result->SearchLen[i]  = 0;
+         Result->SearchType[i] = JSONInvalid;
+      }
+
+   } /* End query loop */
+
+   for (i=0; i < ITERATE_MAX_CNT; i++)
+   {
+
+      if (Scalar)
+      {
+         Result->Iterate = Scalar_JSON_Iterate(Doc, DocLen, &Start, &Next, &Pair);
+      }
+      else
+      {
+         Result->Iterate = JSON_Iterate(Doc, DocLen, &Start, &Next, &Pair);
+      }
+
+      if (Result->Iterate != JSONSuccess)
+      {
+         break;
+      }
+
+      Result->IterateHash = Result->IterateHash * 31 +
+                            (Pair.key == NULL ? 0 : (unsigned long)(Pair.key - Doc) * 3 + Pair.keyLength) +
+                            (unsigned long)(Pair.value - Doc) * 7 + Pair.valueLength * 11 + Pair.jsonType;
+
+   } /* End iterate loop */
+
+} /* End Parse() */
+
+
+/******************************************************************************
+** Function: PrintDoc
+**
+*/
+static void PrintDoc(void)
+{
+
+   size_t i;
+
+   printf("   Document (%u bytes): ", (unsigned)DocLen);
+   for (i=0; i < DocLen; i++)
+   {
+      if (Doc[i] >= ' ' && Doc[i] <= '~')
+      {
+         putchar(Doc[i]);
+      }
+      else
+      {
+         printf("\\x%02X", (unsigned char)Doc[i]);
+      }
+   }
+   putchar('\n');
+
+} /* End PrintDoc() */
+
+
+/******************************************************************************
+** Function: Rand
+**
+** Notes:
+**    1. xorshift32 so every host generates the same documents for a seed.
+**
+*/
+static unsigned Rand(unsigned Range)
+{
+
+   RandState ^= RandState << 13;
+   RandState ^= RandState >> 17;
+   RandState ^= RandState << 5;
+
+   return (Range == 0) ? 0 : (RandState % Range);
+
+} /* End Rand() */
+
+
+/******************************************************************************
+** Function: Visitor
+**
+*/
+static void Visitor(void* Context, const char* Buf, const JSONVisit_t* Visit)
+{
+
+   unsigned long *Hash = (unsigned long*)Context;
+
+   (void)Buf;
+
+   *Hash = *Hash * 31 + Visit->value * 7 + Visit->valueLength * 13 + Visit->key * 17 +
+           Visit->keyLength * 19 + Visit->arrayIndex * 23 + Visit->depth * 29 + Visit->jsonType;
+
+} /* End Visitor() */
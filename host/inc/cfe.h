@@ -0,0 +1,144 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Stand-in for the cFE and OSAL declarations used by the host build
+**
+**  Notes:
+**    1. Only declares what CJSON, INITBL and the framework headers they
+**       include use. The functions are implemented by cfe_stub.c.
+**    2. Types and values match the cFE/OSAL APIs but not their internals, so
+**       nothing built with this file can be linked with a flight build.
+**
+*/
+
+#ifndef _cfe_
+#define _cfe_
+
+/*
+** Include Files
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define CFE_SUCCESS         (0)
+#define CFE_SEVERITY_ERROR  (0xC0000000)
+
+#define OS_SUCCESS      (0)
+#define OS_ERROR        (-1)
+#define OS_SEM_TIMEOUT  (-10)
+
+#define OS_PEND   (-1)
+#define OS_CHECK  (0)
+
+#define OS_READ_ONLY   (0)
+#define OS_WRITE_ONLY  (1)
+#define OS_READ_WRITE  (2)
+
+#define OS_FILE_FLAG_NONE      (0x00)
+#define OS_FILE_FLAG_CREATE    (0x01)
+#define OS_FILE_FLAG_TRUNCATE  (0x02)
+
+#define OS_MAX_API_NAME        (20)
+#define OS_MAX_NUM_OPEN_FILES  (50)
+#define OS_MAX_PATH_LEN        (64)
+
+#define OS_OBJECT_ID_UNDEFINED  ((osal_id_t)0)
+
+#define OS_FILESTAT_SIZE(x)  ((x).FileSize)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef uint8_t   uint8;
+typedef uint16_t  uint16;
+typedef uint32_t  uint32;
+typedef uint64_t  uint64;
+typedef int8_t    int8;
+typedef int16_t   int16;
+typedef int32_t   int32;
+typedef int64_t   int64;
+
+typedef int32   CFE_Status_t;
+typedef uint32  CFE_ES_TaskId_t;
+typedef uint32  osal_id_t;
+
+typedef void (*CFE_ES_ChildTaskMainFuncPtr_t)(void);
+
+typedef uint8   CFE_MSG_FcnCode_t;
+typedef size_t  CFE_MSG_Size_t;
+
+typedef struct { uint8 Byte[8]; }  CFE_MSG_Message_t;
+typedef struct { uint8 Byte[8]; }  CFE_MSG_CommandHeader_t;
+typedef struct { uint8 Byte[16]; } CFE_MSG_TelemetryHeader_t;
+
+typedef char os_err_name_t[35];
+
+typedef struct
+{
+
+   uint32  FileModeBits;
+   int32   FileTime;
+   size_t  FileSize;
+
+} os_fstat_t;
+
+enum
+{
+
+   CFE_EVS_EventType_DEBUG = 1,
+   CFE_EVS_EventType_INFORMATION,
+   CFE_EVS_EventType_ERROR,
+   CFE_EVS_EventType_CRITICAL
+
+};
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+int32 CFE_ES_GetTaskID(CFE_ES_TaskId_t *TaskId);
+int32 CFE_ES_PerfLogEntry(uint32 Marker);
+int32 CFE_ES_PerfLogExit(uint32 Marker);
+int32 CFE_ES_TaskID_ToIndex(CFE_ES_TaskId_t TaskId, uint32 *Idx);
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...);
+
+int32 CFE_PSP_MemSet(void *Dest, uint8 Value, uint32 Size);
+
+int32 OS_BinSemCreate(osal_id_t *SemId, const char *SemName, uint32 SemInitialValue, uint32 Options);
+int32 OS_BinSemFlush(osal_id_t SemId);
+int32 OS_BinSemTimedWait(osal_id_t SemId, uint32 Msecs);
+int32 OS_close(osal_id_t FileDes);
+int32 OS_GetErrorName(int32 ErrorNum, os_err_name_t *ErrName);
+int32 OS_MutSemCreate(osal_id_t *SemId, const char *SemName, uint32 Options);
+int32 OS_MutSemGive(osal_id_t SemId);
+int32 OS_MutSemTake(osal_id_t SemId);
+int32 OS_OpenCreate(osal_id_t *FileDes, const char *Path, int32 Flags, int32 Access);
+void  OS_printf(const char *Spec, ...);
+int32 OS_read(osal_id_t FileDes, void *Buffer, size_t Nbytes);
+int32 OS_stat(const char *Path, os_fstat_t *FileStats);
+int32 OS_write(osal_id_t FileDes, const void *Buffer, size_t Nbytes);
+
+
+#endif /* _cfe_ */
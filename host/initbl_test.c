@@ -0,0 +1,408 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Test loading INITBL configuration parameters from JSON ini files
+**
+**  Notes:
+**    1. Each case writes an ini file to the working directory, constructs
+**       a table from it and checks the parameters' values.
+**    2. Returns 0 if every check passed.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "initbl.h"
+#include "cfe_stub.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define INI_FILE        "initbl_test.json"
+#define INI_LAYER_FILE  "initbl_test_layer.json"
+
+#define CFG_ENUM(XX) \
+   XX(APP_NAME, char*)  \
+   XX(MASK, uint32)     \
+   XX(SIZE, uint32)     \
+   XX(RATE, float)
+
+DECLARE_ENUM(Config, CFG_ENUM)
+DEFINE_ENUM(Config, CFG_ENUM)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   const char  *Mask;      /* JSON value of MASK */
+   bool        Valid;      /* Construction is expected to succeed */
+   uint32      Value;      /* Expected MASK value when Valid */
+
+} IntCase_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void CheckInt(const IntCase_t* IntCase);
+static void CheckLayered(void);
+static void CheckLazy(bool Compact);
+static void CheckReload(void);
+static void CheckType(void);
+static void WriteIniFile(const char* Mask, const char* Size);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static INITBL_Class_t IniTbl;
+static INITBL_LazyStore_t LazyStore;
+static unsigned FailCnt = 0;
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(void)
+{
+
+   static const IntCase_t IntCase[] =
+   {
+      { "2147483648",   true,  0x80000000 },
+      { "3000000000",   true,  3000000000u },
+      { "4294967295",   true,  0xFFFFFFFF },
+      { "\"0xFFFFFFFF\"", true, 0xFFFFFFFF },
+      { "1.0",          true,  1 },
+      { "3e9",          true,  3000000000u },
+      { "4294967296",   false, 0 },
+      { "-1",           false, 0 },
+      { "1.5",          false, 0 }
+   };
+   size_t i;
+
+   CJSON_LibInit();
+
+   for (i=0; i < (sizeof(IntCase)/sizeof(IntCase[0])); i++)
+   {
+      CheckInt(&IntCase[i]);
+   }
+
+   CheckType();
+   CheckLazy(false);
+   CheckLazy(true);
+   CheckLayered();
+   CheckReload();
+
+   remove(INI_FILE);
+   remove(INI_LAYER_FILE);
+
+   printf("initbl_test: failures=%u\n", FailCnt);
+
+   return (FailCnt == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: CheckInt
+**
+** Notes:
+**    1. INILIB_TYPE_INT parameters are uint32 so the whole unsigned range
+**       must load.
+**
+*/
+static void CheckInt(const IntCase_t* IntCase)
+{
+
+   bool   Constructed;
+   uint32 Mask;
+
+   WriteIniFile(IntCase->Mask, "3000000000");
+
+   Constructed = INITBL_Constructor(&IniTbl, INI_FILE, &IniCfgEnum);
+
+   if (Constructed != IntCase->Valid)
+   {
+      FailCnt++;
+      printf("FAIL MASK %s construction returned %d\n", IntCase->Mask, Constructed);
+   }
+   else if (Constructed)
+   {
+      Mask = INITBL_GetIntConfig(&IniTbl, MASK);
+      if (Mask != IntCase->Value || INITBL_GetIntConfig(&IniTbl, SIZE) != 3000000000u)
+      {
+         FailCnt++;
+         printf("FAIL MASK %s loaded 0x%08X, expected 0x%08X\n", IntCase->Mask,
+                (unsigned)Mask, (unsigned)IntCase->Value);
+      }
+   }
+
+} /* End CheckInt() */
+
+
+/******************************************************************************
+** Function: CheckLayered
+**
+** Notes:
+**    1. The layer file only overrides MASK. CJSON borrows each file's 
+**       buffer for the layer's callback, see CJSON_GetFileBuf(), and it
+**       isn't available after the load.
+**
+*/
+static void CheckLayered(void)
+{
+
+   const char *IniFile[] = { INI_FILE, INI_LAYER_FILE };
+   FILE *File;
+
+   WriteIniFile("7", "8");
+   
+   File = fopen(INI_LAYER_FILE, "w");
+   if (File != NULL)
+   {
+      fprintf(File, "{\"config\": {\"MASK\": 5}}\n");
+      fclose(File);
+   }
+
+   if (!INITBL_LayeredConstructor(&IniTbl, IniFile, 2, &IniCfgEnum))
+   {
+      FailCnt++;
+      printf("FAIL layered table construction\n");
+   }
+   else if (INITBL_GetIntConfig(&IniTbl, MASK) != 5 || INITBL_GetIntConfig(&IniTbl, SIZE) != 8 ||
+            INITBL_GetFltConfig(&IniTbl, RATE) != 2.5F || CJSON_GetFileBuf() != NULL)
+   {
+      FailCnt++;
+      printf("FAIL layered table MASK %u SIZE %u\n", (unsigned)INITBL_GetIntConfig(&IniTbl, MASK),
+             (unsigned)INITBL_GetIntConfig(&IniTbl, SIZE));
+   }
+
+} /* End CheckLayered() */
+
+
+/******************************************************************************
+** Function: CheckLazy
+**
+** Notes:
+**    1. A lazy table only reports a value that can't be decoded when it is
+**       retrieved. Only an uncompacted table keeps its pool buffer.
+**
+*/
+static void CheckLazy(bool Compact)
+{
+
+   const INITBL_ConfigStruct *Snapshot;
+   uint32 ErrEventCnt;
+
+   WriteIniFile("1.5", "3000000000");
+
+   if (!INITBL_LazyConstructor(&IniTbl, INI_FILE, &IniCfgEnum, &LazyStore, Compact))
+   {
+      FailCnt++;
+      printf("FAIL lazy table construction, compact %d\n", Compact);
+   }
+   else
+   {
+   
+      if ((IniTbl.JsonBuf == NULL) != Compact)
+      {
+         FailCnt++;
+         printf("FAIL lazy table compact %d kept buffer %p\n", Compact, (void*)IniTbl.JsonBuf);
+      }
+      
+      ErrEventCnt = CfeStub_GetErrEventCnt();
+      if (INITBL_GetIntConfig(&IniTbl, SIZE) != 3000000000u || INITBL_GetFltConfig(&IniTbl, RATE) != 2.5F ||
+          INITBL_GetIntConfig(&IniTbl, SIZE) != 3000000000u || CfeStub_GetErrEventCnt() != ErrEventCnt)
+      {
+         FailCnt++;
+         printf("FAIL lazy table compact %d retrievals\n", Compact);
+      }
+      
+      Snapshot = INITBL_SNAPSHOT(&IniTbl, Config);
+      if (INITBL_GetIntConfig(&IniTbl, MASK) != 0 || Snapshot != NULL)
+      {
+         FailCnt++;
+         printf("FAIL lazy table compact %d undecodable MASK retrieved\n", Compact);
+      }
+   }
+
+   if (IniTbl.JsonBuf != NULL)
+   {
+      CJSON_ReleaseBuf(IniTbl.JsonBuf);
+   }
+   
+} /* End CheckLazy() */
+
+
+/******************************************************************************
+** Function: CheckReload
+**
+** Notes:
+**    1. A reload loads the unpublished bank so a snapshot retrieved before
+**       it keeps the previous values. A failed reload must leave every
+**       published parameter valid.
+**
+*/
+static void CheckReload(void)
+{
+
+   const INITBL_ConfigStruct *Snapshot = NULL;
+   uint16 i;
+   bool   Valid = true;
+
+   WriteIniFile("7", "8");
+
+   if (INITBL_Constructor(&IniTbl, INI_FILE, &IniCfgEnum))
+   {
+      Snapshot = INITBL_SNAPSHOT(&IniTbl, Config);
+   }
+   
+   if (Snapshot == NULL)
+   {
+      FailCnt++;
+      printf("FAIL reload table construction\n");
+   }
+   else
+   {
+   
+      WriteIniFile("9", "8");
+      if (!INITBL_Reload(&IniTbl, INI_FILE) || INITBL_GetIntConfig(&IniTbl, MASK) != 9 || Snapshot->MASK != 7)
+      {
+         FailCnt++;
+         printf("FAIL reload published MASK %u, snapshot MASK %u\n",
+                (unsigned)INITBL_GetIntConfig(&IniTbl, MASK), (unsigned)Snapshot->MASK);
+      }
+      
+      WriteIniFile("-1", "8");
+      if (INITBL_Reload(&IniTbl, INI_FILE))
+      {
+         FailCnt++;
+         printf("FAIL reload of an invalid MASK succeeded\n");
+      }
+      
+      for (i=0; i < IniTbl.JsonParamCnt; i++)
+      {
+         Valid &= IniTbl.Cfg->ParamValid[i];
+      }
+      
+      WriteIniFile("10", "8");
+      if (!Valid || INITBL_GetIntConfig(&IniTbl, MASK) != 9 || 
+          !INITBL_Reload(&IniTbl, INI_FILE) || INITBL_GetIntConfig(&IniTbl, MASK) != 10)
+      {
+         FailCnt++;
+         printf("FAIL reload after a failed reload, published parameters valid %d\n", Valid);
+      }
+   }
+
+} /* End CheckReload() */
+
+
+/******************************************************************************
+** Function: CheckType
+**
+** Notes:
+**    1. Retrieving a parameter as the wrong type or out of range returns 0
+**       with one error event, a valid retrieval sends no event.
+**
+*/
+static void CheckType(void)
+{
+
+   uint32 ErrEventCnt;
+
+   WriteIniFile("7", "8");
+
+   if (!INITBL_Constructor(&IniTbl, INI_FILE, &IniCfgEnum))
+   {
+      FailCnt++;
+      printf("FAIL type check table construction\n");
+   }
+   else
+   {
+   
+      ErrEventCnt = CfeStub_GetErrEventCnt();
+      if (INITBL_GetIntConfig(&IniTbl, MASK) != 7 || INITBL_GetFltConfig(&IniTbl, RATE) != 2.5F ||
+          strcmp(INITBL_GetStrConfig(&IniTbl, APP_NAME), "TEST") != 0 ||
+          CfeStub_GetErrEventCnt() != ErrEventCnt)
+      {
+         FailCnt++;
+         printf("FAIL valid retrievals\n");
+      }
+      
+      if (INITBL_GetFltConfig(&IniTbl, MASK) != 0.0F || INITBL_GetStrConfig(&IniTbl, RATE) != NULL ||
+          INITBL_GetIntConfig(&IniTbl, CFG_ENUM_START) != 0 || INITBL_GetIntConfig(&IniTbl, CFG_ENUM_END) != 0 ||
+          CfeStub_GetErrEventCnt() != (ErrEventCnt + 4))
+      {
+         FailCnt++;
+         printf("FAIL invalid retrievals\n");
+      }
+   }
+
+} /* End CheckType() */
+
+
+/******************************************************************************
+** Function: WriteIniFile
+**
+*/
+static void WriteIniFile(const char* Mask, const char* Size)
+{
+
+   FILE *File = fopen(INI_FILE, "w");
+
+   if (File != NULL)
+   {
+      fprintf(File, "{\"config\": {\"APP_NAME\": \"TEST\", \"MASK\": %s, \"SIZE\": %s, \"RATE\": 2.5}}\n",
+              Mask, Size);
+      fclose(File);
+   }
+
+} /* End WriteIniFile() */
+
+
+/******************************************************************************
+** Function: FileUtil_VerifyFileForRead
+**
+** Notes:
+**    1. Stand-in for fileutil.c, which needs OSAL's object table.
+**
+*/
+bool FileUtil_VerifyFileForRead(const char* Filename)
+{
+
+   FILE *File = fopen(Filename, "r");
+
+   if (File != NULL)
+   {
+      fclose(File);
+   }
+
+   return (File != NULL);
+
+} /* End FileUtil_VerifyFileForRead() */
@@ -0,0 +1,171 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Measure the stack used by a function on a development host
+**
+**  Notes:
+**    1. See stack_probe.h.
+**
+*/
+
+#define _POSIX_C_SOURCE 200112L
+
+/*
+** Include Files:
+*/
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stack_probe.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define STACK_PAINT  0xA5
+#define STACK_ALIGN  4096
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   StackProbe_Func_t  Func;
+   void               *Context;
+
+} Probe_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void EmptyFunc(void* Context);
+static size_t MeasureThread(StackProbe_Func_t Func, void* Context);
+static void* ProbeThread(void* Arg);
+
+
+/******************************************************************************
+** Function: StackProbe_Run
+**
+** Notes:
+**    1. The stack used by a thread running an empty function is measured
+**       once and subtracted so only Func's use is reported.
+**
+*/
+size_t StackProbe_Run(StackProbe_Func_t Func, void* Context)
+{
+
+   static bool   BaselineMeasured = false;
+   static size_t Baseline = 0;
+   size_t Used;
+
+   if (!BaselineMeasured)
+   {
+      Baseline = MeasureThread(EmptyFunc, NULL);
+      BaselineMeasured = true;
+   }
+
+   Used = MeasureThread(Func, Context);
+
+   return (Used > Baseline) ? (Used - Baseline) : 0;
+
+} /* End StackProbe_Run() */
+
+
+/******************************************************************************
+** Function: EmptyFunc
+**
+*/
+static void EmptyFunc(void* Context)
+{
+
+   (void)Context;
+
+} /* End EmptyFunc() */
+
+
+/******************************************************************************
+** Function: MeasureThread
+**
+** Notes:
+**    1. Returns the bytes of the painted stack that were overwritten, 0 if
+**       the thread couldn't be run.
+**
+*/
+static size_t MeasureThread(StackProbe_Func_t Func, void* Context)
+{
+
+   size_t          Used = 0;
+   size_t          Untouched = 0;
+   uint8_t         *Stack = NULL;
+   pthread_attr_t  Attr;
+   pthread_t       Thread;
+   Probe_t         Probe;
+
+   Probe.Func    = Func;
+   Probe.Context = Context;
+
+   if (posix_memalign((void**)&Stack, STACK_ALIGN, STACK_PROBE_LEN) == 0)
+   {
+
+      memset(Stack, STACK_PAINT, STACK_PROBE_LEN);
+
+      if (pthread_attr_init(&Attr) == 0)
+      {
+         if (pthread_attr_setstack(&Attr, Stack, STACK_PROBE_LEN) == 0 &&
+             pthread_create(&Thread, &Attr, ProbeThread, &Probe) == 0)
+         {
+
+            pthread_join(Thread, NULL);
+
+            while (Untouched < STACK_PROBE_LEN && Stack[Untouched] == STACK_PAINT)
+            {
+               Untouched++;
+            }
+            Used = STACK_PROBE_LEN - Untouched;
+         }
+         pthread_attr_destroy(&Attr);
+      }
+
+      free(Stack);
+   }
+
+   return Used;
+
+} /* End MeasureThread() */
+
+
+/******************************************************************************
+** Function: ProbeThread
+**
+*/
+static void* ProbeThread(void* Arg)
+{
+
+   Probe_t *Probe = (Probe_t*)Arg;
+
+   (Probe->Func)(Probe->Context);
+
+   return NULL;
+
+} /* End ProbeThread() */
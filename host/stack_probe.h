@@ -0,0 +1,67 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Measure the stack used by a function on a development host
+**
+**  Notes:
+**    1. The function runs in a thread whose stack is painted with a
+**       pattern before it starts. The stack used is the part of the stack
+**       that was overwritten, less the thread's own start up use, so it is
+**       the function's peak use including everything it calls.
+**    2. Assumes the stack grows down, as it does on x86 and ARM hosts.
+**
+*/
+
+#ifndef _stack_probe_
+#define _stack_probe_
+
+/*
+** Include Files
+*/
+
+#include <stddef.h>
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define STACK_PROBE_LEN  (256*1024)   /* Bytes of stack given to the function */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef void (*StackProbe_Func_t)(void* Context);
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+/******************************************************************************
+** Function: StackProbe_Run
+**
+** Notes:
+**    1. Calls Func(Context) in a thread with a painted STACK_PROBE_LEN byte
+**       stack and returns the peak number of bytes Func used.
+**    2. Returns 0 if the thread couldn't be created.
+**
+*/
+size_t StackProbe_Run(StackProbe_Func_t Func, void* Context);
+
+
+#endif /* _stack_probe_ */